@@ -0,0 +1,159 @@
+/**
+ * @file bench_loudness.cpp
+ * @brief Benchmark de vazão da análise de loudness
+ *
+ * Sem argumentos, mede o medidor EBU R128 sobre uma faixa sintética de
+ * 3 minutos (sem custo de decodificação) e compara os kernels vetorizados
+ * com a versão escalar. Com arquivos como argumento, decodifica e analisa
+ * cada um em um pool de threads, como o AudioAnalysisJob faz.
+ *
+ * Uso: bench_loudness [threads] [arquivo...]
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#include "core/services/AudioAnalysisJob.hpp"
+#include "core/util/LoudnessMeter.hpp"
+#include "core/util/SimdKernels.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double secondsSince(Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    std::vector<float> syntheticTrack(unsigned sampleRate, unsigned channels, unsigned seconds) {
+        std::mt19937 rng(42);
+        std::normal_distribution<float> noise(0.0f, 0.1f);
+        std::vector<float> samples(static_cast<size_t>(sampleRate) * channels * seconds);
+        for (size_t i = 0; i < samples.size(); ++i)
+            samples[i] = noise(rng) + 0.2f * std::sin(0.01f * static_cast<float>(i / channels));
+        return samples;
+    }
+
+    void benchKernels(const std::vector<float> &samples) {
+        const int rounds = 20;
+        std::vector<float> out(samples.size(), 0.0f);
+        volatile double sink = 0.0;
+
+        auto start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            sink = sink + core::simd::scalar::sumOfSquares(samples.data(), samples.size());
+            core::simd::scalar::multiplyAdd(0.5f, samples.data(), out.data(), samples.size());
+        }
+        double scalarTime = secondsSince(start);
+
+        start = Clock::now();
+        for (int r = 0; r < rounds; ++r) {
+            sink = sink + core::simd::sumOfSquares(samples.data(), samples.size());
+            core::simd::multiplyAdd(0.5f, samples.data(), out.data(), samples.size());
+        }
+        double simdTime = secondsSince(start);
+
+        std::cout << "Kernels (" << core::simd::instructionSet() << "): escalar "
+                  << scalarTime * 1000 / rounds << " ms, vetorizado "
+                  << simdTime * 1000 / rounds << " ms, ganho "
+                  << scalarTime / simdTime << "x" << std::endl;
+    }
+
+    void benchSynthetic(unsigned threads) {
+        const unsigned sampleRate = 44100;
+        const unsigned channels = 2;
+        const unsigned seconds = 180;
+        const unsigned tracksPerThread = 4;
+
+        auto samples = syntheticTrack(sampleRate, channels, seconds);
+        benchKernels(samples);
+
+        auto start = Clock::now();
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&]() {
+                core::LoudnessMeter meter(sampleRate, channels);
+                for (unsigned i = 0; i < tracksPerThread; ++i) {
+                    meter.reset();
+                    meter.addFrames(samples.data(), samples.size() / channels);
+                    volatile double loudness = meter.integratedLoudness();
+                    (void)loudness;
+                }
+            });
+        }
+        for (auto &t : pool)
+            t.join();
+        double elapsed = secondsSince(start);
+
+        double tracks = static_cast<double>(threads) * tracksPerThread;
+        std::cout << "Medidor (faixa sintética de " << seconds << " s, "
+                  << threads << " threads): " << tracks / elapsed / threads
+                  << " faixas/s por núcleo, " << tracks * seconds / elapsed
+                  << "x tempo real" << std::endl;
+    }
+
+    void benchFiles(unsigned threads, const std::vector<std::string> &files) {
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> failed(0);
+        std::vector<double> audioSeconds(threads, 0.0);
+
+        auto start = Clock::now();
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t]() {
+                size_t index;
+                while ((index = next.fetch_add(1)) < files.size()) {
+                    auto result = core::AudioAnalysisJob::analyzeFile(files[index]);
+                    if (result.success)
+                        audioSeconds[t] += result.duration;
+                    else
+                        ++failed;
+                }
+            });
+        }
+        for (auto &t : pool)
+            t.join();
+        double elapsed = secondsSince(start);
+
+        double total = 0.0;
+        for (double s : audioSeconds)
+            total += s;
+
+        std::cout << "Arquivos (" << files.size() << ", " << failed << " falhas, "
+                  << threads << " threads): " << files.size() / elapsed / threads
+                  << " faixas/s por núcleo, " << total / elapsed << "x tempo real"
+                  << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i == 1 && arg.find_first_not_of("0123456789") == std::string::npos)
+            threads = std::max(1, std::atoi(arg.c_str()));
+        else
+            files.push_back(arg);
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+
+    if (files.empty())
+        benchSynthetic(threads);
+    else
+        benchFiles(threads, files);
+
+    return 0;
+}
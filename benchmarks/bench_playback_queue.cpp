@@ -0,0 +1,132 @@
+/**
+ * @file bench_playback_queue.cpp
+ * @brief Micro-benchmarks da PlaybackQueue com filas grandes
+ *
+ * Mede o custo por operação (adicionar, acessar, remover, mover, buscar e
+ * navegar) nos modos sequencial e aleatório. Com as ordens mantidas em
+ * sequências indexadas, todas devem crescer em O(log n); ativar o modo
+ * aleatório não depende do tamanho da fila.
+ *
+ * Uso: bench_playback_queue [tamanho] (padrão 100000)
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-24
+ */
+
+#include "core/entities/Song.hpp"
+#include "core/interfaces/IPlayable.hpp"
+#include "core/services/PlaybackQueue.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    class SongList : public core::IPlayable {
+    private:
+        std::vector<std::shared_ptr<core::IPlayableObject>> _songs;
+
+    public:
+        explicit SongList(const std::vector<std::shared_ptr<core::Song>> &songs) {
+            for (const auto &song : songs)
+                _songs.push_back(song);
+        }
+
+        std::vector<std::shared_ptr<core::IPlayableObject>> getPlayableObjects() const override {
+            return _songs;
+        }
+    };
+
+    void report(const std::string &name, size_t operations, const std::function<void()> &body) {
+        auto start = Clock::now();
+        body();
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << std::setw(14) << elapsed * 1e9 / operations << " ns/op  "
+                  << name << std::endl;
+    }
+
+    void benchQueue(size_t size, bool aleatory) {
+        std::cout << "--- " << size << " músicas, modo "
+                  << (aleatory ? "aleatório" : "sequencial") << " ---" << std::endl;
+
+        std::vector<std::shared_ptr<core::Song>> songs;
+        for (size_t i = 0; i < size; ++i) {
+            auto song = std::make_shared<core::Song>();
+            song->setTitle("Song " + std::to_string(i));
+            songs.push_back(song);
+        }
+
+        core::PlaybackQueue queue(nullptr, nullptr, size * 2);
+        std::mt19937 rng(42);
+        volatile size_t sink = 0;
+
+        report("add (uma música por vez)", size, [&]() {
+            queue.setAleatory(aleatory);
+            for (const auto &song : songs)
+                queue.add(SongList({song}));
+        });
+
+        report("at (posição aleatória)", size, [&]() {
+            for (size_t i = 0; i < size; ++i)
+                sink = sink + queue.at(rng() % queue.size())->getTitle().size();
+        });
+
+        report("findNextIndex", size, [&]() {
+            for (size_t i = 0; i < size; ++i)
+                sink = sink + queue.findNextIndex(*songs[rng() % size]);
+        });
+
+        report("move (posições aleatórias)", size, [&]() {
+            for (size_t i = 0; i < size; ++i)
+                queue.move(rng() % queue.size(), rng() % queue.size());
+        });
+
+        report("next (fila inteira)", size, [&]() {
+            while (queue.next())
+                ;
+        });
+
+        size_t removals = size / 2;
+        report("remove (posição aleatória)", removals, [&]() {
+            for (size_t i = 0; i < removals; ++i)
+                queue.remove(rng() % queue.size());
+        });
+
+        report("setAleatory (liga e desliga)", 2, [&]() {
+            queue.setAleatory(!aleatory);
+            queue.setAleatory(aleatory);
+        });
+
+        if (!aleatory) {
+            queue.clear();
+            for (const auto &song : songs)
+                queue.add(SongList({song}));
+
+            report("setAleatory(true) + next em fila cheia", 1, [&]() {
+                queue.setAleatory(true);
+                queue.next();
+            });
+        }
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t size = 100000;
+    if (argc > 1)
+        size = std::max(1, std::atoi(argv[1]));
+
+    std::cout << std::fixed << std::setprecision(1);
+    benchQueue(size, false);
+    benchQueue(size, true);
+
+    return 0;
+}
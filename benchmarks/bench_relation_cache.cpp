@@ -0,0 +1,127 @@
+/**
+ * @file bench_relation_cache.cpp
+ * @brief Benchmark da ordenação de músicas com relações preguiçosas
+ *
+ * Ordena uma lista de músicas de três formas e conta quantas vezes os
+ * loaders de artista e álbum "consultam o banco" (a consulta é simulada
+ * por uma função que cria a entidade, como o repositório faria):
+ *
+ *  - antes: comparação carregando artista e álbum e relações sem dono, que
+ *    expiram logo depois do getter (uma consulta por acesso);
+ *  - cache de sessão: a mesma comparação, mas com o EntityCache segurando
+ *    as relações (uma consulta por artista/álbum distinto);
+ *  - depois: Song::operator< compara pelos IDs e não carrega nada.
+ *
+ * Uso: bench_relation_cache [músicas] (padrão 20000)
+ *
+ * @author Eloy Maciel
+ * @date 2025-11-30
+ */
+
+#include "core/bd/EntityCache.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using SongList = std::vector<std::shared_ptr<core::Song>>;
+    using Compare = std::function<bool(const std::shared_ptr<core::Song> &,
+                                       const std::shared_ptr<core::Song> &)>;
+
+    size_t queries = 0;
+
+    std::shared_ptr<core::Artist> queryArtist(unsigned id) {
+        ++queries;
+        auto artist = std::make_shared<core::Artist>("Artista " + std::to_string(id), "");
+        artist->setId(id);
+        return artist;
+    }
+
+    std::shared_ptr<core::Album> queryAlbum(unsigned id) {
+        ++queries;
+        auto album = std::make_shared<core::Album>();
+        album->setId(id);
+        album->setTitle("Álbum " + std::to_string(id));
+        return album;
+    }
+
+    SongList makeSongs(size_t size, bool session) {
+        auto artists = std::make_shared<core::EntityCache<core::Artist>>();
+        auto albums = std::make_shared<core::EntityCache<core::Album>>();
+        std::mt19937 rng(42);
+
+        SongList songs;
+        for (size_t i = 0; i < size; ++i) {
+            unsigned artist_id = 1 + rng() % 200;
+            unsigned album_id = artist_id * 10 + rng() % 5;
+            auto song = std::make_shared<core::Song>(i + 1, "Song " + std::to_string(rng() % size),
+                                                     artist_id, album_id);
+            song->setTrackNumber(1 + rng() % 12);
+
+            if (session) {
+                song->setArtistLoader([artists, artist_id]() { return artists->get(artist_id, queryArtist); });
+                song->setAlbumLoader([albums, album_id]() { return albums->get(album_id, queryAlbum); });
+            } else {
+                song->setArtistLoader([artist_id]() { return queryArtist(artist_id); });
+                song->setAlbumLoader([album_id]() { return queryAlbum(album_id); });
+            }
+            songs.push_back(song);
+        }
+        return songs;
+    }
+
+    // a comparação antiga, que carregava as relações a cada chamada
+    std::tuple<unsigned, unsigned, unsigned, std::string> loadingKey(const core::Song &song) {
+        auto artist = song.getArtist();
+        auto album = song.getAlbum();
+        return std::make_tuple(artist ? artist->getId() : 0u, album ? album->getId() : 0u,
+                               song.getTrackNumber(), song.getTitle());
+    }
+
+    bool loadingLess(const std::shared_ptr<core::Song> &a, const std::shared_ptr<core::Song> &b) {
+        return loadingKey(*a) < loadingKey(*b);
+    }
+
+    void report(const std::string &name, size_t size, bool session, const Compare &less) {
+        SongList songs = makeSongs(size, session);
+        queries = 0;
+
+        auto start = Clock::now();
+        std::sort(songs.begin(), songs.end(), less);
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << std::setw(12) << elapsed * 1e3 << " ms  "
+                  << std::setw(10) << queries << " consultas  " << name << std::endl;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    size_t size = 20000;
+    if (argc > 1)
+        size = std::max(1, std::atoi(argv[1]));
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "--- ordenando " << size << " músicas ---" << std::endl;
+
+    report("antes: relações sem dono", size, false, loadingLess);
+    report("cache de sessão", size, true, loadingLess);
+    report("depois: Song::operator< pelos IDs", size, true,
+           [](const std::shared_ptr<core::Song> &a, const std::shared_ptr<core::Song> &b) {
+               return *a < *b;
+           });
+
+    return 0;
+}
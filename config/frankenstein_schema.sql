@@ -12,6 +12,9 @@ CREATE TABLE IF NOT EXISTS users (
 CREATE TABLE IF NOT EXISTS artists (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     name TEXT NOT NULL UNIQUE,
+    name_key TEXT,          -- chave de ordenação (fold(name)): sem caixa e sem acentos
+    song_count INTEGER NOT NULL DEFAULT 0,     -- mantido pelos triggers de totais
+    total_duration INTEGER NOT NULL DEFAULT 0, -- segundos, idem
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     user_id INTEGER NOT NULL,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
@@ -21,8 +24,11 @@ CREATE TABLE IF NOT EXISTS artists (
 CREATE TABLE IF NOT EXISTS albums (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     title TEXT NOT NULL,
+    title_key TEXT,         -- chave de ordenação (fold(title)): sem caixa e sem acentos
     release_year INTEGER,
     genre TEXT,
+    song_count INTEGER NOT NULL DEFAULT 0,     -- mantido pelos triggers de totais
+    total_duration INTEGER NOT NULL DEFAULT 0, -- segundos, idem
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     user_id INTEGER NOT NULL,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
@@ -45,6 +51,7 @@ CREATE TABLE IF NOT EXISTS album_artists (
 CREATE TABLE IF NOT EXISTS songs (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     title TEXT NOT NULL,
+    title_key TEXT,         -- chave de ordenação (fold(title)): sem caixa e sem acentos
     duration INTEGER NOT NULL,
     track_number INTEGER,
     album_id INTEGER,
@@ -55,6 +62,11 @@ CREATE TABLE IF NOT EXISTS songs (
     bitrate INTEGER,
     sample_rate INTEGER,
     play_count INTEGER DEFAULT 0,
+    replay_gain REAL,       -- ganho ReplayGain da faixa em dB (NULL = desconhecido)
+    replay_gain_peak REAL,  -- pico amostral da faixa (1.0 = 0 dBFS)
+    integrated_loudness REAL, -- loudness EBU R128 medida pela análise (LUFS)
+    true_peak REAL,           -- true peak medido pela análise (linear)
+    analyzed_at DATETIME,     -- quando a análise de áudio rodou (NULL = pendente)
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     user_id INTEGER NOT NULL,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
@@ -79,6 +91,8 @@ CREATE TABLE IF NOT EXISTS song_artists (
 CREATE TABLE IF NOT EXISTS playlists (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     title TEXT NOT NULL,
+    song_count INTEGER NOT NULL DEFAULT 0,     -- mantido pelos triggers de totais
+    total_duration INTEGER NOT NULL DEFAULT 0, -- segundos, idem
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     user_id INTEGER NOT NULL,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
@@ -88,7 +102,7 @@ CREATE TABLE IF NOT EXISTS playlists (
 CREATE TABLE IF NOT EXISTS playlist_songs (
     playlist_id INTEGER,
     song_id INTEGER,
-    position INTEGER NOT NULL,
+    position TEXT NOT NULL,  -- chave fracionária (core/util/OrderKey.hpp)
     added_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     PRIMARY KEY (playlist_id, song_id),
@@ -108,9 +122,97 @@ CREATE TABLE IF NOT EXISTS playback_history (
     FOREIGN KEY (song_id) REFERENCES songs(id) ON DELETE CASCADE
 );
 
+-- Agregados do histórico, mantidos a cada gravação de reproduções
+-- (consultas de estatísticas não varrem playback_history)
+CREATE TABLE IF NOT EXISTS song_play_stats (
+    user_id INTEGER NOT NULL,
+    song_id INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listened_seconds INTEGER NOT NULL DEFAULT 0,
+    last_played_at INTEGER,
+    PRIMARY KEY (user_id, song_id),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    FOREIGN KEY (song_id) REFERENCES songs(id) ON DELETE CASCADE
+);
+
+CREATE TABLE IF NOT EXISTS artist_play_stats (
+    user_id INTEGER NOT NULL,
+    artist_id INTEGER NOT NULL,
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listened_seconds INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (user_id, artist_id),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
+    FOREIGN KEY (artist_id) REFERENCES artists(id) ON DELETE CASCADE
+);
+
+CREATE TABLE IF NOT EXISTS daily_play_stats (
+    user_id INTEGER NOT NULL,
+    day INTEGER NOT NULL,  -- dias desde 1970-01-01 (UTC)
+    play_count INTEGER NOT NULL DEFAULT 0,
+    listened_seconds INTEGER NOT NULL DEFAULT 0,
+    PRIMARY KEY (user_id, day),
+    FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE
+);
+
+-- Resumo da forma de onda (picos/RMS em 8 bits por bucket)
+CREATE TABLE IF NOT EXISTS song_waveforms (
+    song_id INTEGER PRIMARY KEY,
+    buckets INTEGER NOT NULL,
+    peaks BLOB,
+    rms BLOB,
+    created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
+    FOREIGN KEY (song_id) REFERENCES songs(id) ON DELETE CASCADE
+);
+
 -- Índices para performance
 CREATE INDEX IF NOT EXISTS idx_songs_artist ON songs(artist_id);
 CREATE INDEX IF NOT EXISTS idx_songs_album ON songs(album_id);
 CREATE INDEX IF NOT EXISTS idx_songs_title ON songs(title);
+-- índices das chaves de ordenação (title_key/name_key) são criados pela migração
 CREATE INDEX IF NOT EXISTS idx_playlist_songs_position ON playlist_songs(playlist_id, position);
+CREATE INDEX IF NOT EXISTS idx_playlist_songs_song ON playlist_songs(song_id);
 CREATE INDEX IF NOT EXISTS idx_playback_history_user_date ON playback_history(user_id, played_at);
+CREATE INDEX IF NOT EXISTS idx_song_play_stats_top ON song_play_stats(user_id, play_count DESC);
+CREATE INDEX IF NOT EXISTS idx_artist_play_stats_top ON artist_play_stats(user_id, play_count DESC);
+
+-- Totais das coleções (song_count/total_duration), mantidos a cada escrita:
+-- listar playlists, álbuns e artistas com duração não carrega as músicas.
+-- O artista conta as músicas em que é o principal (songs.artist_id).
+-- Ao apagar uma música, o cascade em playlist_songs já não a encontra; por
+-- isso a duração sai das playlists no BEFORE DELETE de songs.
+CREATE TRIGGER IF NOT EXISTS trg_playlist_songs_insert_totals AFTER INSERT ON playlist_songs BEGIN
+    UPDATE playlists SET song_count = song_count + 1,
+        total_duration = total_duration + COALESCE((SELECT duration FROM songs WHERE id = NEW.song_id), 0)
+    WHERE id = NEW.playlist_id;
+END;
+CREATE TRIGGER IF NOT EXISTS trg_playlist_songs_delete_totals AFTER DELETE ON playlist_songs BEGIN
+    UPDATE playlists SET song_count = song_count - 1,
+        total_duration = total_duration - COALESCE((SELECT duration FROM songs WHERE id = OLD.song_id), 0)
+    WHERE id = OLD.playlist_id;
+END;
+CREATE TRIGGER IF NOT EXISTS trg_songs_insert_totals AFTER INSERT ON songs BEGIN
+    UPDATE albums SET song_count = song_count + 1, total_duration = total_duration + NEW.duration
+    WHERE id = NEW.album_id;
+    UPDATE artists SET song_count = song_count + 1, total_duration = total_duration + NEW.duration
+    WHERE id = NEW.artist_id;
+END;
+CREATE TRIGGER IF NOT EXISTS trg_songs_delete_totals BEFORE DELETE ON songs BEGIN
+    UPDATE albums SET song_count = song_count - 1, total_duration = total_duration - OLD.duration
+    WHERE id = OLD.album_id;
+    UPDATE artists SET song_count = song_count - 1, total_duration = total_duration - OLD.duration
+    WHERE id = OLD.artist_id;
+    UPDATE playlists SET total_duration = total_duration - OLD.duration
+    WHERE id IN (SELECT playlist_id FROM playlist_songs WHERE song_id = OLD.id);
+END;
+CREATE TRIGGER IF NOT EXISTS trg_songs_update_totals AFTER UPDATE OF duration, album_id, artist_id ON songs BEGIN
+    UPDATE albums SET song_count = song_count - 1, total_duration = total_duration - OLD.duration
+    WHERE id = OLD.album_id;
+    UPDATE albums SET song_count = song_count + 1, total_duration = total_duration + NEW.duration
+    WHERE id = NEW.album_id;
+    UPDATE artists SET song_count = song_count - 1, total_duration = total_duration - OLD.duration
+    WHERE id = OLD.artist_id;
+    UPDATE artists SET song_count = song_count + 1, total_duration = total_duration + NEW.duration
+    WHERE id = NEW.artist_id;
+    UPDATE playlists SET total_duration = total_duration - OLD.duration + NEW.duration
+    WHERE id IN (SELECT playlist_id FROM playlist_songs WHERE song_id = NEW.id);
+END;
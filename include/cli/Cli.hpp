@@ -29,11 +29,18 @@
 #include "core/bd/RepositoryFactory.hpp"
 #include "core/services/Library.hpp"
 #include "core/services/UsersManager.hpp"
+#include "core/services/AudioAnalysisJob.hpp"
+#include "core/services/HistoryCompactionJob.hpp"
+#include "core/services/HistoryWriter.hpp"
+#include "core/services/PlaylistRebalanceJob.hpp"
+#include "core/services/OfflineRenderer.hpp"
+#include "core/services/QueueSnapshotStore.hpp"
 
 namespace cli
 {
 
 #define volumeStep 0.05
+#define CLI_POLL_INTERVAL_MS_DEFAULT 100
 
   class Cli
   {
@@ -47,6 +54,32 @@ namespace cli
     core::DatabaseManager _db_manager;
     std::shared_ptr<core::UsersManager> _usersManager;
     std::shared_ptr<core::FilesManager> _manager;
+    std::shared_ptr<core::AudioAnalysisJob> _analysisJob;
+    std::shared_ptr<core::HistoryWriter> _historyWriter;
+    std::shared_ptr<core::PlaylistRebalanceJob> _rebalanceJob;
+    std::shared_ptr<core::HistoryCompactionJob> _compactionJob;
+    std::shared_ptr<core::QueueSnapshotStore> _queueStore;
+    mutable std::shared_ptr<core::WaveformSummary> _waveform;
+
+    /**
+     * @brief restaura a fila salva na sessão anterior
+     */
+    void restoreQueue();
+
+    /**
+     * @brief salva a fila atual, com a posição da música que está tocando
+     */
+    void saveQueue();
+
+    /**
+     * @brief salva a fila se ela mudou, respeitando o intervalo mínimo
+     */
+    void saveQueueIfChanged();
+
+    /**
+     * @brief segundos já tocados da música atual, 0 se parado
+     */
+    uint32_t queuePosition() const;
 
     /**
      * @brief toca um IPlayable ou um IPlayableObject
@@ -138,6 +171,13 @@ namespace cli
      */
     std::string getCurrentSong() const;
 
+    /**
+     * @brief Define o crossfade entre faixas consecutivas da fila
+     *
+     * @param seconds duração do crossfade em segundos, 0 desativa
+     */
+    void setCrossfade(unsigned int seconds);
+
     /**
      * @brief Obtém o progresso atual da reprodução
      */
@@ -193,8 +233,10 @@ namespace cli
     /**
      * @brief Coloca a fila atual no modo aleatório.
      *
+     * @param mode "smart" para o embaralhamento inteligente, "normal" para o
+     * uniforme ou vazio para manter a estratégia atual
      */
-    void shuffle();
+    void shuffle(const std::string &mode = "");
 
     /**
      * @brief adicionar a musica atual a playlist de músicas curtidas
@@ -214,6 +256,19 @@ namespace cli
      */
     void showStatus() const;
 
+    /**
+     * @brief Monta a barra de progresso com a forma de onda da musica
+     *
+     * O resumo vem de song_waveforms e fica em cache enquanto a musica atual
+     * não muda.
+     *
+     * @param song_id ID da musica atual
+     * @param progress Progresso entre 0.0 e 1.0
+     * @param columns Largura da barra
+     * @return Barra pronta para exibir ou string vazia se não houver resumo
+     */
+    std::string waveformBar(unsigned song_id, float progress, size_t columns) const;
+
     /**
      * @brief Mostra as informações da fila de musicas.
      *
@@ -277,6 +332,31 @@ namespace cli
      */
     void updateSongs();
 
+    /**
+     * @brief Controla a análise de loudness da biblioteca em segundo plano.
+     *
+     * @param command "start" inicia, "stop" interrompe, "status" mostra o progresso
+     */
+    void analyze(const std::string &command);
+
+    /**
+     * @brief Renderiza a fila atual em um arquivo WAV, sem tocar o áudio.
+     *
+     * Usa o crossfade e o ReplayGain configurados no player.
+     *
+     * @param output_path caminho do arquivo WAV gerado
+     */
+    void render(const std::string &output_path);
+
+    /**
+     * @brief Mostra as músicas e artistas mais ouvidos e o tempo de escuta.
+     *
+     * Os números vêm dos agregados mantidos junto com o histórico.
+     *
+     * @param days período, em dias, do tempo de escuta
+     */
+    void showStats(unsigned days = 30) const;
+
     /**
      * @brief Mostra a ajuda com os comandos disponíveis.
      *
@@ -314,6 +394,10 @@ namespace cli
 
     /**
      * @brief Inicia o um loop que recebe comandos do usuário e os processa.
+     *
+     * As linhas são lidas por uma thread própria; enquanto não chega
+     * comando, o loop chama Player::poll() para trocar de faixa nesta
+     * mesma thread. Fim da entrada equivale a 'exit'.
      */
 
     void start();
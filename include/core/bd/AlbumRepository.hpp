@@ -17,6 +17,7 @@
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "core/bd/BatchLoader.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/EntitiesFWD.hpp" // TODO incluir usuario
@@ -30,6 +31,14 @@ namespace core {
      * Repositorio para gerenciar operacoes de CRUD para a entidade Album.
      */
     class AlbumRepository : public SQLiteRepositoryBase<Album> {
+    private:
+        using SongListLoader = BatchLoader<unsigned, std::vector<std::shared_ptr<Song>>>;
+        using ArtistListLoader = BatchLoader<unsigned, std::vector<std::shared_ptr<Artist>>>;
+
+        // compartilhados com os loaders dos álbuns, que podem viver mais que o repositório
+        std::shared_ptr<SongListLoader> _songs;
+        std::shared_ptr<ArtistListLoader> _featuring;
+
     protected:
         /**
          * @brief Insere um novo album no repositório
@@ -60,6 +69,18 @@ namespace core {
         AlbumRepository(std::shared_ptr<SQLite::Database> db);
         ~AlbumRepository() override = default;
 
+        /**
+         * @brief Mapeia as colunas de um album vindas de uma consulta com JOIN
+         *
+         * Outros repositórios trazem o album na mesma consulta com aliases
+         * prefixados (por exemplo, al.title AS "album.title").
+         *
+         * @param query Declaração SQL posicionada na linha
+         * @param prefix Prefixo dos aliases ("" para as colunas da própria tabela)
+         * @return Ponteiro compartilhado para o album mapeado
+         */
+        std::shared_ptr<Album> mapJoinedRow(SQLite::Statement &query, const std::string &prefix) const;
+
         /**
          * @brief Salva ou atualiza um album no repositório
          * @copydoc IRepository::save
@@ -78,6 +99,9 @@ namespace core {
 
         /**
          * @brief Busca albuns pelo título e usuário
+         *
+         * Ignora caixa e acentos, comparando as chaves de ordenação.
+         *
          * @param title Título do album a ser buscado
          * @param user Usuário cujos albuns serão buscados
          * @return Vetor contendo os albuns que correspondem ao título fornecido
@@ -85,6 +109,15 @@ namespace core {
         std::vector<std::shared_ptr<Album>>
         findByTitleAndUser(const std::string &title, const User &user) const;
 
+        /**
+         * @brief Busca albuns cujo título começa com um prefixo
+         * @param prefix Começo do título (sem diferenciar caixa e acentos)
+         * @param user Usuário cujos albuns serão buscados
+         * @return Albuns encontrados, na ordem da chave de ordenação
+         */
+        std::vector<std::shared_ptr<Album>>
+        findByTitlePrefix(const std::string &prefix, const User &user) const;
+
         /**
          * @brief Busca albuns pelo usuário
          * @param user Usuário cujos albuns serão buscados
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <SQLiteCpp/SQLiteCpp.h>
@@ -61,6 +62,18 @@ namespace core {
         ArtistRepository(std::shared_ptr<SQLite::Database> db);
         ~ArtistRepository() override = default;
 
+        /**
+         * @brief Mapeia as colunas de um artista vindas de uma consulta com JOIN
+         *
+         * Outros repositórios trazem o artista na mesma consulta com aliases
+         * prefixados (por exemplo, ar.name AS "artist.name").
+         *
+         * @param query Declaração SQL posicionada na linha
+         * @param prefix Prefixo dos aliases ("" para as colunas da própria tabela)
+         * @return Ponteiro compartilhado para o artista mapeado
+         */
+        std::shared_ptr<Artist> mapJoinedRow(SQLite::Statement& query, const std::string& prefix) const;
+
         /**
          * @brief Salva ou atualiza um artista no repositório
          * @copydoc IRepository::save
@@ -79,6 +92,9 @@ namespace core {
 
         /**
          * @brief Busca artistas pelo nome e usuário
+         *
+         * Ignora caixa e acentos, comparando as chaves de ordenação.
+         *
          * @param name Nome do artista a ser buscado
          * @param user Usuário cujos artistas serão buscados
          * @return Vetor contendo os artistas que correspondem ao nome fornecido
@@ -86,6 +102,15 @@ namespace core {
         std::vector<std::shared_ptr<Artist>>
         findByNameAndUser(const std::string& name, const User& user) const;
 
+        /**
+         * @brief Busca artistas cujo nome começa com um prefixo
+         * @param prefix Começo do nome (sem diferenciar caixa e acentos)
+         * @param user Usuário cujos artistas serão buscados
+         * @return Artistas encontrados, na ordem da chave de ordenação
+         */
+        std::vector<std::shared_ptr<Artist>>
+        findByNamePrefix(const std::string& prefix, const User& user) const;
+
         /**
          * @brief Busca artistas pelo nome
          * @param name Nome do artista a ser buscado
@@ -108,6 +133,31 @@ namespace core {
          * @return Vetor contendo as músicas do artista fornecido
          */
         std::vector<std::shared_ptr<Song>> getSongs(const Artist& artist) const;
+
+        /**
+         * @brief Busca os artistas participantes de várias músicas em uma consulta
+         * @param song_ids IDs das músicas
+         * @return Participantes de cada música, indexados pelo ID da música
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+        findFeaturingBySongs(const std::vector<unsigned>& song_ids) const;
+
+        /**
+         * @brief Busca os artistas participantes de vários álbuns em uma consulta
+         * @param album_ids IDs dos álbuns
+         * @return Participantes de cada álbum, indexados pelo ID do álbum
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+        findFeaturingByAlbums(const std::vector<unsigned>& album_ids) const;
+
+    private:
+        /**
+         * @brief Busca os participantes em uma tabela de relação (song_artists ou album_artists)
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+        findFeaturingBy(const std::string& relation,
+                        const std::string& owner_column,
+                        const std::vector<unsigned>& owner_ids) const;
     };
 
 }  // namespace core
@@ -0,0 +1,137 @@
+/**
+ * @file BatchLoader.hpp
+ * @brief Carregamento em lote das relações das entidades
+ *
+ * Os loaders preguiçosos das entidades (artista e álbum de uma música,
+ * músicas de um álbum ou de uma playlist) não consultam o banco sozinhos:
+ * o repositório registra a chave de cada entidade mapeada e o primeiro
+ * acesso resolve o lote pendente que contém a chave pedida, com uma única
+ * consulta WHERE ... IN (...). Percorrer mil músicas e mostrar o artista de
+ * cada uma custa uma consulta a cada BATCH_LOADER_MAX_KEYS_DEFAULT músicas,
+ * não mil; as demais chaves continuam pendentes até serem pedidas.
+ *
+ * Os resultados ficam guardados até o próximo lote passar do limite de
+ * cache, o que também faz músicas do mesmo artista receberem o mesmo
+ * objeto.
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#define BATCH_LOADER_MAX_KEYS_DEFAULT 500    /*!< @brief Chaves por consulta (abaixo do limite de parâmetros do SQLite) */
+#define BATCH_LOADER_MAX_CACHED_DEFAULT 4096 /*!< @brief Resultados guardados antes de limpar o cache */
+#define BATCH_LOADER_MAX_PENDING_DEFAULT 4096 /*!< @brief Chaves pendentes; acima disso as mais antigas são descartadas */
+
+namespace core {
+
+    /**
+     * @brief Gera a lista de parâmetros "?, ?, ..." para uma cláusula IN
+     * @param count Quantidade de parâmetros
+     */
+    inline std::string sqlPlaceholders(size_t count) {
+        std::string placeholders;
+        placeholders.reserve(count * 3);
+        for (size_t i = 0; i < count; ++i)
+            placeholders += i == 0 ? "?" : ", ?";
+        return placeholders;
+    }
+
+    /**
+     * @brief Agrupa buscas por chave em consultas em lote
+     * @tparam K Tipo da chave (normalmente o ID)
+     * @tparam V Valor carregado para cada chave
+     *
+     * Thread-safe. A consulta roda fora da trava: um load() esperando o
+     * banco não bloqueia os demais.
+     */
+    template <typename K, typename V>
+    class BatchLoader {
+    public:
+        /**
+         * @brief Busca um lote de chaves; chaves ausentes no resultado viram V{}
+         */
+        using Fetch = std::function<std::unordered_map<K, V>(const std::vector<K> &)>;
+
+    private:
+        Fetch _fetch;
+        size_t _max_keys;
+        size_t _max_cached;
+        size_t _max_pending;
+        std::deque<K> _pending;
+        std::unordered_set<K> _queued;
+        std::unordered_map<K, V> _resolved;
+        size_t _batches;
+        mutable std::mutex _mutex;
+
+        void enqueueLocked(const K &key);
+
+        /**
+         * @brief Retira das pendentes o lote de até _max_keys chaves que contém key
+         * @param key Chave pedida; entra no lote mesmo se não estava pendente
+         */
+        std::vector<K> takeBatchLocked(const K &key);
+
+    public:
+        /**
+         * @brief Construtor
+         * @param fetch Consulta de um lote
+         * @param max_keys Máximo de chaves por chamada de fetch
+         * @param max_cached Resultados guardados antes de limpar o cache
+         * @param max_pending Chaves pendentes guardadas; as mais antigas saem primeiro
+         * @throws std::invalid_argument se fetch for vazia ou max_keys for 0
+         */
+        explicit BatchLoader(Fetch fetch,
+                             size_t max_keys = BATCH_LOADER_MAX_KEYS_DEFAULT,
+                             size_t max_cached = BATCH_LOADER_MAX_CACHED_DEFAULT,
+                             size_t max_pending = BATCH_LOADER_MAX_PENDING_DEFAULT);
+
+        BatchLoader(const BatchLoader &) = delete;
+        BatchLoader &operator=(const BatchLoader &) = delete;
+
+        /**
+         * @brief Registra uma chave para o próximo lote
+         *
+         * Um resultado já guardado para a chave é descartado, então a
+         * entidade recém-mapeada vê os dados do próximo lote.
+         *
+         * @param key Chave
+         */
+        void enqueue(const K &key);
+
+        /**
+         * @brief Obtém o valor de uma chave, resolvendo o lote dela se necessário
+         * @param key Chave
+         * @return Valor carregado ou V{} se a chave não existir
+         */
+        V load(const K &key);
+
+        /**
+         * @brief Chaves aguardando o próximo lote
+         */
+        size_t pending() const;
+
+        /**
+         * @brief Quantidade de chamadas de fetch feitas até agora
+         */
+        size_t batches() const;
+
+        /**
+         * @brief Descarta as chaves pendentes e os resultados guardados
+         */
+        void clear();
+    };
+}
+
+#include "core/bd/BatchLoader.tpp"
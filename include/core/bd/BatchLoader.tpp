@@ -0,0 +1,124 @@
+/**
+ * @file BatchLoader.tpp
+ * @brief Implementação do carregamento em lote
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-29
+ */
+
+#ifndef BATCH_LOADER_TPP
+#define BATCH_LOADER_TPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace core {
+
+    template <typename K, typename V>
+    BatchLoader<K, V>::BatchLoader(Fetch fetch, size_t max_keys, size_t max_cached,
+                                   size_t max_pending)
+        : _fetch(std::move(fetch)),
+          _max_keys(max_keys),
+          _max_cached(max_cached),
+          _max_pending(max_pending),
+          _batches(0) {
+        if (!_fetch)
+            throw std::invalid_argument("Função de busca do lote não definida");
+        if (_max_keys == 0)
+            throw std::invalid_argument("Tamanho do lote deve ser maior que zero");
+    }
+
+    template <typename K, typename V>
+    void BatchLoader<K, V>::enqueueLocked(const K &key) {
+        _resolved.erase(key);
+        if (!_queued.insert(key).second)
+            return;
+        _pending.push_back(key);
+
+        // varrer a biblioteca inteira não pode acumular chaves sem limite;
+        // uma chave descartada é buscada sozinha se for pedida depois
+        while (_pending.size() > _max_pending) {
+            _queued.erase(_pending.front());
+            _pending.pop_front();
+        }
+    }
+
+    template <typename K, typename V>
+    std::vector<K> BatchLoader<K, V>::takeBatchLocked(const K &key) {
+        auto position = std::find(_pending.begin(), _pending.end(), key);
+        if (position == _pending.end())
+            return {key};
+
+        // mesmo recorte de lotes que a ordem de chegada daria
+        size_t index = static_cast<size_t>(position - _pending.begin());
+        size_t begin = index - index % _max_keys;
+        size_t end = std::min(_pending.size(), begin + _max_keys);
+
+        std::vector<K> batch(_pending.begin() + begin, _pending.begin() + end);
+        _pending.erase(_pending.begin() + begin, _pending.begin() + end);
+        for (const K &pending : batch)
+            _queued.erase(pending);
+        return batch;
+    }
+
+    template <typename K, typename V>
+    void BatchLoader<K, V>::enqueue(const K &key) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        enqueueLocked(key);
+    }
+
+    template <typename K, typename V>
+    V BatchLoader<K, V>::load(const K &key) {
+        std::vector<K> batch;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _resolved.find(key);
+            if (it != _resolved.end())
+                return it->second;
+            batch = takeBatchLocked(key);
+        }
+
+        auto found = _fetch(batch);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        ++_batches;
+        if (_resolved.size() + batch.size() > _max_cached)
+            _resolved.clear();
+
+        // ausentes também ficam guardadas, para não repetir a consulta;
+        // chaves registradas de novo durante a busca esperam o próximo lote
+        for (const K &batched : batch) {
+            if (_queued.count(batched))
+                continue;
+            auto it = found.find(batched);
+            _resolved[batched] = it != found.end() ? it->second : V{};
+        }
+
+        auto it = found.find(key);
+        return it != found.end() ? std::move(it->second) : V{};
+    }
+
+    template <typename K, typename V>
+    size_t BatchLoader<K, V>::pending() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _pending.size();
+    }
+
+    template <typename K, typename V>
+    size_t BatchLoader<K, V>::batches() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _batches;
+    }
+
+    template <typename K, typename V>
+    void BatchLoader<K, V>::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.clear();
+        _queued.clear();
+        _resolved.clear();
+    }
+}
+
+#endif // BATCH_LOADER_TPP
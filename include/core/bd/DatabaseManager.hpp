@@ -15,6 +15,8 @@
 #include <SQLiteCpp/SQLiteCpp.h>
 #include <string>
 
+#define DATABASE_BUSY_TIMEOUT_MS_DEFAULT 5000
+
 namespace core {
 
     /**
@@ -28,6 +30,75 @@ namespace core {
         std::string _db_path; /*!< @brief Caminho para o arquivo do banco de dados SQLite */
         std::string _schema_path; /*!< @brief Caminho para o arquivo de esquema do banco de dados SQLite */
 
+        /**
+         * @brief Configura uma conexão recém-aberta
+         *
+         * Chaves estrangeiras, espera por locks de outras conexões e as
+         * funções de collation.
+         *
+         * @param db Conexão
+         */
+        static void configureConnection(SQLite::Database &db);
+
+        /**
+         * @brief Aplica as migrações necessárias em bancos criados por versões anteriores
+         *
+         * O schema usa CREATE TABLE IF NOT EXISTS, então colunas novas não chegam
+         * sozinhas em bancos já existentes.
+         */
+        void migrate();
+
+        /**
+         * @brief Adiciona uma coluna a uma tabela caso ela ainda não exista
+         * @param table Nome da tabela
+         * @param column Nome da coluna
+         * @param definition Tipo e restrições da coluna
+         * @return true se a coluna foi criada agora
+         */
+        bool addColumnIfMissing(const std::string &table,
+                                const std::string &column,
+                                const std::string &definition);
+
+        /**
+         * @brief Converte para segundos Unix os played_at gravados como texto
+         *
+         * Versões antigas usavam o CURRENT_TIMESTAMP do schema; com valores
+         * mistos a comparação por played_at (e o índice) deixa de funcionar.
+         */
+        void normalizeHistoryTimestamps();
+
+        /**
+         * @brief Preenche os agregados de reprodução a partir do histórico
+         *
+         * Só age quando song_play_stats está vazia e já existe histórico, ou
+         * seja, na primeira abertura de um banco anterior aos agregados.
+         */
+        void backfillPlayStats();
+
+        /**
+         * @brief Preenche as chaves de ordenação de linhas sem chave
+         *
+         * Bancos anteriores às colunas title_key/name_key e linhas gravadas
+         * fora dos repositórios recebem a chave pela função fold().
+         */
+        void backfillCollationKeys();
+
+        /**
+         * @brief Troca as posições inteiras de playlist_songs por chaves fracionárias
+         *
+         * Versões antigas numeravam as músicas de cada playlist com inteiros;
+         * as playlists com alguma posição que não seja uma chave de OrderKey
+         * são renumeradas, mantendo a ordem numérica.
+         */
+        void convertPlaylistPositions();
+
+        /**
+         * @brief Calcula song_count e total_duration de playlists, álbuns e artistas
+         *
+         * Roda uma vez, quando as colunas acabam de ser criadas; daí em
+         * diante os triggers do schema mantêm os totais.
+         */
+        void backfillCollectionTotals();
 
     public:
         /**
@@ -47,11 +118,35 @@ namespace core {
          */
         std::shared_ptr<SQLite::Database> getDatabase();
 
+        /**
+         * @brief Abre outra conexão com o mesmo banco
+         *
+         * Transações pertencem à conexão: uma thread que grava em segundo
+         * plano precisa da sua, senão os BEGIN/COMMIT dela se misturam com
+         * os da thread principal. O banco fica em WAL, então leitores não
+         * esperam pelo escritor, e escritores concorrentes esperam até
+         * DATABASE_BUSY_TIMEOUT_MS_DEFAULT pelo lock.
+         *
+         * @return Nova conexão, já configurada; a própria conexão principal
+         * se o banco estiver em memória
+         */
+        std::shared_ptr<SQLite::Database> openConnection() const;
+
         /**
          * @brief Obtém o caminho do arquivo do banco de dados SQLite
          * @return Caminho do arquivo do banco de dados SQLite
          */
         std::string getDatabasePath() const;
+
+        /**
+         * @brief Registra a collation FOLD e a função fold() em uma conexão
+         *
+         * Ambas usam a mesma regra de collationKey(), então ORDER BY ...
+         * COLLATE FOLD ordena como as colunas de chave e como a SongSort.
+         *
+         * @param db Conexão
+         */
+        static void registerCollation(SQLite::Database &db);
     };
 
 }
@@ -0,0 +1,83 @@
+/**
+ * @file EntityCache.hpp
+ * @brief Cache de sessão para as relações das entidades
+ *
+ * Song e Album guardam artista e álbum em weak_ptr, para não formar ciclos
+ * com as coleções que guardam as músicas. Sem um dono, porém, a relação
+ * carregada expira assim que o getter retorna e cada acesso volta ao banco.
+ * O EntityCache é esse dono: o repositório mantém as entidades relacionadas
+ * vivas enquanto ele existir (a sessão), e os loaders das músicas só o
+ * referenciam de forma fraca, então nada prende o repositório.
+ *
+ * Diferente do IdentityMap, as entradas são fortes e só saem com erase ou
+ * clear.
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-30
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace core {
+
+    /**
+     * @brief Guarda entidades por ID durante a sessão
+     * @tparam T Tipo da entidade (deve ter getId())
+     *
+     * Thread-safe: o Player lê o artista da música atual fora da thread
+     * principal.
+     */
+    template <typename T>
+    class EntityCache {
+    private:
+        mutable std::mutex _mutex;
+        std::unordered_map<unsigned, std::shared_ptr<T>> _entries;
+
+    public:
+        /**
+         * @brief Busca uma entidade guardada
+         * @param id ID da entidade
+         * @return Entidade ou nullptr se não estiver no cache
+         */
+        std::shared_ptr<T> find(unsigned id) const;
+
+        /**
+         * @brief Verifica se a entidade já está guardada
+         * @param id ID da entidade
+         */
+        bool contains(unsigned id) const;
+
+        /**
+         * @brief Busca uma entidade, carregando-a se necessário
+         * @param id ID da entidade
+         * @param load Função que carrega a entidade; chamada só em caso de falta
+         * @return Entidade ou nullptr se load não encontrou (ausentes não são guardadas)
+         */
+        template <typename Loader>
+        std::shared_ptr<T> get(unsigned id, Loader load);
+
+        /**
+         * @brief Esquece uma entidade (por exemplo, depois de alterá-la no banco)
+         * @param id ID da entidade
+         */
+        void erase(unsigned id);
+
+        /**
+         * @brief Esquece todas as entidades
+         */
+        void clear();
+
+        /**
+         * @brief Número de entidades guardadas
+         */
+        size_t size() const;
+    };
+}
+
+#include "core/bd/EntityCache.tpp"
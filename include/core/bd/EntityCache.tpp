@@ -0,0 +1,64 @@
+/**
+ * @file EntityCache.tpp
+ * @brief Implementação do cache de sessão
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-30
+ */
+
+#ifndef ENTITY_CACHE_TPP
+#define ENTITY_CACHE_TPP
+
+namespace core {
+
+    template <typename T>
+    std::shared_ptr<T> EntityCache<T>::find(unsigned id) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(id);
+        return it != _entries.end() ? it->second : nullptr;
+    }
+
+    template <typename T>
+    bool EntityCache<T>::contains(unsigned id) const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.count(id) > 0;
+    }
+
+    template <typename T>
+    template <typename Loader>
+    std::shared_ptr<T> EntityCache<T>::get(unsigned id, Loader load) {
+        if (auto entity = find(id))
+            return entity;
+
+        // carrega fora da trava: o loader pode consultar o banco
+        std::shared_ptr<T> entity = load(id);
+        if (!entity)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        // se outra thread chegou antes, todos ficam com o mesmo objeto
+        return _entries.emplace(id, entity).first->second;
+    }
+
+    template <typename T>
+    void EntityCache<T>::erase(unsigned id) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.erase(id);
+    }
+
+    template <typename T>
+    void EntityCache<T>::clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _entries.clear();
+    }
+
+    template <typename T>
+    size_t EntityCache<T>::size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+}
+
+#endif // ENTITY_CACHE_TPP
@@ -11,24 +11,111 @@
 
 #pragma once
 
+#include <ctime>
+#include <limits>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "core/bd/IdentityMap.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/entities/HistoryPlayback.hpp"
+#include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
 
 namespace core {
 
+    /**
+     * @brief Reproduções de uma música por um usuário
+     */
+    struct SongPlayStats {
+        unsigned plays = 0;              /*!< @brief Número de reproduções */
+        std::time_t last_played_at = 0;  /*!< @brief Reprodução mais recente */
+    };
+
+    /**
+     * @brief Evento de reprodução, só com os IDs
+     *
+     * Forma compacta de um HistoryPlayback, usada para registrar reproduções
+     * sem carregar usuário e música.
+     */
+    struct PlaybackEvent {
+        unsigned user_id = 0;
+        unsigned song_id = 0;
+        std::time_t played_at = 0;
+        unsigned duration = 0;  /*!< @brief Segundos ouvidos */
+    };
+
+    /**
+     * @brief Posição em um ranking de músicas ou artistas mais ouvidos
+     */
+    struct PlayRanking {
+        unsigned id = 0;
+        std::string name;               /*!< @brief Título da música ou nome do artista */
+        unsigned plays = 0;
+        long long listened_seconds = 0;
+    };
+
+    /**
+     * @brief Reprodução recente, já com os dados de exibição
+     *
+     * Projeção de uma linha do histórico com a música e o artista, obtida
+     * em uma única consulta, sem montar entidades.
+     */
+    struct RecentPlay {
+        unsigned history_id = 0;   /*!< @brief ID da linha, usado como cursor de página */
+        std::time_t played_at = 0;
+        unsigned song_id = 0;
+        std::string title;
+        unsigned artist_id = 0;    /*!< @brief 0 se a música não tem artista */
+        std::string artist;
+    };
+
+    /**
+     * @brief Tempo de escuta de um dia
+     */
+    struct DailyListening {
+        std::time_t day = 0;            /*!< @brief Início do dia (UTC) */
+        unsigned plays = 0;
+        long long listened_seconds = 0;
+    };
+
     /**
      * @brief Repositorio de historico de reproducoes
      * Repositorio para gerenciar operacoes de CRUD para a entidade
      * HistoryPlayback.
+     *
+     * Junto com cada lote de eventos são atualizados os agregados por
+     * música, por artista e por dia (song_play_stats, artist_play_stats e
+     * daily_play_stats) e songs.play_count, então contagens e rankings não
+     * dependem do tamanho do histórico.
+     *
+     * Usuários e músicas das entidades HistoryPlayback vêm de mapas de
+     * identidade: cada um é carregado uma vez e compartilhado entre as
+     * reproduções.
      */
     class HistoryPlaybackRepository
         : public SQLiteRepositoryBase<HistoryPlayback> {
+    private:
+        mutable IdentityMap<User> _users;
+        mutable IdentityMap<Song> _songs;
+
+        std::shared_ptr<User> loadUser(unsigned id) const;
+        std::shared_ptr<Song> loadSong(unsigned id) const;
+
+        /**
+         * @brief Soma (ou subtrai) eventos nos agregados de reprodução
+         *
+         * Deve rodar dentro da transação de quem altera o histórico.
+         *
+         * @param events Eventos a serem contabilizados
+         * @param sign 1 para somar, -1 para desfazer
+         */
+        void applyAggregates(const std::vector<PlaybackEvent>& events, int sign);
+
     protected:
         /**
          * @brief Insere um novo historico de reproducao no repositório
@@ -40,6 +127,9 @@ namespace core {
 
         /**
          * @brief Atualiza um historico de reproducao existente no repositório
+         *
+         * Os agregados trocam o evento antigo pelo novo na mesma transação.
+         *
          * @copydoc IRepository::update
          * @param entity Historico de reproducao a ser atualizado
          * @return true se a operação foi bem-sucedida, false caso contrário
@@ -69,12 +159,39 @@ namespace core {
 
         /**
          * @brief Busca historicos de reproducoes pelo usuário
+         *
+         * Cada música é carregada uma única vez, mesmo que apareça em várias
+         * reproduções. Para listar o histórico prefira findRecentlyPlayed(),
+         * que não monta entidades.
+         *
          * @param user Usuário cujos historicos de reproducoes serão buscados
+         * @param limit Número máximo de entradas, das mais recentes (0 = todas)
          * @return Vetor contendo os historicos de reproducoes do usuário
          * fornecido
          */
         std::vector<std::shared_ptr<HistoryPlayback>>
-        findByUser(const User& user) const;
+        findByUser(const User& user, size_t limit = 0) const;
+
+        /**
+         * @brief Página do histórico recente, do mais novo para o mais antigo
+         *
+         * Uma consulta só (histórico + músicas + artistas) percorrendo o índice
+         * (user_id, played_at). As páginas seguintes são pedidas com o
+         * played_at e o history_id da última entrada recebida, o que mantém o
+         * custo proporcional ao tamanho da página.
+         *
+         * @param user Usuário
+         * @param limit Tamanho máximo da página
+         * @param from Ignora reproduções anteriores a este instante
+         * @param before Cursor: só reproduções antes deste instante...
+         * @param before_id ...ou no mesmo instante com ID menor (0 ignora)
+         * @return Reproduções em ordem decrescente de played_at
+         */
+        std::vector<RecentPlay> findRecentlyPlayed(const User& user,
+                                                   size_t limit,
+                                                   std::time_t from = 0,
+                                                   std::time_t before = std::numeric_limits<std::time_t>::max(),
+                                                   unsigned before_id = 0) const;
 
         /**
          * @brief Insere um historico de reproducao no repositório
@@ -92,6 +209,16 @@ namespace core {
         bool
         insertMultipleHistoryPlaybacks(std::vector<HistoryPlayback>& entities);
 
+        /**
+         * @brief Insere vários eventos de reprodução em uma única transação
+         *
+         * Atualiza também os agregados de reprodução.
+         *
+         * @param events Eventos a serem inseridos
+         * @return true se a operação foi bem-sucedida, false caso contrário
+         */
+        bool insertPlaybackEvents(const std::vector<PlaybackEvent>& events);
+
         /**
          * @brief Conta o número de reproduções de uma música
          * @param user Usuário cujas reproduções serão contadas
@@ -105,6 +232,61 @@ namespace core {
          * @return Número de reproduções da música pelo usuário
          */
         unsigned countPlaybacksBySongAndUser(const Song& song, const User& user) const;
+
+        /**
+         * @brief Conta as reproduções de todas as músicas de um usuário
+         *
+         * Uma única consulta agregada (GROUP BY), no lugar de chamar
+         * countPlaybacksBySongAndUser para cada música.
+         *
+         * @param user Usuário cujas reproduções serão contadas
+         * @param since Considera apenas reproduções a partir deste instante
+         * @return Estatísticas por ID de música; músicas nunca tocadas no
+         * período não aparecem
+         */
+        std::unordered_map<unsigned, SongPlayStats>
+        findPlayStatsByUser(const User& user, std::time_t since = 0) const;
+
+        /**
+         * @brief Músicas mais ouvidas pelo usuário
+         * @param user Usuário
+         * @param limit Tamanho máximo do ranking
+         * @return Ranking em ordem decrescente de reproduções
+         */
+        std::vector<PlayRanking> findTopSongs(const User& user, size_t limit) const;
+
+        /**
+         * @brief Artistas mais ouvidos pelo usuário
+         * @param user Usuário
+         * @param limit Tamanho máximo do ranking
+         * @return Ranking em ordem decrescente de reproduções
+         */
+        std::vector<PlayRanking> findTopArtists(const User& user, size_t limit) const;
+
+        /**
+         * @brief Reproduções e tempo de escuta por dia
+         * @param user Usuário
+         * @param from Início do período
+         * @param to Fim do período
+         * @return Dias com reproduções no período, em ordem cronológica
+         */
+        std::vector<DailyListening> findDailyListening(const User& user,
+                                                       std::time_t from,
+                                                       std::time_t to) const;
+
+        /**
+         * @brief Remove do histórico as reproduções anteriores a um instante
+         *
+         * Os agregados já contam essas reproduções, então só as linhas de
+         * playback_history são apagadas. A remoção é feita por usuário, pelo
+         * índice (user_id, played_at), em lotes de uma transação cada, para
+         * não segurar o banco enquanto o HistoryWriter grava.
+         *
+         * @param before Reproduções com played_at anterior são removidas
+         * @param batch_size Linhas removidas por transação
+         * @return Número de linhas removidas
+         */
+        size_t deleteHistoryBefore(std::time_t before, size_t batch_size = 5000);
     };
 
 }  // namespace core
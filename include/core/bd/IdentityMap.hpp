@@ -0,0 +1,84 @@
+/**
+ * @file IdentityMap.hpp
+ * @brief Mapa de identidade para entidades carregadas do banco
+ *
+ * Garante que cada linha seja representada por um único objeto enquanto ele
+ * estiver em uso: quem pede a mesma entidade duas vezes recebe o mesmo
+ * ponteiro, sem repetir a consulta. As entradas são fracas, então o mapa
+ * não prolonga a vida das entidades; entradas expiradas são descartadas
+ * conforme o mapa cresce.
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+namespace core {
+
+    /**
+     * @brief Cache de entidades por ID, com referências fracas
+     * @tparam T Tipo da entidade (deve ter getId())
+     *
+     * Não é thread-safe; cada repositório mantém o seu.
+     */
+    template <typename T>
+    class IdentityMap {
+    private:
+        std::unordered_map<unsigned, std::weak_ptr<T>> _entries;
+        size_t _prune_at;
+
+        /**
+         * @brief Remove as entradas cujas entidades já foram destruídas
+         */
+        void prune();
+
+    public:
+        IdentityMap();
+
+        /**
+         * @brief Busca uma entidade já carregada
+         * @param id ID da entidade
+         * @return Entidade ou nullptr se não estiver no mapa
+         */
+        std::shared_ptr<T> find(unsigned id) const;
+
+        /**
+         * @brief Registra uma entidade carregada
+         * @param entity Entidade (ignorada se nula ou sem ID)
+         */
+        void insert(const std::shared_ptr<T> &entity);
+
+        /**
+         * @brief Busca uma entidade, carregando-a se necessário
+         * @param id ID da entidade
+         * @param load Função que carrega a entidade; chamada só em caso de falta
+         * @return Entidade ou nullptr se load não encontrou
+         */
+        template <typename Loader>
+        std::shared_ptr<T> get(unsigned id, Loader load);
+
+        /**
+         * @brief Esquece uma entidade
+         * @param id ID da entidade
+         */
+        void erase(unsigned id);
+
+        /**
+         * @brief Esquece todas as entidades
+         */
+        void clear();
+
+        /**
+         * @brief Número de entradas, incluindo as já expiradas
+         */
+        size_t size() const;
+    };
+}
+
+#include "core/bd/IdentityMap.tpp"
@@ -0,0 +1,81 @@
+/**
+ * @file IdentityMap.tpp
+ * @brief Implementação do mapa de identidade
+ *
+ * @ingroup bd
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#ifndef IDENTITY_MAP_TPP
+#define IDENTITY_MAP_TPP
+
+#include <algorithm>
+
+namespace core {
+
+    template <typename T>
+    IdentityMap<T>::IdentityMap() : _prune_at(64) {}
+
+    template <typename T>
+    void IdentityMap<T>::prune() {
+        for (auto it = _entries.begin(); it != _entries.end();) {
+            if (it->second.expired())
+                it = _entries.erase(it);
+            else
+                ++it;
+        }
+
+        // amortizado: só varre de novo quando o número de vivas dobrar
+        _prune_at = std::max<size_t>(64, _entries.size() * 2);
+    }
+
+    template <typename T>
+    std::shared_ptr<T> IdentityMap<T>::find(unsigned id) const {
+        auto it = _entries.find(id);
+        if (it == _entries.end())
+            return nullptr;
+
+        return it->second.lock();
+    }
+
+    template <typename T>
+    void IdentityMap<T>::insert(const std::shared_ptr<T> &entity) {
+        if (!entity || entity->getId() == 0)
+            return;
+
+        if (_entries.size() >= _prune_at)
+            prune();
+
+        _entries[entity->getId()] = entity;
+    }
+
+    template <typename T>
+    template <typename Loader>
+    std::shared_ptr<T> IdentityMap<T>::get(unsigned id, Loader load) {
+        if (auto entity = find(id))
+            return entity;
+
+        std::shared_ptr<T> entity = load(id);
+        insert(entity);
+        return entity;
+    }
+
+    template <typename T>
+    void IdentityMap<T>::erase(unsigned id) {
+        _entries.erase(id);
+    }
+
+    template <typename T>
+    void IdentityMap<T>::clear() {
+        _entries.clear();
+        _prune_at = 64;
+    }
+
+    template <typename T>
+    size_t IdentityMap<T>::size() const {
+        return _entries.size();
+    }
+}
+
+#endif
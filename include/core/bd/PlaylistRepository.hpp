@@ -19,18 +19,32 @@
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "core/bd/BatchLoader.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/entities/Playlist.hpp"
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
 
+#define PLAYLIST_ORDER_KEY_MAX_LENGTH_DEFAULT 12 /*!< @brief Chaves mais longas pedem redistribuição */
+
 namespace core {
 
     /**
      * @brief Repositorio de playlists
      * Repositorio para gerenciar operacoes de CRUD para a entidade Playlist.
+     *
+     * As posições em playlist_songs são chaves fracionárias (OrderKey):
+     * inserir ou mover uma música grava só a linha dela, com uma chave entre
+     * as vizinhas. As chaves crescem com o uso; rebalance() as redistribui
+     * fora do caminho da edição (ver PlaylistRebalanceJob).
      */
     class PlaylistRepository : public SQLiteRepositoryBase<Playlist> {
+    private:
+        using SongListLoader = BatchLoader<unsigned, std::vector<std::shared_ptr<Song>>>;
+
+        // compartilhado com os loaders das playlists, que podem viver mais que o repositório
+        std::shared_ptr<SongListLoader> _songs;
+
     protected:
         /**
          * @brief Insere uma nova playlist no repositório
@@ -48,14 +62,15 @@ namespace core {
          */
         bool update(const Playlist& entity) override;
 
-
         /**
-         * @brief Adiciona uma música a uma playlist
-         * @param playlist Playlist onde a música será adicionada
-         * @param song Música a ser adicionada
-         * @return true se a operação foi bem-sucedida, false caso contrário
+         * @brief Grava só as músicas alteradas da playlist
+         *
+         * Apaga as removidas e dá às inseridas e movidas uma chave entre as
+         * vizinhas que não mudaram. Deve rodar dentro de uma transação.
+         *
+         * @param playlist Playlist com as alterações registradas
          */
-        bool addSongToPlaylist(const Playlist& playlist, size_t pos, const Song& song);
+        void applyChanges(const Playlist& playlist);
 
         /**
          * @brief Mapeia uma linha do resultado para uma playlist
@@ -69,6 +84,14 @@ namespace core {
         PlaylistRepository(std::shared_ptr<SQLite::Database> db);
         ~PlaylistRepository() override = default;
 
+        /**
+         * @brief Salva a playlist e descarta as alterações registradas nela
+         * @copydoc IRepository::save
+         * @param entity Playlist a ser salva
+         * @return true se a operação foi bem-sucedida, false caso contrário
+         */
+        bool save(Playlist& entity) override;
+
         /**
          * @brief Busca playlists pelo título e usuário
          * @param title Título da playlist a ser buscada
@@ -86,9 +109,31 @@ namespace core {
 
         /**
          * @brief Obtém as músicas de uma playlist
+         *
+         * Uma única consulta, na ordem da playlist, com artista e álbum de
+         * cada música já carregados.
+         *
          * @param playlist Playlist cujas músicas serão obtidas
          * @return Vetor contendo as músicas da playlist
          */
         std::vector<std::shared_ptr<Song>> getSongs(const Playlist& playlist) const;
+
+        /**
+         * @brief Busca playlists com chaves de posição longas demais
+         * @param max_length Comprimento máximo aceito para uma chave
+         * @return Ids das playlists que precisam de rebalance()
+         */
+        std::vector<unsigned> findUnbalanced(size_t max_length = PLAYLIST_ORDER_KEY_MAX_LENGTH_DEFAULT) const;
+
+        /**
+         * @brief Redistribui as chaves de posição de uma playlist
+         *
+         * Mantém a ordem e deixa as chaves tão curtas quanto possível.
+         * Regrava todas as linhas da playlist em uma transação.
+         *
+         * @param playlist_id Id da playlist
+         * @return Número de músicas regravadas
+         */
+        size_t rebalance(unsigned playlist_id);
     };
 }
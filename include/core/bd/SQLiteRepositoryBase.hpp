@@ -12,8 +12,11 @@
 #pragma once
 
 #include "core/interfaces/IRepository.hpp"
+#include "core/util/Datetime.hpp"
 #include <SQLiteCpp/SQLiteCpp.h>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace core {
 
@@ -55,6 +58,15 @@ namespace core {
          */
         const std::string& getTableName() const;
 
+        /**
+         * @brief Lê a data de criação de uma linha
+         * @param query Declaração SQL com o resultado da consulta
+         * @param column Nome da coluna (created_at por padrão)
+         * @return Data lida, não definida se a coluna for nula
+         */
+        Datetime readCreatedAt(SQLite::Statement& query,
+                               const std::string& column = "created_at") const;
+
         /**
          * @brief Mapeia uma linha do resultado para uma entidade
          * @param query Declaração SQL com o resultado da consulta
@@ -93,6 +105,14 @@ namespace core {
          */
         std::shared_ptr<T> findById(unsigned id) const override;
 
+        /**
+         * @brief Busca várias entidades pelo ID com consultas IN (...) em lote
+         * @param ids IDs a serem buscados
+         * @return Entidades encontradas, indexadas pelo ID da linha
+         */
+        std::unordered_map<unsigned, std::shared_ptr<T>>
+        findByIds(const std::vector<unsigned>& ids) const;
+
 
         /**
          * @brief Obtém o ID da última inserção
@@ -12,9 +12,12 @@
 
 // #include "core/bd/SQLiteRepositoryBase.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 
+#include "core/bd/BatchLoader.hpp"
+
 namespace core {
     template <typename T>
     SQLiteRepositoryBase<T>::SQLiteRepositoryBase(
@@ -44,6 +47,15 @@ namespace core {
         return results;
     }
 
+    template <typename T>
+    Datetime SQLiteRepositoryBase<T>::readCreatedAt(SQLite::Statement& query,
+                                                    const std::string& column) const {
+        SQLite::Column value = query.getColumn(column.c_str());
+        if (value.isNull())
+            return Datetime();
+        return Datetime(value.getString());
+    }
+
     template <typename T>
     const std::string& SQLiteRepositoryBase<T>::getTableName() const {
         return _table_name;
@@ -61,6 +73,28 @@ namespace core {
         return nullptr;
     }
 
+    template <typename T>
+    std::unordered_map<unsigned, std::shared_ptr<T>>
+    SQLiteRepositoryBase<T>::findByIds(const std::vector<unsigned>& ids) const {
+        std::unordered_map<unsigned, std::shared_ptr<T>> results;
+
+        for (size_t begin = 0; begin < ids.size(); begin += BATCH_LOADER_MAX_KEYS_DEFAULT) {
+            size_t count = std::min<size_t>(BATCH_LOADER_MAX_KEYS_DEFAULT, ids.size() - begin);
+            std::string sql = "SELECT * FROM " + _table_name + " WHERE id IN ("
+                              + sqlPlaceholders(count) + ")";
+            SQLite::Statement query = prepare(sql);
+            for (size_t i = 0; i < count; ++i)
+                query.bind(static_cast<int>(i + 1), static_cast<int>(ids[begin + i]));
+
+            while (query.executeStep()) {
+                unsigned id = static_cast<unsigned>(query.getColumn("id").getInt());
+                results[id] = this->mapRowToEntity(query);
+            }
+        }
+
+        return results;
+    }
+
     template <typename T>
     std::vector<std::shared_ptr<T>> SQLiteRepositoryBase<T>::getAll() const {
         std::vector<std::shared_ptr<T>> results;
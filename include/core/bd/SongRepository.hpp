@@ -13,24 +13,69 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include "core/bd/BatchLoader.hpp"
+#include "core/bd/EntityCache.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/Artist.hpp"
 #include "core/entities/EntitiesFWD.hpp"
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
+#include "core/util/Waveform.hpp"
 
 namespace core {
 
+    /**
+     * @brief Resultado da análise de loudness de uma música
+     */
+    struct LoudnessAnalysis {
+        unsigned song_id = 0;
+        bool success = false;           /*!< @brief false se o arquivo não pôde ser decodificado */
+        double integrated_loudness = 0; /*!< @brief Loudness integrada em LUFS */
+        float true_peak = 0;            /*!< @brief True peak linear */
+        double duration = 0;            /*!< @brief Duração decodificada em segundos */
+    };
+
     /**
      * @brief Repositorio de musicas
      * Repositorio para gerenciar operacoes de CRUD para a entidade Song.
      */
     class SongRepository : public SQLiteRepositoryBase<Song> {
+    private:
+        using ArtistLoader = BatchLoader<unsigned, std::shared_ptr<Artist>>;
+        using AlbumLoader = BatchLoader<unsigned, std::shared_ptr<Album>>;
+        using ArtistListLoader = BatchLoader<unsigned, std::vector<std::shared_ptr<Artist>>>;
+
+        // compartilhados com os loaders das músicas, que podem viver mais que o repositório
+        std::shared_ptr<ArtistLoader> _artists;
+        std::shared_ptr<AlbumLoader> _albums;
+        std::shared_ptr<ArtistListLoader> _featuring;
+
+        // donos das relações durante a sessão; os loaders só guardam weak_ptr
+        std::shared_ptr<EntityCache<Artist>> _artistCache;
+        std::shared_ptr<EntityCache<Album>> _albumCache;
+
+        /**
+         * @brief Mapeia todas as linhas de uma consulta, agrupando pela coluna owner_id
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+        mapRowsByOwner(SQLite::Statement &query) const;
+
+        /**
+         * @brief Como mapRowsByOwner, mas com artista e álbum na mesma linha
+         *
+         * As colunas do artista e do álbum vêm com os prefixos "artist." e
+         * "album."; as músicas já saem com as relações resolvidas.
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+        mapHydratedRowsByOwner(SQLite::Statement &query) const;
+
     protected:
         /**
          * @brief Insere uma nova musica no repositório
@@ -57,6 +102,22 @@ namespace core {
         virtual std::shared_ptr<Song>
         mapRowToEntity(SQLite::Statement &query) const override;
 
+        /**
+         * @brief Mapeia uma linha para uma musica de um usuário já conhecido
+         * @param query Declaração SQL com o resultado da consulta
+         * @param user Dono da musica (evita buscar o usuário a cada linha)
+         * @return Ponteiro compartilhado para a musica mapeada
+         */
+        std::shared_ptr<Song> mapRowToEntity(SQLite::Statement &query, const User &user) const;
+
+        /**
+         * @brief Faz o bind das colunas replay_gain e replay_gain_peak
+         * @param query Declaração SQL preparada
+         * @param index Índice do parâmetro de replay_gain (o pico usa index + 1)
+         * @param entity Musica com os valores a serem gravados
+         */
+        static void bindReplayGain(SQLite::Statement &query, int index, const Song &entity);
+
     public:
         SongRepository();
         SongRepository(std::shared_ptr<SQLite::Database> db);
@@ -80,6 +141,9 @@ namespace core {
 
         /**
          * @brief Busca musicas pelo título e usuário
+         *
+         * Ignora caixa e acentos, comparando as chaves de ordenação.
+         *
          * @param title Título da musica a ser buscada
          * @param user Usuário dono das musicas
          * @return Vetor contendo as musicas que correspondem ao título
@@ -88,6 +152,19 @@ namespace core {
         std::vector<std::shared_ptr<Song>>
         findByTitleAndUser(const std::string &title, const User &user) const;
 
+        /**
+         * @brief Busca musicas cujo título começa com um prefixo
+         *
+         * Ignora caixa e acentos ("ca" encontra "Canção" e "Çarşı") e usa o
+         * índice da chave de ordenação.
+         *
+         * @param prefix Começo do título
+         * @param user Usuário dono das musicas
+         * @return Musicas encontradas, na ordem da chave de ordenação
+         */
+        std::vector<std::shared_ptr<Song>>
+        findByTitlePrefix(const std::string &prefix, const User &user) const;
+
         /**
          * @brief Busca musicas pelo usuário
          * @param user Usuário dono das musicas a serem buscadas
@@ -120,6 +197,32 @@ namespace core {
          */
         std::shared_ptr<Song> findById(unsigned id) const override;
 
+        /**
+         * @brief Lista os IDs de todas as musicas, sem carregá-las
+         * @return IDs das musicas cadastradas
+         */
+        std::unordered_set<unsigned> findAllIds() const;
+
+        /**
+         * @brief Busca as musicas de vários álbuns em uma consulta
+         * @param album_ids IDs dos álbuns
+         * @return Musicas de cada álbum, ordenadas pelo título
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+        findByAlbums(const std::vector<unsigned> &album_ids) const;
+
+        /**
+         * @brief Busca as musicas de várias playlists em uma consulta
+         *
+         * Artista e álbum de cada música vêm no mesmo JOIN, então abrir a
+         * playlist não dispara outras consultas para exibi-la.
+         *
+         * @param playlist_ids IDs das playlists
+         * @return Musicas de cada playlist, na ordem da playlist
+         */
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+        findByPlaylists(const std::vector<unsigned> &playlist_ids) const;
+
         /**
          * @brief Obtém o album de uma musica
          * @param song Musica cujo album será obtido
@@ -173,6 +276,56 @@ namespace core {
          * @return bool
          */
         bool setPrincipalArtist(const Song &song, const Artist &artist, const User &user) const;
+
+        /**
+         * @brief Busca musicas que ainda precisam de análise de loudness ou
+         * de resumo da forma de onda
+         *
+         * Músicas com ReplayGain (tags ou análise anterior) e com forma de onda
+         * já gravada ficam de fora, então a análise retoma de onde parou.
+         *
+         * @param after_id Retorna apenas IDs maiores que este (paginação)
+         * @param limit Quantidade máxima de musicas
+         * @return Musicas pendentes ordenadas por ID
+         */
+        std::vector<std::shared_ptr<Song>>
+        findPendingAnalysis(unsigned after_id, size_t limit) const;
+
+        /**
+         * @brief Grava os resultados da análise de loudness em uma transação
+         *
+         * Análises bem-sucedidas também preenchem replay_gain/replay_gain_peak;
+         * falhas só marcam analyzed_at para não serem tentadas de novo.
+         *
+         * @param results Resultados a gravar
+         * @return true se a transação foi confirmada
+         */
+        bool saveLoudnessAnalyses(const std::vector<LoudnessAnalysis> &results);
+
+        /**
+         * @brief Grava resumos de forma de onda em uma transação
+         *
+         * Resumos vazios marcam arquivos que não puderam ser decodificados.
+         *
+         * @param waveforms Resumos a gravar (substituem os existentes)
+         * @return true se a transação foi confirmada
+         */
+        bool saveWaveforms(const std::vector<WaveformSummary> &waveforms);
+
+        /**
+         * @brief Busca o resumo da forma de onda de uma música
+         * @param song_id ID da música
+         * @return Resumo ou nullptr se ainda não foi gerado
+         */
+        std::shared_ptr<WaveformSummary> findWaveform(unsigned song_id) const;
+
+        /**
+         * @brief Descarta os artistas e álbuns guardados pela sessão
+         *
+         * Útil depois de alterar artistas ou álbuns por outro repositório;
+         * o próximo acesso de cada música volta a consultar o banco.
+         */
+        void clearRelationCache();
     };
 
 } // namespace core
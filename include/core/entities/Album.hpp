@@ -48,13 +48,16 @@ namespace core {
         std::string _genre;
         int _year;
         // unsigned _user_id;
-        unsigned _artist_id;
+        unsigned _artist_id = 0;
         mutable std::weak_ptr<Artist> _artist;
         mutable std::vector<unsigned> _featuring_artists_ids;
         mutable std::vector<std::shared_ptr<Song>> _songs;
         mutable std::unordered_set<unsigned int> _song_ids;
 
         mutable bool _songsLoaded = false;
+        // vindos do banco até as músicas serem carregadas; depois, mantidos a cada alteração
+        mutable CollectionTotals _totals;
+        bool _hasTotals = false;
 
         std::function<std::vector<std::shared_ptr<Song>>()> songsLoader;
         std::function<std::shared_ptr<Artist>()> artistLoader;
@@ -186,6 +189,16 @@ namespace core {
          */
         size_t getSongsCount() const override;
 
+        /**
+         * @brief Define os totais lidos do banco
+         *
+         * Enquanto as músicas não forem carregadas, getSongsCount() e
+         * calculateTotalDuration() respondem com eles.
+         *
+         * @param totals Número de músicas e duração total
+         */
+        void setTotals(const CollectionTotals &totals);
+
         /**
          * @brief Verifica se as músicas do artista foram carregadas
          */
@@ -43,6 +43,9 @@ namespace core {
         mutable std::vector<std::shared_ptr<Song>> _songs;
         mutable std::unordered_set<unsigned int> _song_ids;
         mutable bool _songsLoaded = false;
+        // vindos do banco até as músicas serem carregadas; depois, mantidos a cada alteração
+        mutable CollectionTotals _totals;
+        bool _hasTotals = false;
         mutable std::vector<std::shared_ptr<Album>> _albums;
         mutable std::unordered_set<unsigned int> _album_ids;
         mutable bool _albumsLoaded = false;
@@ -163,6 +166,16 @@ namespace core {
          */
         size_t getSongsCount() const override;
 
+        /**
+         * @brief Define os totais lidos do banco
+         *
+         * Enquanto as músicas não forem carregadas, getSongsCount() e
+         * calculateTotalDuration() respondem com eles.
+         *
+         * @param totals Número de músicas e duração total
+         */
+        void setTotals(const CollectionTotals &totals);
+
         /**
          * @brief Obtém a quantidade de álbuns do artista
          * @return Número total de álbuns
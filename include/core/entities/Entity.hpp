@@ -21,11 +21,11 @@ namespace core {
 class Entity {
 protected:
 	unsigned _id = 0;      /**< ID da entidade */
-	Datetime _dataCriacao; /** Data de criação */
+	Datetime _dataCriacao; /** Data de criação, lida do banco (created_at) */
 
 public:
-	Entity() : _id(0), _dataCriacao(Datetime()) {};
-	Entity(unsigned id) : _id(id), _dataCriacao(Datetime()) {}
+	Entity() : _id(0) {};
+	Entity(unsigned id) : _id(id) {}
 	virtual ~Entity() = default;
 
 	/**
@@ -40,10 +40,9 @@ public:
 	*/
 	void setId(unsigned id);
 
-	// TODO rever a necessidade de Datetime na Entity
 	/**
 	* @brief Obtém a data de criação
-	* @return a data de criação da entidade
+	* @return a data de criação da entidade, não definida se ela não veio do banco
 	*/
 	const Datetime getDataCriacao() const;
 
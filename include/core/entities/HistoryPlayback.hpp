@@ -32,6 +32,7 @@ namespace core {
         std::shared_ptr<User> _user;  // Associação com a entidade User
         std::shared_ptr<Song> _song;  // Associação com a entidade Song
         std::time_t _played_at;
+        unsigned _play_duration = 0;  // segundos ouvidos; 0 se desconhecido
 
     public:
         HistoryPlayback();
@@ -46,6 +47,17 @@ namespace core {
         HistoryPlayback(User& user,
                         Song& song,
                         std::time_t played_at);
+
+        /**
+         * @brief Constrói compartilhando usuário e música, sem copiá-los
+         *
+         * Usado pelo repositório para que várias reproduções apontem para a
+         * mesma instância de cada entidade.
+         */
+        HistoryPlayback(unsigned id,
+                        std::shared_ptr<User> user,
+                        std::shared_ptr<Song> song,
+                        std::time_t played_at);
         ~HistoryPlayback() override = default;
 
         /**
@@ -84,6 +96,18 @@ namespace core {
          */
         void setPlayedAt(std::time_t played_at);
 
+        /**
+         * @brief Obtém quantos segundos da música foram ouvidos
+         * @return Segundos ouvidos (0 se não informado)
+         */
+        unsigned getPlayDuration() const;
+
+        /**
+         * @brief Define quantos segundos da música foram ouvidos
+         * @param seconds Segundos efetivamente tocados, não a duração da música
+         */
+        void setPlayDuration(unsigned seconds);
+
         /**
          * @brief Obtém uma representação em string do histórico de reprodução
          * @return String representando o histórico de reprodução
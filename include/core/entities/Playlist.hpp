@@ -14,6 +14,7 @@
 #include <memory.h>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <cassert>
@@ -27,6 +28,22 @@
 #include "core/interfaces/IPlayable.hpp"
 
 namespace core {
+    /**
+     * @brief Alterações nas músicas de uma playlist desde o último save
+     *
+     * O repositório só grava as linhas dessas músicas; as demais ficam como
+     * estão no banco.
+     */
+    struct PlaylistChanges {
+        std::unordered_set<unsigned> inserted; /*!< @brief Músicas que ainda não estão no banco */
+        std::unordered_set<unsigned> removed;  /*!< @brief Músicas a apagar do banco */
+        std::unordered_set<unsigned> moved;    /*!< @brief Músicas que mudaram de posição */
+
+        bool empty() const {
+            return inserted.empty() && removed.empty() && moved.empty();
+        }
+    };
+
     /**
      * @class Playlist
      * @brief Representa uma playlist de músicas
@@ -41,11 +58,33 @@ namespace core {
         std::string _title;
         std::shared_ptr<User> _user;
         mutable std::vector<std::shared_ptr<Song>> _songs;
-        mutable std::unordered_set<unsigned int> _song_ids;
+        // id -> índice em _songs; só os índices abaixo de _indexed estão em dia
+        mutable std::unordered_map<unsigned int, size_t> _positions;
+        mutable size_t _indexed = 0;
+        // vindos do banco até as músicas serem carregadas; depois, mantidos a cada alteração
+        mutable CollectionTotals _totals;
+        bool _hasTotals = false;
         std::function<std::vector<std::shared_ptr<Song>>()> _loader;
         mutable bool _songsLoaded = false;
+        PlaylistChanges _changes;
 
-        std::vector<std::shared_ptr<Song>> loadSongs() const;
+        const std::vector<std::shared_ptr<Song>> &loadSongs() const;
+
+        /**
+         * @brief Índice de uma música em _songs
+         *
+         * Inserir, remover ou mover só invalida os índices a partir do ponto
+         * alterado; eles são refeitos na próxima consulta que precisar.
+         *
+         * @return Índice da música, ou _songs.size() se ela não estiver na playlist
+         */
+        size_t indexOf(unsigned songId) const;
+        void insertAt(size_t pos, const std::shared_ptr<Song> &song);
+        void eraseAt(size_t pos);
+
+        void markInserted(unsigned songId);
+        void markRemoved(unsigned songId);
+        void markMoved(unsigned songId);
 
     public:
         /**
@@ -163,6 +202,16 @@ namespace core {
          */
         size_t getSongsCount() const override;
 
+        /**
+         * @brief Define os totais lidos do banco
+         *
+         * Enquanto as músicas não forem carregadas, getSongsCount() e
+         * calculateTotalDuration() respondem com eles.
+         *
+         * @param totals Número de músicas e duração total
+         */
+        void setTotals(const CollectionTotals &totals);
+
         /**
          * @brief Setter da função de loader
          *
@@ -405,5 +454,20 @@ namespace core {
          * @param toIndex índice para o qual a música será movida
          */
         void moveSong(unsigned fromIndex, unsigned toIndex);
+
+        /**
+         * @brief Alterações nas músicas desde o carregamento ou o último save
+         */
+        const PlaylistChanges &getChanges() const;
+
+        /**
+         * @brief Verifica se há alterações nas músicas a gravar
+         */
+        bool hasChanges() const;
+
+        /**
+         * @brief Descarta as alterações registradas (depois de gravá-las)
+         */
+        void clearChanges();
     };
 }  // namespace core
@@ -46,15 +46,19 @@ namespace core {
         std::string _title;
         // unsigned user_id;
         std::shared_ptr<User> _user;
-        unsigned _artist_id;
+        unsigned _artist_id = 0;
         mutable std::weak_ptr<Artist> _artist;
         mutable std::vector<unsigned> _featuring_artists_ids;
-        unsigned _album_id;
+        unsigned _album_id = 0;
         mutable std::weak_ptr<Album> _album;
         int _duration;
         std::string _genre;
         int _year;
         unsigned _track_number;
+        bool _has_replay_gain = false;
+        float _replay_gain = 0.0f;
+        float _replay_gain_peak = 1.0f;
+        float _gain_factor = 1.0f;
         // bool _metadata_loaded;
 
         bool _artistLoaded = false;
@@ -275,6 +279,41 @@ namespace core {
         void setYear(int year);
 
         void setDuration(int sec);
+
+        /**
+         * @brief Define o ganho ReplayGain da faixa
+         *
+         * O fator linear aplicado na reprodução é calculado aqui, uma única vez,
+         * e limitado pelo pico para não clipar.
+         *
+         * @param gain_db Ganho da faixa em dB
+         * @param peak Pico amostral da faixa (1.0 = 0 dBFS)
+         */
+        void setReplayGain(float gain_db, float peak = 1.0f);
+
+        /**
+         * @brief Verifica se a música possui ganho ReplayGain conhecido
+         * @return true se o ganho foi lido das tags ou calculado
+         */
+        bool hasReplayGain() const;
+
+        /**
+         * @brief Obtém o ganho ReplayGain da faixa
+         * @return Ganho em dB
+         */
+        float getReplayGain() const;
+
+        /**
+         * @brief Obtém o pico amostral da faixa
+         * @return Pico linear (1.0 = 0 dBFS)
+         */
+        float getReplayGainPeak() const;
+
+        /**
+         * @brief Obtém o fator de ganho linear pré-calculado
+         * @return Fator a ser aplicado no volume da faixa (1.0 sem ReplayGain)
+         */
+        float getGainFactor() const;
         // Métodos
 
         /**
@@ -350,6 +389,18 @@ namespace core {
          */
         bool operator>=(const Entity &other) const override;
 
+        /**
+         * @brief Versão tipada de operator<, sem dynamic_cast
+         *
+         * Ordem lexicográfica por IDs de artista e álbum, número da faixa e
+         * título; não carrega relações. Para ordenar muitas músicas, ver SongSort.
+         */
+        bool operator<(const Song &other) const;
+
+        /**
+         * @brief Versão tipada de operator>, sem dynamic_cast
+         */
+        bool operator>(const Song &other) const;
 
         /**
          * @brief Obtém o caminho do arquivo de áudio
@@ -13,6 +13,28 @@
 namespace core {
     class Song;
 
+    /**
+     * @brief Totais de uma coleção
+     *
+     * Vêm do banco junto com a coleção (colunas song_count/total_duration)
+     * e são mantidos a cada música adicionada ou removida, então contagem e
+     * duração não exigem carregar as músicas.
+     */
+    struct CollectionTotals {
+        std::size_t songs = 0; /*!< @brief Número de músicas */
+        unsigned duration = 0; /*!< @brief Duração total em segundos */
+
+        void add(int seconds) {
+            ++songs;
+            duration += static_cast<unsigned>(seconds);
+        }
+
+        void remove(int seconds) {
+            --songs;
+            duration -= static_cast<unsigned>(seconds);
+        }
+    };
+
     class ICollection {
     public:
         virtual ~ICollection() = default;
@@ -0,0 +1,149 @@
+/**
+ * @file AudioAnalysisJob.hpp
+ * @brief Job de análise de áudio da biblioteca em segundo plano
+ *
+ * Decodifica as músicas que não têm ReplayGain nas tags, mede a loudness
+ * EBU R128 e o true peak e grava o resultado na linha da música. A mesma
+ * decodificação gera o resumo da forma de onda (song_waveforms). O trabalho
+ * é dividido entre threads de baixa prioridade; o progresso fica no banco
+ * (analyzed_at e song_waveforms), então uma execução interrompida retoma de
+ * onde parou.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/bd/SongRepository.hpp"
+
+namespace core {
+
+    /**
+     * @brief Estatísticas de uma execução do job
+     */
+    struct AnalysisReport {
+        size_t analyzed = 0;         /*!< @brief Músicas analisadas com sucesso */
+        size_t failed = 0;           /*!< @brief Músicas que não puderam ser decodificadas */
+        double audio_seconds = 0.0;  /*!< @brief Duração total de áudio decodificado */
+        double elapsed_seconds = 0.0;
+        unsigned workers = 0;
+
+        /**
+         * @brief Vazão do job
+         * @return Músicas por segundo por thread de trabalho
+         */
+        double tracksPerSecondPerCore() const;
+    };
+
+    /**
+     * @class AudioAnalysisJob
+     * @brief Analisa loudness das músicas pendentes usando um pool de threads
+     */
+    class AudioAnalysisJob {
+    private:
+        std::shared_ptr<SongRepository> _songRepo;
+        unsigned _workers;
+        size_t _batch_size;
+
+        std::atomic<bool> _stop_requested;
+        std::atomic<bool> _running;
+        std::thread _thread;
+
+        mutable std::mutex _report_mutex;
+        AnalysisReport _report;
+
+        struct Task {
+            unsigned song_id;
+            std::string path;
+            bool loudness; /*!< @brief false se a música já tem ReplayGain */
+        };
+
+        struct TaskResult {
+            bool loudness = false;
+            LoudnessAnalysis analysis;
+            WaveformSummary waveform;
+        };
+
+        /**
+         * @brief Analisa um lote de arquivos em paralelo
+         * @param tasks Arquivos do lote
+         * @return Resultados na mesma ordem; tarefas não executadas por causa
+         * de stop() ficam de fora
+         */
+        std::vector<TaskResult> analyzeBatch(const std::vector<Task> &tasks);
+
+        /**
+         * @brief Reduz a prioridade de escalonamento da thread atual
+         */
+        static void lowerCurrentThreadPriority();
+
+    public:
+        /**
+         * @brief Construtor
+         * @param songRepo Repositório de músicas, com conexão só dele
+         * (DatabaseManager::openConnection()): é usado na thread do job
+         * @param workers Número de threads de análise (0 = núcleos disponíveis)
+         * @param batch_size Quantidade de músicas buscadas e gravadas por vez
+         */
+        AudioAnalysisJob(std::shared_ptr<SongRepository> songRepo,
+                         unsigned workers = 0,
+                         size_t batch_size = 64);
+
+        /**
+         * @brief Destrutor, interrompe e aguarda a execução em segundo plano
+         */
+        ~AudioAnalysisJob();
+
+        AudioAnalysisJob(const AudioAnalysisJob &) = delete;
+        AudioAnalysisJob &operator=(const AudioAnalysisJob &) = delete;
+
+        /**
+         * @brief Executa a análise na thread atual até acabarem as pendências
+         * @param limit Número máximo de músicas (0 = todas)
+         * @return Estatísticas da execução
+         */
+        AnalysisReport run(size_t limit = 0);
+
+        /**
+         * @brief Executa run() em uma thread separada
+         * @param limit Número máximo de músicas (0 = todas)
+         */
+        void start(size_t limit = 0);
+
+        /**
+         * @brief Pede a interrupção e aguarda o lote atual ser gravado
+         */
+        void stop();
+
+        /**
+         * @brief Verifica se a análise está em execução
+         */
+        bool isRunning() const;
+
+        /**
+         * @brief Estatísticas da execução atual ou da última
+         */
+        AnalysisReport report() const;
+
+        /**
+         * @brief Decodifica um arquivo e mede sua loudness
+         * @param path Caminho do arquivo de áudio
+         * @param song_id ID gravado no resultado
+         * @param waveform Se não for nulo, recebe o resumo da forma de onda
+         * gerado na mesma decodificação
+         * @return Resultado da análise (success = false se não decodificou)
+         */
+        static LoudnessAnalysis analyzeFile(const std::string &path,
+                                            unsigned song_id = 0,
+                                            WaveformSummary *waveform = nullptr);
+    };
+}
@@ -112,6 +112,43 @@ namespace core {
          */
         Enviroment enviroment() const;
 
+        /**
+         * @brief Obtém a duração do crossfade entre faixas consecutivas
+         * @return Duração em milissegundos (0 desativa o crossfade)
+         */
+        unsigned crossfadeMilliseconds() const;
+
+        /**
+         * @brief Verifica se a normalização por ReplayGain está habilitada
+         * @return true se o ganho das faixas deve ser aplicado na reprodução
+         */
+        bool replayGainEnabled() const;
+
+        /**
+         * @brief Obtém a saída de áudio configurada
+         * @return "device" (padrão), "null" (relógio virtual, sem placa de som)
+         * ou "auto" (dispositivo, com "null" se não houver)
+         */
+        std::string audioBackend() const;
+
+        /**
+         * @brief Obtém a velocidade do relógio virtual do backend "null"
+         * @return Multiplicador do tempo real (padrão 1.0)
+         */
+        double timeScale() const;
+
+        /**
+         * @brief Obtém por quantos dias as reproduções ficam no histórico bruto
+         * @return Janela de retenção em dias (0 mantém o histórico inteiro)
+         */
+        unsigned historyRetentionDays() const;
+
+        /**
+         * @brief Obtém o arquivo onde a fila de reprodução é salva entre sessões
+         * @return Caminho do snapshot da fila
+         */
+        std::string queueSnapshotPath() const;
+
         std::string toString() const;
     };
 }
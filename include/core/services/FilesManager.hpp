@@ -24,9 +24,11 @@
 #ifdef _WIN32
     #include <taglib/tag.h>
     #include <taglib/fileref.h>
+    #include <taglib/tpropertymap.h>
 #elif __linux__
     #include <taglib/tag.h>
     #include <taglib/fileref.h>
+    #include <taglib/tpropertymap.h>
 #endif
 #include <string>
 
@@ -63,6 +65,18 @@ namespace core {
          */
         std::shared_ptr<Song> readMetadata(TagLib::FileRef file, User &user);
 
+        /**
+         * @brief Lê as tags ReplayGain (REPLAYGAIN_TRACK_GAIN/PEAK) do arquivo
+         *
+         * O ganho é gravado na música durante a importação, assim a reprodução
+         * nunca precisa analisar o áudio para normalizar o volume.
+         *
+         * @param file Arquivo aberto pelo TagLib
+         * @param song Música que receberá o ganho
+         * @return true se a tag de ganho foi encontrada
+         */
+        bool readReplayGain(TagLib::FileRef &file, Song &song);
+
         /**
          * @brief Verifica ou cria o diretório antes de salvar uma música
          *
@@ -0,0 +1,120 @@
+/**
+ * @file HistoryCompactionJob.hpp
+ * @brief Retenção e compactação do histórico de reprodução
+ *
+ * O histórico bruto (playback_history) cresce uma linha por reprodução.
+ * Como cada reprodução já é somada aos agregados por música, artista e dia
+ * no momento da gravação, as linhas mais antigas que a janela de retenção
+ * podem ser apagadas sem perder contagens nem tempo de escuta. Depois da
+ * remoção, as páginas livres são devolvidas ao sistema com o auto_vacuum
+ * incremental, mantendo o arquivo e o índice (user_id, played_at) enxutos.
+ * Bancos criados antes do auto_vacuum incremental são convertidos aqui, na
+ * primeira compactação que remover linhas, e não ao abrir o banco. A
+ * conversão reescreve o arquivo inteiro, então o CLI roda o job em outra
+ * thread, com uma conexão própria (DatabaseManager::openConnection()).
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#pragma once
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <thread>
+
+#include <SQLiteCpp/SQLiteCpp.h>
+
+#include "core/bd/HistoryPlaybackRepository.hpp"
+
+#define HISTORY_RETENTION_DAYS_DEFAULT 180
+#define HISTORY_RETENTION_MIN_DAYS 30  // janela usada pelo embaralhamento inteligente
+
+namespace core {
+
+    /**
+     * @brief Resultado de uma compactação
+     */
+    struct CompactionReport {
+        size_t removed = 0;      /*!< @brief Linhas apagadas de playback_history */
+        size_t freed_pages = 0;  /*!< @brief Páginas devolvidas pelo vacuum */
+    };
+
+    /**
+     * @class HistoryCompactionJob
+     * @brief Apaga o histórico bruto fora da janela de retenção
+     */
+    class HistoryCompactionJob {
+    private:
+        std::shared_ptr<SQLite::Database> _db;
+        HistoryPlaybackRepository _repository;
+        unsigned _retention_days;
+
+        std::atomic<bool> _stop_requested;
+        std::atomic<bool> _running;
+        std::thread _thread;
+
+        size_t freePages() const;
+
+        /**
+         * @brief Verifica se o banco já usa auto_vacuum incremental
+         */
+        bool incrementalVacuumEnabled() const;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param db Conexão com o banco
+         * @param retention_days Dias mantidos no histórico bruto (0 mantém
+         * tudo; valores menores que HISTORY_RETENTION_MIN_DAYS são elevados
+         * a ele)
+         */
+        explicit HistoryCompactionJob(std::shared_ptr<SQLite::Database> db,
+                                      unsigned retention_days = HISTORY_RETENTION_DAYS_DEFAULT);
+
+        /**
+         * @brief Destrutor, interrompe e aguarda a execução em segundo plano
+         */
+        ~HistoryCompactionJob();
+
+        HistoryCompactionJob(const HistoryCompactionJob &) = delete;
+        HistoryCompactionJob &operator=(const HistoryCompactionJob &) = delete;
+
+        /**
+         * @brief Janela de retenção efetiva, em dias
+         */
+        unsigned retentionDays() const;
+
+        /**
+         * @brief Remove as reproduções antigas e libera as páginas vazias
+         *
+         * Se o banco ainda não usa auto_vacuum incremental, a liberação é
+         * um VACUUM completo, feito uma única vez, que ativa o modo.
+         *
+         * @param now Instante de referência da janela
+         * @return Estatísticas da execução
+         */
+        CompactionReport run(std::time_t now = std::time(nullptr));
+
+        /**
+         * @brief Executa run() em uma thread separada
+         * @param now Instante de referência da janela
+         */
+        void start(std::time_t now = std::time(nullptr));
+
+        /**
+         * @brief Interrompe a consulta em andamento e aguarda a thread
+         *
+         * O lote ou VACUUM interrompido é desfeito pelo SQLite; o que
+         * faltou fica para a próxima execução.
+         */
+        void stop();
+
+        /**
+         * @brief Verifica se a compactação está em execução
+         */
+        bool isRunning() const;
+    };
+}
@@ -0,0 +1,136 @@
+/**
+ * @file HistoryWriter.hpp
+ * @brief Gravação em lote e em segundo plano do histórico de reprodução
+ *
+ * Quem registra uma reprodução só coloca o evento em uma fila circular sem
+ * locks; uma thread própria grava os eventos no banco em uma única
+ * transação a cada N eventos ou a cada T segundos, o que vier primeiro.
+ * Assim a troca de faixa nunca espera pelo SQLite. Os eventos pendentes
+ * são gravados ao encerrar.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/util/RingBuffer.hpp"
+
+#define HISTORY_BATCH_SIZE_DEFAULT 32
+#define HISTORY_CAPACITY_DEFAULT 1024
+
+namespace core {
+
+    /**
+     * @class HistoryWriter
+     * @brief Grava eventos de reprodução em lote, fora da thread de quem toca
+     */
+    class HistoryWriter {
+    private:
+        std::shared_ptr<HistoryPlaybackRepository> _repository;
+        RingBuffer<PlaybackEvent> _events;
+        size_t _batch_size;
+        std::chrono::milliseconds _flush_interval;
+
+        std::atomic<bool> _running;
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _wake;    /*!< @brief Acorda a thread de gravação */
+        std::condition_variable _flushed; /*!< @brief Avisa quem espera em flush() */
+        uint64_t _flush_requested;        /*!< @brief Pedidos de flush (protegido por _mutex) */
+        uint64_t _flush_done;             /*!< @brief Pedidos atendidos (protegido por _mutex) */
+
+        std::atomic<size_t> _pending;
+        std::atomic<size_t> _written;
+        std::atomic<size_t> _dropped;
+        std::atomic<size_t> _failed;
+
+        /**
+         * @brief Laço da thread de gravação
+         */
+        void run();
+
+        /**
+         * @brief Grava todos os eventos na fila em uma transação
+         * @return Número de eventos retirados da fila
+         */
+        size_t drain();
+
+    public:
+        /**
+         * @brief Construtor; inicia a thread de gravação
+         * @param repository Repositório onde os eventos serão gravados
+         * @param batch_size Eventos que disparam uma gravação
+         * @param flush_interval Intervalo máximo entre gravações
+         * @param capacity Eventos que cabem na fila antes de descartar
+         */
+        HistoryWriter(std::shared_ptr<HistoryPlaybackRepository> repository,
+                      size_t batch_size = HISTORY_BATCH_SIZE_DEFAULT,
+                      std::chrono::milliseconds flush_interval = std::chrono::seconds(5),
+                      size_t capacity = HISTORY_CAPACITY_DEFAULT);
+
+        /**
+         * @brief Destrutor; grava os eventos pendentes antes de sair
+         */
+        ~HistoryWriter();
+
+        HistoryWriter(const HistoryWriter &) = delete;
+        HistoryWriter &operator=(const HistoryWriter &) = delete;
+
+        /**
+         * @brief Registra uma reprodução sem bloquear
+         * @param event Evento de reprodução
+         * @return false se a fila estiver cheia (o evento é descartado)
+         */
+        bool record(const PlaybackEvent &event);
+
+        /**
+         * @brief Registra uma reprodução que terminou ou foi interrompida
+         * @param user Usuário que ouviu
+         * @param song Música reproduzida (precisa estar persistida)
+         * @param listened_seconds Segundos efetivamente tocados
+         * @param played_at Instante em que a música começou a tocar
+         * @return false se o evento não foi registrado
+         */
+        bool record(const User &user, const Song &song, unsigned listened_seconds,
+                    std::time_t played_at = std::time(nullptr));
+
+        /**
+         * @brief Espera a gravação de todos os eventos registrados até agora
+         */
+        void flush();
+
+        /**
+         * @brief Grava os eventos pendentes e encerra a thread
+         */
+        void stop();
+
+        /**
+         * @brief Eventos gravados no banco
+         */
+        size_t written() const;
+
+        /**
+         * @brief Eventos descartados por fila cheia
+         */
+        size_t dropped() const;
+
+        /**
+         * @brief Eventos perdidos por erro de gravação
+         */
+        size_t failed() const;
+    };
+}
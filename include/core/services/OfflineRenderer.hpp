@@ -0,0 +1,121 @@
+/**
+ * @file OfflineRenderer.hpp
+ * @brief Renderização offline de uma fila de reprodução para WAV
+ *
+ * Usa o mesmo caminho de decodificação do Player (ma_sound sobre um
+ * ma_engine), mas com o engine sem dispositivo: os quadros são puxados com
+ * ma_engine_read_pcm_frames o mais rápido possível e gravados em um arquivo
+ * WAV. Serve para pré-renderizar mixagens e para testes de integração
+ * determinísticos que não dependem de hardware de áudio.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-23
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/entities/Song.hpp"
+#include "core/services/PlaybackQueue.hpp"
+
+namespace core {
+
+    /**
+     * @brief Estatísticas de uma renderização
+     */
+    struct RenderReport {
+        size_t tracks = 0;           /*!< @brief Faixas renderizadas */
+        size_t failed = 0;           /*!< @brief Faixas que não puderam ser carregadas */
+        double audio_seconds = 0.0;  /*!< @brief Duração do arquivo gerado */
+        double elapsed_seconds = 0.0;
+
+        /**
+         * @brief Quantas vezes mais rápido que o tempo real
+         */
+        double speedUp() const;
+    };
+
+    /**
+     * @class OfflineRenderer
+     * @brief Renderiza faixas em sequência (com crossfade opcional) para WAV
+     */
+    class OfflineRenderer {
+    private:
+        struct Track {
+            std::string path;
+            float gain;
+        };
+
+        unsigned _sample_rate;
+        unsigned _channels;
+        unsigned _crossfadeMs;
+        bool _replayGainEnabled;
+
+        /**
+         * @brief Renderiza a lista de faixas
+         * @param tracks Arquivos e ganhos, na ordem de reprodução
+         * @param output_path Arquivo WAV de saída
+         * @return Estatísticas da renderização
+         */
+        RenderReport renderTracks(const std::vector<Track> &tracks,
+                                  const std::string &output_path) const;
+
+        float trackGain(const Song &song) const;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param sample_rate Taxa de amostragem do arquivo gerado
+         * @param channels Número de canais do arquivo gerado
+         */
+        OfflineRenderer(unsigned sample_rate = 44100, unsigned channels = 2);
+
+        /**
+         * @brief Define a duração do crossfade entre faixas
+         * @param milliseconds Duração em milissegundos (0 desativa)
+         */
+        void setCrossfade(unsigned milliseconds);
+
+        /**
+         * @brief Obtém a duração do crossfade
+         * @return Duração em milissegundos
+         */
+        unsigned getCrossfade() const;
+
+        /**
+         * @brief Ativa ou desativa a normalização por ReplayGain
+         * @param enabled true para aplicar o ganho das músicas
+         */
+        void setReplayGain(bool enabled);
+
+        /**
+         * @brief Renderiza uma fila de reprodução
+         * @param queue Fila (na ordem atual, a partir do início)
+         * @param output_path Arquivo WAV de saída
+         * @return Estatísticas da renderização
+         */
+        RenderReport render(const PlaybackQueue &queue, const std::string &output_path) const;
+
+        /**
+         * @brief Renderiza uma lista de músicas
+         * @param songs Músicas na ordem de reprodução
+         * @param output_path Arquivo WAV de saída
+         * @return Estatísticas da renderização
+         */
+        RenderReport render(const std::vector<std::shared_ptr<Song>> &songs,
+                            const std::string &output_path) const;
+
+        /**
+         * @brief Renderiza arquivos de áudio diretamente, sem ganho por faixa
+         * @param files Caminhos dos arquivos na ordem de reprodução
+         * @param output_path Arquivo WAV de saída
+         * @return Estatísticas da renderização
+         */
+        RenderReport renderFiles(const std::vector<std::string> &files,
+                                 const std::string &output_path) const;
+    };
+}
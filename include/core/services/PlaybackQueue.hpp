@@ -12,9 +12,12 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <random>
+#include <unordered_map>
 #include <vector>
 
 #include "core/bd/HistoryPlaybackRepository.hpp"
@@ -22,29 +25,101 @@
 #include "core/entities/Song.hpp"
 #include "core/entities/User.hpp"
 #include "core/interfaces/IPlayable.hpp"
+#include "core/services/QueueSnapshot.hpp"
+#include "core/util/IndexedSequence.hpp"
+#include "core/util/WeightedSampler.hpp"
 
 #define MAX_SIZE_DEFAULT 200
 
 namespace core {
 
+    /**
+     * @brief Estratégia de sorteio do modo aleatório
+     */
+    enum class ShuffleMode {
+        UNIFORM, /*!< @brief Todas as músicas restantes com a mesma chance */
+        SMART    /*!< @brief Menos tocadas recentemente primeiro, evitando repetir artista */
+    };
+
     /**
      * @brief Servico de fila de reproducões
      *
-     * Servico para gerenciar a fila de músicas a serem reproduzidas.
+     * Servico para gerenciar a fila de músicas a serem reproduzidas. As
+     * ordens de inserção e aleatória são sequências indexadas, então
+     * adicionar, remover, mover e acessar por posição custam O(log n) nos
+     * dois modos.
+     *
+     * O modo aleatório é um Fisher–Yates incremental: a ordem aleatória é
+     * formada pelas músicas já tocadas quando o modo foi ativado, seguidas
+     * das músicas sorteadas até agora. A próxima música só é sorteada, entre
+     * as que ainda não saíram, quando alguém precisa dela (ao avançar ou
+     * consultar uma posição), então ativar o modo custa O(1) e as músicas já
+     * tocadas não voltam a ser sorteadas.
+     *
+     * No embaralhamento inteligente (ShuffleMode::SMART) o sorteio é
+     * ponderado pelo histórico do usuário, com os pesos em uma árvore de
+     * Fenwick; ativá-lo custa uma consulta agregada e O(n) para montar os
+     * pesos, e cada sorteio continua O(log n).
+     *
+     * A fila pode ser salva em um QueueSnapshot e restaurada dele. Na
+     * restauração as entradas guardam só o ID da música, que é carregada
+     * quando alguém precisa dela, então restaurar não depende do banco.
      */
     class PlaybackQueue {
+    public:
+        /**
+         * @brief Carrega uma música pelo ID
+         */
+        using SongLoader = std::function<std::shared_ptr<Song>(unsigned)>;
+
     private:
-        std::vector<std::shared_ptr<Song>>
-            _queue;                            /*!< @brief Fila de músicas */
-        std::vector<size_t> _indices_aleatory; /*!< @brief Índices embaralhados
-                                                  para reprodução aleatória */
-        size_t _current;  /*!< @brief Índice da música atual na fila */
+        /**
+         * @brief Música na fila, com sua posição em cada uma das ordens
+         */
+        struct QueueEntry {
+            std::shared_ptr<Song> song;  /*!< @brief Nula até ser carregada, em filas restauradas */
+            IndexedSequence<QueueEntry *>::Handle ordered = nullptr;  /*!< @brief Posição na ordem de inserção */
+            IndexedSequence<QueueEntry *>::Handle shuffled = nullptr; /*!< @brief Posição na ordem aleatória */
+            size_t slot = 0; /*!< @brief Posição no sorteio ponderado (válida se _slot_entries[slot] == this) */
+            unsigned song_id = 0;
+        };
+
+        // mutáveis: o sorteio é preguiçoso e também acontece em consultas const
+        mutable IndexedSequence<QueueEntry *>
+            _ordered;  /*!< @brief Fila na ordem de inserção (dona das entradas); marca as sorteadas */
+        mutable IndexedSequence<QueueEntry *>
+            _shuffled; /*!< @brief Músicas sorteadas no modo aleatório, na ordem do sorteio */
+        mutable std::mt19937_64 _rng;
+        mutable WeightedSampler _sampler; /*!< @brief Pesos das não sorteadas no modo SMART */
+        std::vector<QueueEntry *> _slot_entries; /*!< @brief Entrada de cada posição do sorteio ponderado */
+        std::unordered_map<unsigned, SongPlayStats>
+            _play_stats; /*!< @brief Reproduções recentes do usuário, por ID de música */
+        ShuffleMode _shuffle_mode;
+        mutable std::unordered_multimap<const Song *, QueueEntry *>
+            _entries_by_song; /*!< @brief Entradas por instância de música (só as carregadas) */
+        std::unordered_multimap<unsigned, QueueEntry *>
+            _entries_by_id;   /*!< @brief Entradas por ID de música persistida */
+
+        size_t _current;  /*!< @brief Posição da música atual na ordem ativa */
+        size_t _history;  /*!< @brief Músicas tocadas antes de ativar o modo aleatório (início de _ordered) */
         size_t _max_size; /*!< @brief Tamanho máximo da fila */
         bool _aleatory;   /*!< @brief Indica se a reprodução é aleatória */
         bool _loop;      /*!< @brief Indica se a reprodução está em loop */
         std::shared_ptr<HistoryPlaybackRepository>
             _history_repo; /*!< @brief Repositório de histórico de reprodução */
         std::shared_ptr<User> _current_user; /*!< @brief Usuário atual */
+        SongLoader _song_loader; /*!< @brief Carrega as músicas de uma fila restaurada */
+        mutable uint64_t _revision; /*!< @brief Incrementada a cada mudança */
+
+        /**
+         * @brief Música da entrada, carregando-a se necessário
+         */
+        std::shared_ptr<Song> songOf(QueueEntry* entry) const;
+
+        /**
+         * @brief Cria uma entrada no fim da ordem de inserção
+         */
+        QueueEntry* pushEntry(const std::shared_ptr<Song>& song, unsigned song_id);
 
         /**
          * @brief Adiciona registro de reprodução ao histórico
@@ -52,7 +127,98 @@ namespace core {
          */
         void addToHistory(const Song& song);
 
-        size_t getCurrentIndex() const;
+        /**
+         * @brief Entrada na posição indicada da ordem ativa
+         *
+         * No modo aleatório, sorteia as músicas necessárias até a posição.
+         *
+         * @return Entrada ou nullptr se a posição for inválida
+         */
+        QueueEntry* entryAt(size_t index) const;
+
+        /**
+         * @brief Posição de uma entrada na ordem ativa
+         */
+        size_t activeIndexOf(const QueueEntry* entry) const;
+
+        /**
+         * @brief Adiciona uma música ao fim da fila
+         *
+         * No modo aleatório a música entra no conjunto das ainda não
+         * sorteadas, sem alterar as posições já definidas.
+         */
+        void append(const std::shared_ptr<Song>& song);
+
+        /**
+         * @brief Quantidade de posições já definidas na ordem aleatória
+         */
+        size_t drawnCount() const;
+
+        /**
+         * @brief Sorteia a próxima música entre as que ainda não saíram
+         */
+        QueueEntry* drawNext() const;
+
+        /**
+         * @brief Sorteia músicas até que a posição indicada esteja definida
+         */
+        void drawUntil(size_t index) const;
+
+        /**
+         * @brief Sorteia, ponderando pelos pesos do modo SMART, a posição
+         * entre as não sorteadas
+         */
+        QueueEntry* drawWeighted() const;
+
+        /**
+         * @brief Peso de uma música no embaralhamento inteligente
+         */
+        double smartWeight(const QueueEntry* entry) const;
+
+        /**
+         * @brief Carrega as reproduções recentes do usuário em uma consulta
+         */
+        void loadPlayStats();
+
+        /**
+         * @brief Monta os pesos de todas as músicas não sorteadas
+         */
+        void buildSampler();
+
+        /**
+         * @brief Inclui (ou devolve) a entrada no sorteio ponderado
+         */
+        void addToSampler(QueueEntry* entry);
+
+        /**
+         * @brief Zera o peso da entrada no sorteio ponderado, se houver
+         */
+        void removeFromSampler(QueueEntry* entry) const;
+
+        /**
+         * @brief Verifica se a entrada já tem posição na ordem ativa
+         */
+        bool isDrawn(const QueueEntry* entry) const;
+
+        /**
+         * @brief Devolve ao sorteio as músicas sorteadas depois da atual
+         */
+        void undrawUpcoming();
+
+        /**
+         * @brief Copia o histórico anterior ao modo aleatório para _shuffled
+         *
+         * Necessário antes de reordenar posições desse histórico.
+         */
+        void flattenHistory();
+
+        void indexEntry(QueueEntry* entry);
+        void unindexEntry(QueueEntry* entry);
+
+        /**
+         * @brief Copia músicas, ordens e posição de outra fila
+         */
+        void copyFrom(const PlaybackQueue& other);
 
     public:
         PlaybackQueue();
@@ -64,6 +230,9 @@ namespace core {
                       std::shared_ptr<HistoryPlaybackRepository> history_repo,
                       size_t max_size = MAX_SIZE_DEFAULT);
 
+        PlaybackQueue(const PlaybackQueue& other);
+        PlaybackQueue& operator=(const PlaybackQueue& other);
+
         ~PlaybackQueue();
 
         /**
@@ -99,6 +268,11 @@ namespace core {
 
         /**
          * @brief Encontra o proximo índice na fila da música pesquisada
+         *
+         * Considera a música atual e as seguintes. A busca é pela instância
+         * da música ou, para músicas persistidas, pelo ID. No modo aleatório,
+         * se a música ainda não foi sorteada, o sorteio avança até ela.
+         *
          * @param song Música a ser encontrada
          * @return Índice da música ou -1 se não encontrada
          */
@@ -216,6 +390,33 @@ namespace core {
          */
         bool toggleAleatory();
 
+        /**
+         * @brief Define a semente do sorteio do modo aleatório
+         *
+         * Com a mesma semente e as mesmas operações, a ordem sorteada é a
+         * mesma.
+         *
+         * @param seed Semente
+         */
+        void setSeed(uint64_t seed);
+
+        /**
+         * @brief Define a estratégia de sorteio do modo aleatório
+         *
+         * No modo SMART as músicas menos tocadas pelo usuário nos últimos
+         * dias têm mais chance e o sorteio evita o mesmo artista em
+         * sequência. Se o modo aleatório estiver ativo, as músicas depois da
+         * atual são sorteadas de novo com a nova estratégia.
+         *
+         * @param mode Estratégia de sorteio
+         */
+        void setShuffleMode(ShuffleMode mode);
+
+        /**
+         * @brief Obtém a estratégia de sorteio do modo aleatório
+         */
+        ShuffleMode getShuffleMode() const;
+
         /**
          * @brief Verifica se a reprodução aleatória está habilitada
          * @return true se estiver habilitada, false caso contrário
@@ -241,7 +442,10 @@ namespace core {
         bool isLoop() const;
 
         /**
-         * @brief Embaralha a fila de reprodução
+         * @brief Embaralha as músicas seguintes à atual
+         *
+         * Ativa o modo aleatório, se necessário, e descarta o sorteio das
+         * músicas depois da atual. As músicas já tocadas mantêm sua posição.
          */
         void shuffle();
 
@@ -260,6 +464,36 @@ namespace core {
         std::string toString() const;
 
         std::string toStringDetailed() const;
+
+        /**
+         * @brief Contador de mudanças da fila
+         *
+         * Muda sempre que o conteúdo, a ordem, a posição ou os modos mudam;
+         * serve para saber se vale salvar um novo snapshot.
+         */
+        uint64_t revision() const;
+
+        /**
+         * @brief Fotografa o estado atual da fila
+         *
+         * Músicas sem ID (não persistidas) ficam de fora.
+         *
+         * @return Snapshot com músicas, ordem sorteada, posição e modos
+         */
+        QueueSnapshot snapshot() const;
+
+        /**
+         * @brief Substitui o conteúdo da fila pelo de um snapshot
+         *
+         * Nenhuma música é carregada aqui: cada uma é pedida a loader na
+         * primeira vez que for acessada.
+         *
+         * @param snapshot Estado salvo
+         * @param loader Carrega uma música pelo ID
+         * @throws std::length_error se o snapshot passar do tamanho máximo
+         * @throws std::invalid_argument se as posições forem inconsistentes
+         */
+        void restore(const QueueSnapshot& snapshot, SongLoader loader);
     };
 
 }  // namespace core
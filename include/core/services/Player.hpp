@@ -12,13 +12,23 @@
 
 #include <miniaudio.h>
 
+#include <cstdint>
+#include <ctime>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 #include <atomic>
 
 #include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/HistoryWriter.hpp"
 #include "core/services/PlaybackQueue.hpp"
 
+#define QUEUE_NAME_DEFAULT "principal"
+
 namespace core {
 
     enum class PlayerState {
@@ -27,6 +37,70 @@ namespace core {
         PAUSED
     };
 
+    /**
+     * @brief Saída de áudio do Player
+     *
+     * NULL_DEVICE não abre dispositivo: um relógio virtual puxa os quadros do
+     * engine e os descarta, para rodar em máquinas sem placa de som (CI,
+     * servidores) e acelerar o tempo em testes longos.
+     */
+    enum class AudioBackend {
+        DEVICE,
+        NULL_DEVICE
+    };
+
+    /**
+     * @brief Retrato imutável do estado do player, para leitura por outras threads
+     *
+     * Publicado pelo Player a cada mudança de estado (troca de faixa, pausa,
+     * seek, volume, fila). A posição não é republicada enquanto a música
+     * toca: o retrato guarda o cursor e o relógio do engine no instante da
+     * publicação, e elapsedAt() extrapola a partir do relógio atual.
+     */
+    struct PlayerStatus {
+        uint64_t sequence = 0; /*!< @brief Incrementado a cada publicação */
+        PlayerState state = PlayerState::STOPPED;
+
+        bool has_song = false;
+        unsigned song_id = 0;
+        std::string title;
+        std::string artist;
+        std::string album;
+        unsigned duration = 0; /*!< @brief Duração em segundos, pelas tags */
+
+        std::string next_title;
+        std::string next_artist;
+
+        uint64_t cursor_frames = 0;  /*!< @brief Cursor da faixa na publicação */
+        uint64_t length_frames = 0;  /*!< @brief Tamanho da faixa (0 se ainda desconhecido) */
+        uint64_t engine_time = 0;    /*!< @brief Relógio do engine na publicação */
+        uint32_t sample_rate = 0;
+
+        float volume = 1.0f;
+        bool muted = false;
+        bool looping = false;
+        unsigned crossfade_ms = 0;
+
+        size_t queue_size = 0;
+        std::string queue_name;
+
+        /**
+         * @brief Tempo decorrido da faixa em segundos
+         * @param now Relógio atual do engine (Player::getEngineTime())
+         */
+        unsigned elapsedAt(uint64_t now) const;
+
+        /**
+         * @brief Progresso da faixa, de 0 a 1
+         * @param now Relógio atual do engine (Player::getEngineTime())
+         */
+        float progressAt(uint64_t now) const;
+
+    private:
+        uint64_t framesAt(uint64_t now) const;
+        uint64_t totalFrames() const;
+    };
+
     /**
      * @class Player
      * @brief Controlador de reprodução de áudio com funcionalidades básicas
@@ -37,9 +111,24 @@ namespace core {
      */
     class Player {
     private:
-        std::vector<std::shared_ptr<core::PlaybackQueue>> _queues;
+        /**
+         * @brief Fila nomeada e o estado de reprodução guardado enquanto ela está inativa
+         *
+         * Ao trocar de fila o som atual é só parado e guardado aqui, já
+         * decodificado e com o cursor onde parou; voltar para a fila não
+         * recarrega o arquivo.
+         */
+        struct QueueContext {
+            std::shared_ptr<core::PlaybackQueue> queue;
+            std::shared_ptr<const core::Song> song;
+            int songIndex = -1;
+            std::unique_ptr<ma_sound> sound; /*!< @brief Deck estacionado; nulo na fila ativa */
+            std::time_t startedAt = 0;       /*!< @brief Início da reprodução ainda não registrada */
+        };
+
+        std::map<std::string, QueueContext> _contexts;
+        std::string _currentContext;
         std::shared_ptr<const core::Song> _currentSong;
-        int _currentQueueIndex;
         int _currentSongIndex;
         PlayerState _playerState;
         bool _isLooping;
@@ -49,10 +138,48 @@ namespace core {
 
         // miniaudio
         ma_engine _audioEngine;
-        ma_sound _currentSound;
+        ma_sound_group _mixBus;     /*!< @brief Nó do grafo onde os decks são mixados (volume master) */
+        std::unique_ptr<ma_sound> _decks[2]; /*!< @brief Deck atual e deck de entrada do crossfade */
+        unsigned _activeDeck;
         bool _audioInitialized;
 
-        std::atomic<bool> _shouldAdvanceToNext;
+        unsigned _crossfadeMs;
+        bool _replayGainEnabled;
+        bool _crossfadePending;
+        std::shared_ptr<const core::Song> _pendingSong;
+
+        std::atomic<ma_sound*> _endedSound; /*!< @brief Deck que terminou, anotado pela thread de áudio */
+
+        /**
+         * @brief Dados da faixa atual e da próxima usados no PlayerStatus
+         *
+         * Capturados quando a faixa ou a fila muda, na thread que controla
+         * o player; publishStatus() não aciona os loaders da música.
+         */
+        struct TrackInfo {
+            std::string artist;
+            std::string album;
+            std::string next_title;
+            std::string next_artist;
+        };
+        TrackInfo _trackInfo;
+
+        std::shared_ptr<const PlayerStatus> _status; /*!< @brief Lido e trocado só com std::atomic_load/store */
+
+        unsigned _resumeSongId;   /*!< @brief Música cuja próxima carga retoma de _resumePosition */
+        unsigned _resumePosition; /*!< @brief Segundos a pular ao carregar _resumeSongId */
+
+        std::shared_ptr<HistoryWriter> _historyWriter;
+        std::shared_ptr<const User> _historyUser;
+        std::time_t _playbackStartedAt; /*!< @brief Início da música atual; 0 se já registrada */
+
+        // relógio virtual (AudioBackend::NULL_DEVICE)
+        AudioBackend _backend;
+        std::atomic<double> _timeScale;
+        std::atomic<bool> _clockRunning;
+        std::thread _clockThread;
+        std::mutex _clockMutex;
+        std::vector<float> _clockBuffer;
 
         // ma_uint64 _songStartTime;
         // bool _hasSongStartTime;
@@ -67,16 +194,135 @@ namespace core {
          */
         bool loadCurrentSong();
 
+        /**
+         * @brief Carrega o arquivo de uma música em um deck ligado ao barramento de mixagem
+         * @param sound Deck que receberá o som
+         * @param song Música a ser carregada
+         * @return true se o arquivo foi carregado
+         */
+        bool loadSound(ma_sound* sound, const core::Song& song);
+
+        /**
+         * @brief Deck que está tocando a música atual
+         */
+        ma_sound* currentSound() const;
+
+        /**
+         * @brief Deck livre, usado para a próxima música durante o crossfade
+         */
+        ma_sound* standbySound() const;
+
+        /**
+         * @brief Taxa de amostragem do arquivo, em que o cursor do som é contado
+         *
+         * Enquanto a decodificação assíncrona não conhece o formato, usa a
+         * taxa do engine.
+         */
+        ma_uint32 soundSampleRate(ma_sound* sound) const;
+
+        /**
+         * @brief Para e libera um deck
+         */
+        void cleanupSound(ma_sound* sound);
+
         /**
          * @brief Limpa o som atual
          */
         void cleanupCurrentSound();
 
         /**
-         * @brief Analisa flag para chamar playNextSong()
+         * @brief Guarda a fila ativa no seu contexto, com o som parado mas carregado
+         *
+         * O som guardado fica sem callback de fim até voltar a ser o deck
+         * atual em switchQueue(). A thread de áudio nunca lê _decks, então
+         * trocar os decks aqui não exige trava.
+         */
+        void parkCurrentContext();
+
+        /**
+         * @brief Inicia o deck atual e agenda o crossfade para a próxima faixa
+         */
+        bool startCurrentSound();
+
+        /**
+         * @brief Fator de ganho da música, a partir do ReplayGain pré-calculado
+         */
+        float trackGain(const core::Song& song) const;
+
+        /**
+         * @brief Pré-carrega a próxima música no deck livre e agenda os fades
+         *
+         * A entrada da próxima faixa e a saída da atual são agendadas no relógio
+         * do engine, então a transição é feita pelo próprio grafo de áudio.
+         */
+        void scheduleCrossfade();
+
+        /**
+         * @brief Cancela um crossfade agendado e restaura o volume da faixa atual
+         */
+        void cancelCrossfade();
+
+        /**
+         * @brief Torna o deck de entrada o deck atual ao fim da faixa anterior
+         * @return true se havia um crossfade em andamento
+         */
+        bool promoteCrossfade();
+
+        /**
+         * @brief Captura artista, álbum e próxima música em _trackInfo
+         *
+         * Aciona os loaders preguiçosos da música e da fila; chamado na troca
+         * de faixa e quando a fila muda.
+         */
+        void captureTrackInfo();
+
+        /**
+         * @brief Monta um novo PlayerStatus e o publica atomicamente
+         *
+         * Usa só o estado do player e o _trackInfo já capturado.
+         */
+        void publishStatus();
+
+        /**
+         * @brief Marca o início da reprodução da música atual
+         */
+        void beginPlayback();
+
+        /**
+         * @brief Registra a música atual com o tempo ouvido até aqui
+         *
+         * Chamado ao fim da faixa ou antes de trocá-la; sem início
+         * pendente não faz nada.
+         */
+        void finishPlayback();
+
+        /**
+         * @brief Enfileira uma reprodução no histórico, sem bloquear
+         * @param song Música reproduzida
+         * @param sound Deck da música; o cursor dá os segundos ouvidos
+         * @param started_at Instante em que a música começou a tocar
+         */
+        void recordPlayback(const core::Song& song, ma_sound* sound, std::time_t started_at);
+
+        /**
+         * @brief Avança para a próxima música se o deck atual terminou
+         *
+         * Roda na thread que chamou; o callback de fim só anota o deck.
          */
         void checkAndAdvanceIfNeeded();
 
+        /**
+         * @brief Laço do relógio virtual: a cada tick puxa do engine os quadros
+         * equivalentes ao tempo real decorrido multiplicado pela escala
+         */
+        void runVirtualClock();
+
+        /**
+         * @brief Processa e descarta quadros do engine sem dispositivo
+         * @param frames Quantidade de quadros na taxa do engine
+         */
+        void pumpFrames(ma_uint64 frames);
+
     public:
         /**
          * @brief Construtor da classe Player
@@ -85,6 +331,13 @@ namespace core {
          */
         Player();
 
+        /**
+         * @brief Construtor com escolha da saída de áudio
+         * @param backend DEVICE usa o dispositivo padrão; NULL_DEVICE usa o relógio virtual
+         * @param time_scale Velocidade do relógio virtual (1.0 = tempo real, 0 = parado)
+         */
+        Player(AudioBackend backend, double time_scale = 1.0);
+
         /**
          * @brief Construtor da classe Player
          * Inicializa o player com estado playing e volume máximo.
@@ -98,8 +351,71 @@ namespace core {
          */
         ~Player();
 
+        /**
+         * @brief Último estado publicado do player
+         *
+         * Não toca no engine nem na fila: pode ser chamado de qualquer thread,
+         * com qualquer frequência. Para a posição atual use
+         * PlayerStatus::elapsedAt(getEngineTime()).
+         */
+        std::shared_ptr<const PlayerStatus> getStatus() const;
+
+        /**
+         * @brief Republica o estado depois de mudanças feitas direto na fila
+         */
+        void refreshStatus();
+
+        /**
+         * @brief Trata o fim da faixa, avançando a fila se preciso
+         *
+         * O fim é detectado na thread de áudio, mas a troca de faixa só
+         * acontece aqui: deve ser chamado periodicamente pela mesma thread
+         * que envia os comandos ao player.
+         */
+        void poll();
+
+        /**
+         * @brief Obtém a fila ativa
+         */
         std::shared_ptr<PlaybackQueue> getCurrentQueue() const;
 
+        /**
+         * @brief Cria uma fila nomeada vazia, sem ativá-la
+         * @param name Nome da fila
+         * @return Fila criada
+         * @throws std::invalid_argument se o nome for vazio ou já existir
+         */
+        std::shared_ptr<PlaybackQueue> createQueue(const std::string& name);
+
+        /**
+         * @brief Torna ativa outra fila nomeada
+         *
+         * A fila que sai guarda a música atual e o som parado no ponto em que
+         * estava; a que entra retoma o seu, sem recarregar o arquivo. Se o
+         * player estava tocando, continua tocando na nova fila.
+         *
+         * @param name Nome da fila
+         * @throws std::invalid_argument se a fila não existir
+         */
+        void switchQueue(const std::string& name);
+
+        /**
+         * @brief Remove uma fila nomeada e libera o som guardado nela
+         * @param name Nome da fila
+         * @throws std::invalid_argument se a fila não existir ou for a ativa
+         */
+        void dropQueue(const std::string& name);
+
+        /**
+         * @brief Nomes das filas, em ordem alfabética
+         */
+        std::vector<std::string> getQueueNames() const;
+
+        /**
+         * @brief Nome da fila ativa
+         */
+        const std::string& getCurrentQueueName() const;
+
         /**
          * @brief Adicionar uma Queue ao vector _queue
          *
@@ -159,6 +475,17 @@ namespace core {
          */
         void fastForward(unsigned int seconds);
 
+        /**
+         * @brief Define de onde uma música começa a tocar na próxima carga
+         *
+         * Usado para retomar a sessão anterior: vale apenas para a próxima
+         * carga e é descartado se ela for de outra música.
+         *
+         * @param song_id Música a que a posição pertence
+         * @param seconds Posição inicial em segundos
+         */
+        void setResumePosition(unsigned song_id, unsigned int seconds);
+
         /**
          * @brief Obtém tempo decorrido da música atual em segundos
          * @return Tempo decorrido em segundos
@@ -272,8 +599,8 @@ namespace core {
 
         /**
          * @brief Limpa toda a playlist
-         * Remove todas as músicas do index da queue ou todas queue, depende
-         * da implementação.
+         * Remove todas as músicas da fila ativa; as demais filas nomeadas
+         * não são alteradas.
          */
         void clearPlaylist();
 
@@ -292,5 +619,68 @@ namespace core {
         bool hasPrevious() const;
 
         ma_uint64 getEngineTime() const;
+
+        /**
+         * @brief Define a duração do crossfade entre faixas consecutivas
+         * @param milliseconds Duração em milissegundos, 0 desativa
+         */
+        void setCrossfade(unsigned milliseconds);
+
+        /**
+         * @brief Obtém a duração do crossfade
+         * @return Duração em milissegundos
+         */
+        unsigned getCrossfade() const;
+
+        /**
+         * @brief Habilita ou desabilita a normalização por ReplayGain
+         * @param enabled true para aplicar o ganho gravado de cada faixa
+         */
+        void setReplayGain(bool enabled);
+
+        /**
+         * @brief Verifica se a normalização por ReplayGain está habilitada
+         */
+        bool isReplayGainEnabled() const;
+
+        /**
+         * @brief Registra no histórico cada música tocada
+         *
+         * A reprodução é registrada quando a música termina ou é trocada,
+         * com os segundos efetivamente ouvidos. O registro só enfileira o
+         * evento; a gravação acontece na thread do HistoryWriter.
+         *
+         * @param writer Gravador do histórico (nullptr desativa)
+         * @param user Usuário a quem as reproduções são atribuídas
+         */
+        void setHistoryWriter(std::shared_ptr<HistoryWriter> writer,
+                              std::shared_ptr<const User> user);
+
+        /**
+         * @brief Saída de áudio em uso
+         */
+        AudioBackend getBackend() const;
+
+        /**
+         * @brief Define a velocidade do relógio virtual
+         * @param scale Multiplicador do tempo real (0 pausa o relógio)
+         * @throws std::logic_error se o backend não for NULL_DEVICE
+         */
+        void setTimeScale(double scale);
+
+        /**
+         * @brief Obtém a velocidade do relógio virtual
+         */
+        double getTimeScale() const;
+
+        /**
+         * @brief Avança o relógio virtual imediatamente, sem esperar o tempo real
+         *
+         * Permite testes determinísticos com o relógio parado (escala 0).
+         *
+         * @param milliseconds Tempo a avançar
+         * @throws std::logic_error se o backend não for NULL_DEVICE
+         */
+        void advanceTime(unsigned milliseconds);
     };
 } // namespace core
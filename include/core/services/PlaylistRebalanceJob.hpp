@@ -0,0 +1,86 @@
+/**
+ * @file PlaylistRebalanceJob.hpp
+ * @brief Redistribuição das chaves de posição das playlists
+ *
+ * Editar uma playlist grava só as linhas alteradas, com chaves entre as
+ * vizinhas; mover músicas sempre para o mesmo ponto deixa as chaves cada
+ * vez mais longas. Este job procura playlists com chaves acima do limite e
+ * as regrava com chaves curtas, uma playlist por transação, fora do
+ * caminho da edição. Roda em outra thread, então o repositório deve usar
+ * uma conexão própria (DatabaseManager::openConnection()).
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "core/bd/PlaylistRepository.hpp"
+
+namespace core {
+
+    /**
+     * @brief Resultado de uma redistribuição
+     */
+    struct RebalanceReport {
+        size_t playlists = 0;  /*!< @brief Playlists redistribuídas */
+        size_t rows = 0;       /*!< @brief Linhas de playlist_songs regravadas */
+    };
+
+    /**
+     * @class PlaylistRebalanceJob
+     * @brief Encurta as chaves de posição das playlists que passaram do limite
+     */
+    class PlaylistRebalanceJob {
+    private:
+        std::shared_ptr<PlaylistRepository> _repository;
+        size_t _max_length;
+
+        std::atomic<bool> _stop_requested;
+        std::atomic<bool> _running;
+        std::thread _thread;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param repository Repositório de playlists, com conexão só dele
+         * @param max_length Comprimento de chave a partir do qual a playlist é redistribuída
+         */
+        explicit PlaylistRebalanceJob(std::shared_ptr<PlaylistRepository> repository,
+                                      size_t max_length = PLAYLIST_ORDER_KEY_MAX_LENGTH_DEFAULT);
+
+        /**
+         * @brief Destrutor, interrompe e aguarda a execução em segundo plano
+         */
+        ~PlaylistRebalanceJob();
+
+        PlaylistRebalanceJob(const PlaylistRebalanceJob &) = delete;
+        PlaylistRebalanceJob &operator=(const PlaylistRebalanceJob &) = delete;
+
+        /**
+         * @brief Redistribui, na thread atual, as playlists acima do limite
+         * @return Estatísticas da execução
+         */
+        RebalanceReport run();
+
+        /**
+         * @brief Executa run() em uma thread separada
+         */
+        void start();
+
+        /**
+         * @brief Pede a interrupção e aguarda a playlist atual terminar
+         */
+        void stop();
+
+        /**
+         * @brief Verifica se a redistribuição está em execução
+         */
+        bool isRunning() const;
+    };
+}
@@ -0,0 +1,68 @@
+/**
+ * @file QueueSnapshot.hpp
+ * @brief Estado serializável da fila de reprodução
+ *
+ * Guarda só o necessário para reconstruir a fila sem consultar o banco: os
+ * IDs das músicas na ordem de inserção, a ordem já sorteada do modo
+ * aleatório (como índices nessa lista), a posição atual e os modos. As
+ * músicas são carregadas depois, sob demanda.
+ *
+ * O formato binário é compacto (inteiros em varint) e termina com um
+ * checksum FNV-1a, então arquivos truncados ou corrompidos são rejeitados
+ * em vez de restaurar uma fila incoerente.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    enum class ShuffleMode;  // definida em PlaybackQueue.hpp
+
+    /**
+     * @brief Fotografia da fila de reprodução
+     */
+    struct QueueSnapshot {
+        std::vector<unsigned> song_ids;  /*!< @brief Músicas na ordem de inserção */
+        std::vector<uint32_t> drawn;     /*!< @brief Ordem sorteada, como índices em song_ids */
+        uint64_t current = 0;            /*!< @brief Posição atual na ordem ativa */
+        uint64_t history = 0;            /*!< @brief Músicas tocadas antes do modo aleatório */
+        uint32_t position = 0;           /*!< @brief Segundos já tocados da música atual */
+        bool aleatory = false;
+        bool loop = false;
+        ShuffleMode shuffle_mode = static_cast<ShuffleMode>(0);
+
+        /**
+         * @brief Mantém só as músicas aceitas por keep, ajustando as posições
+         *
+         * A ordem sorteada, o histórico e a posição atual continuam
+         * apontando para as mesmas músicas; se a atual sair, passa a ser a
+         * seguinte.
+         *
+         * @param keep Predicado sobre o ID da música
+         */
+        void retain(const std::function<bool(unsigned)> &keep);
+
+        /**
+         * @brief Serializa no formato binário
+         */
+        std::string encode() const;
+
+        /**
+         * @brief Lê um snapshot serializado por encode()
+         * @param data Bytes do snapshot
+         * @return Snapshot lido
+         * @throws std::runtime_error se os dados estiverem corrompidos ou
+         * forem de outra versão
+         */
+        static QueueSnapshot decode(const std::string &data);
+    };
+}
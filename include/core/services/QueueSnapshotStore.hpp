@@ -0,0 +1,105 @@
+/**
+ * @file QueueSnapshotStore.hpp
+ * @brief Persistência da fila de reprodução entre sessões
+ *
+ * Grava o QueueSnapshot da fila em um arquivo e o lê de volta na próxima
+ * sessão. A gravação é atômica (arquivo temporário + rename), então uma
+ * interrupção no meio não deixa um snapshot pela metade. Durante a sessão
+ * saveIfChanged() só grava se a fila mudou desde o último snapshot e se já
+ * passou o intervalo mínimo, para que uma sequência de comandos não vire
+ * uma sequência de gravações. A mudança adiada continua pendente
+ * (isDirty()): chamar saveIfChanged() periodicamente a grava assim que o
+ * intervalo passa. Ao sair, save() grava o estado final.
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/bd/SongRepository.hpp"
+#include "core/services/PlaybackQueue.hpp"
+#include "core/services/QueueSnapshot.hpp"
+
+namespace core {
+
+    /**
+     * @class QueueSnapshotStore
+     * @brief Salva e restaura a fila de reprodução em um arquivo
+     */
+    class QueueSnapshotStore {
+    private:
+        std::string _path;
+        std::chrono::milliseconds _debounce;
+        uint64_t _saved_revision;
+        bool _has_saved;
+        std::chrono::steady_clock::time_point _last_save;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param path Arquivo do snapshot
+         * @param debounce Intervalo mínimo entre gravações de saveIfChanged()
+         */
+        explicit QueueSnapshotStore(std::string path,
+                                    std::chrono::milliseconds debounce = std::chrono::seconds(2));
+
+        /**
+         * @brief Grava o estado atual da fila
+         * @param queue Fila
+         * @param position Segundos já tocados da música atual
+         * @return true se o arquivo foi gravado
+         */
+        bool save(const PlaybackQueue& queue, uint32_t position = 0);
+
+        /**
+         * @brief Verifica se a fila mudou desde a última gravação
+         * @param queue Fila
+         */
+        bool isDirty(const PlaybackQueue& queue) const;
+
+        /**
+         * @brief Grava a fila se ela mudou e o intervalo mínimo já passou
+         *
+         * Uma mudança dentro do intervalo não é perdida: fica pendente até a
+         * próxima chamada depois dele.
+         *
+         * @param queue Fila
+         * @param position Segundos já tocados da música atual
+         * @return true se o arquivo foi gravado
+         */
+        bool saveIfChanged(const PlaybackQueue& queue, uint32_t position = 0);
+
+        /**
+         * @brief Lê o snapshot salvo
+         * @param snapshot Recebe o snapshot lido
+         * @return false se não houver arquivo ou se ele estiver corrompido
+         */
+        bool load(QueueSnapshot& snapshot) const;
+
+        /**
+         * @brief Restaura a fila salva
+         *
+         * Músicas que não existem mais no banco são descartadas com uma
+         * única consulta de IDs; as demais são carregadas sob demanda.
+         *
+         * @param queue Fila a ser substituída
+         * @param songs Repositório usado para carregar as músicas
+         * @param position Recebe os segundos já tocados da música atual
+         * @return true se havia uma fila salva e ela foi restaurada
+         */
+        bool restore(PlaybackQueue& queue, std::shared_ptr<SongRepository> songs,
+                     uint32_t& position);
+
+        /**
+         * @brief Caminho do arquivo do snapshot
+         */
+        const std::string& path() const;
+    };
+}
@@ -0,0 +1,48 @@
+/**
+ * @file Collation.hpp
+ * @brief Chaves de ordenação para textos da biblioteca
+ *
+ * Comparar títulos byte a byte põe "abc" depois de "Zeca" e "Água" depois
+ * de "Zeca". A chave de ordenação normaliza o texto uma única vez (caixa e
+ * acentos), e a partir daí comparar duas chaves é uma comparação de bytes
+ * comum. Os repositórios gravam a chave junto do título na importação e o
+ * banco registra a mesma regra como a collation FOLD.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-01
+ */
+
+#pragma once
+
+#include <string>
+
+#define COLLATION_NAME "FOLD"          /*!< @brief Nome da collation registrada no SQLite */
+#define COLLATION_FUNCTION_NAME "fold" /*!< @brief Nome da função SQL que gera a chave */
+
+namespace core {
+
+    /**
+     * @brief Gera a chave de ordenação de um texto
+     *
+     * Letras viram minúsculas e perdem os acentos nos blocos Latin-1 e
+     * Latin Extended-A ("Ação" e "acao" geram a mesma chave); ligaduras
+     * como "æ" e "ß" viram duas letras e marcas combinantes (texto
+     * decomposto) são descartadas. Os demais caracteres ficam como estão.
+     *
+     * @param text Texto em UTF-8
+     * @return Chave comparável byte a byte
+     */
+    std::string collationKey(const std::string &text);
+
+    /**
+     * @brief Limite superior de uma busca por prefixo
+     *
+     * Toda chave que começa com prefix fica em [prefix, collationPrefixEnd(prefix)),
+     * o que permite buscar pelo índice com >= e <.
+     *
+     * @param prefix Chave do prefixo (já normalizada)
+     * @return Limite exclusivo, ou vazio se não houver limite
+     */
+    std::string collationPrefixEnd(const std::string &prefix);
+}
@@ -2,7 +2,9 @@
  * @file Datetime.hpp
  * @brief Define um utilitário para representar datas
  *
- * Esta classe representa datas
+ * Esta classe representa datas como segundos desde 1970-01-01 UTC, em um
+ * único inteiro de 64 bits. O valor zero indica uma data não definida;
+ * construir uma Datetime não lê o relógio, só Datetime::now() faz isso.
  *
  * @author Pedro Gabriel
  * @date 2025-10-14
@@ -10,73 +12,93 @@
 
 #pragma once
 
-#include <iostream>
 #include <chrono>
-#include <ctime>
+#include <cstdint>
 #include <string>
-#include <iomanip>
-#include <sstream>
-#include <vector>
 
 namespace core {
     class Datetime {
         private:
-            
-            std::chrono::system_clock::time_point timePoint;
+
+            std::int64_t _seconds = 0;
 
         public:
 
         /**
-         * @brief Construtor padrão de Datetime com a data atual
+         * @brief Construtor padrão de Datetime, sem data definida
+         */
+        Datetime() = default;
+
+        /**
+         * @brief Construtor a partir de segundos desde a época
+         *
+         * @param seconds segundos desde 1970-01-01 UTC
          */
-        Datetime();
+        explicit Datetime(std::int64_t seconds);
 
         /**
          * @brief Construtor usando uma string
-         * 
-         * @param dateTimeStr data no formato DD-MM-YYYY
+         *
+         * Aceita DD-MM-YYYY e o formato do SQLite, YYYY-MM-DD com
+         * HH:MM:SS opcional. Textos em outro formato deixam a data sem
+         * definição.
+         *
+         * @param dateTimeStr data em um dos formatos acima, em UTC
          */
         Datetime(const std::string& datetimeStr);
 
         /**
-         * @brief Retorna o Objeto Time Point const
-         * 
+         * @brief Data e hora atuais
+         */
+        static Datetime now();
+
+        /**
+         * @brief Verifica se a data foi definida
          */
-        const std::chrono::system_clock::time_point& getTimePoint() const;
+        bool isSet() const;
 
         /**
-         * @brief Representação padrão de uma data
+         * @brief Retorna os segundos desde 1970-01-01 UTC
+         */
+        std::int64_t getSeconds() const;
+
+        /**
+         * @brief Retorna o Objeto Time Point
+         *
+         */
+        std::chrono::system_clock::time_point getTimePoint() const;
+
+        /**
+         * @brief Representação padrão de uma data, YYYY/MM/DD em UTC
          */
         const std::string toString() const;
 
         /**
          * @brief Sobrecarga do operador equals
-         * 
+         *
          * Considera apenas a data
          */
         bool operator==(const Datetime& other) const;
 
         /**
          * @brief Sobrecarga do operador not equals
-         * 
+         *
          * Considera apenas a data
          */
         bool operator!=(const Datetime& other) const;
 
         /**
          * @brief Verifica a cronologia de duas datas
-         * 
+         *
          * @return true se a data desse objeto é de antes do other e false caso seja de depois ou seja igual
          */
         bool isBefore(const Datetime& other) const;
 
         /**
          * @brief Verifica a cronologia de duas datas
-         * 
+         *
          * @return true se a data desse objeto é depois de other e false caso contrário
          */
         bool isAfter(const Datetime& other) const;
     };
 }
-
-#pragma once
\ No newline at end of file
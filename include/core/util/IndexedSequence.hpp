@@ -0,0 +1,179 @@
+/**
+ * @file IndexedSequence.hpp
+ * @brief Sequência com acesso posicional em O(log n)
+ *
+ * Treap implícita (árvore de estatística de ordem): a posição de cada
+ * elemento é dada pelo tamanho das subárvores, então inserir, remover,
+ * mover e acessar por índice custam O(log n) esperado. Os nós têm
+ * ponteiro para o pai, o que permite obter o índice atual de um elemento a
+ * partir do seu Handle, que continua válido enquanto o elemento estiver na
+ * sequência (inclusive depois de move()).
+ *
+ * Cada nó pode ser marcado; as subárvores contam seus nós marcados, o que
+ * permite localizar o k-ésimo elemento não marcado também em O(log n).
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-24
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace core {
+
+    /**
+     * @brief Sequência indexada baseada em treap implícita
+     * @tparam T Tipo dos elementos
+     */
+    template <typename T>
+    class IndexedSequence {
+    public:
+        /**
+         * @brief Nó da árvore; exposto apenas como Handle opaco
+         */
+        struct Node {
+            T value;
+            Node *left = nullptr;
+            Node *right = nullptr;
+            Node *parent = nullptr;
+            uint32_t priority = 0;
+            size_t size = 1;
+            size_t marked_count = 0; /*!< @brief Nós marcados na subárvore */
+            bool marked = false;
+
+            explicit Node(T v) : value(std::move(v)) {}
+        };
+
+        using Handle = Node *;
+
+    private:
+        Node *_root;
+        uint32_t _seed;
+
+        uint32_t nextPriority();
+
+        static size_t sizeOf(const Node *node);
+        static size_t markedOf(const Node *node);
+        static void update(Node *node);
+        static void destroy(Node *node);
+
+        /**
+         * @brief Divide a árvore: os primeiros count nós vão para left
+         */
+        static void split(Node *node, size_t count, Node *&left, Node *&right);
+        static Node *merge(Node *left, Node *right);
+
+        Node *detach(size_t index);
+        void attach(size_t index, Node *node);
+
+    public:
+        IndexedSequence();
+        ~IndexedSequence();
+
+        IndexedSequence(const IndexedSequence &) = delete;
+        IndexedSequence &operator=(const IndexedSequence &) = delete;
+
+        /**
+         * @brief Número de elementos
+         */
+        size_t size() const;
+
+        /**
+         * @brief Verifica se a sequência está vazia
+         */
+        bool empty() const;
+
+        /**
+         * @brief Insere um elemento na posição indicada
+         * @param index Posição (0..size(); valores maiores inserem no fim)
+         * @param value Elemento
+         * @return Handle do elemento inserido
+         */
+        Handle insert(size_t index, T value);
+
+        /**
+         * @brief Insere um elemento no fim
+         * @param value Elemento
+         * @return Handle do elemento inserido
+         */
+        Handle pushBack(T value);
+
+        /**
+         * @brief Remove o elemento na posição indicada
+         * @param index Posição do elemento (deve ser < size())
+         * @return Elemento removido
+         */
+        T erase(size_t index);
+
+        /**
+         * @brief Remove o elemento referenciado pelo Handle
+         * @param handle Handle obtido em insert()/pushBack()
+         * @return Elemento removido
+         */
+        T erase(Handle handle);
+
+        /**
+         * @brief Move um elemento para outra posição, preservando o Handle
+         * @param from Posição atual
+         * @param to Posição final
+         */
+        void move(size_t from, size_t to);
+
+        /**
+         * @brief Obtém o Handle do elemento na posição indicada
+         * @param index Posição
+         * @return Handle ou nullptr se a posição for inválida
+         */
+        Handle handleAt(size_t index) const;
+
+        /**
+         * @brief Obtém o elemento na posição indicada
+         * @param index Posição (deve ser < size())
+         */
+        const T &at(size_t index) const;
+
+        /**
+         * @brief Obtém a posição atual de um elemento
+         * @param handle Handle do elemento
+         * @return Índice do elemento
+         */
+        size_t indexOf(Handle handle) const;
+
+        /**
+         * @brief Marca ou desmarca um elemento
+         * @param handle Handle do elemento
+         * @param marked Nova marcação
+         */
+        void setMarked(Handle handle, bool marked);
+
+        /**
+         * @brief Número de elementos marcados
+         */
+        size_t markedCount() const;
+
+        /**
+         * @brief Obtém o k-ésimo elemento não marcado, na ordem da sequência
+         * @param index Posição entre os não marcados
+         * @return Handle ou nullptr se a posição for inválida
+         */
+        Handle unmarkedAt(size_t index) const;
+
+        /**
+         * @brief Remove todos os elementos
+         */
+        void clear();
+
+        /**
+         * @brief Percorre os elementos em ordem
+         * @param visit Função chamada com cada elemento
+         */
+        template <typename F>
+        void forEach(F visit) const;
+    };
+}
+
+#include "core/util/IndexedSequence.tpp"
@@ -0,0 +1,287 @@
+/**
+ * @file IndexedSequence.tpp
+ * @brief Implementação da sequência indexada
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-24
+ */
+
+#ifndef INDEXED_SEQUENCE_TPP
+#define INDEXED_SEQUENCE_TPP
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace core {
+
+    template <typename T>
+    IndexedSequence<T>::IndexedSequence() : _root(nullptr), _seed(0x9E3779B9u) {}
+
+    template <typename T>
+    IndexedSequence<T>::~IndexedSequence() {
+        clear();
+    }
+
+    template <typename T>
+    uint32_t IndexedSequence<T>::nextPriority() {
+        // xorshift32: as prioridades só precisam ser bem espalhadas
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+        return _seed;
+    }
+
+    template <typename T>
+    size_t IndexedSequence<T>::sizeOf(const Node *node) {
+        return node ? node->size : 0;
+    }
+
+    template <typename T>
+    size_t IndexedSequence<T>::markedOf(const Node *node) {
+        return node ? node->marked_count : 0;
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::update(Node *node) {
+        node->size = 1 + sizeOf(node->left) + sizeOf(node->right);
+        node->marked_count = (node->marked ? 1 : 0) + markedOf(node->left)
+                             + markedOf(node->right);
+        if (node->left)
+            node->left->parent = node;
+        if (node->right)
+            node->right->parent = node;
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::destroy(Node *node) {
+        // iterativo para não estourar a pilha em árvores degeneradas
+        std::vector<Node *> pending;
+        if (node)
+            pending.push_back(node);
+
+        while (!pending.empty()) {
+            Node *current = pending.back();
+            pending.pop_back();
+            if (current->left)
+                pending.push_back(current->left);
+            if (current->right)
+                pending.push_back(current->right);
+            delete current;
+        }
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::split(Node *node, size_t count, Node *&left, Node *&right) {
+        if (!node) {
+            left = right = nullptr;
+            return;
+        }
+
+        if (sizeOf(node->left) < count) {
+            split(node->right, count - sizeOf(node->left) - 1, node->right, right);
+            left = node;
+        } else {
+            split(node->left, count, left, node->left);
+            right = node;
+        }
+
+        update(node);
+        if (left)
+            left->parent = nullptr;
+        if (right)
+            right->parent = nullptr;
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Node *IndexedSequence<T>::merge(Node *left, Node *right) {
+        if (!left)
+            return right;
+        if (!right)
+            return left;
+
+        if (left->priority > right->priority) {
+            left->right = merge(left->right, right);
+            update(left);
+            return left;
+        }
+
+        right->left = merge(left, right->left);
+        update(right);
+        return right;
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Node *IndexedSequence<T>::detach(size_t index) {
+        if (index >= size())
+            throw std::out_of_range("Índice fora da sequência");
+
+        Node *left, *middle, *right;
+        split(_root, index, left, right);
+        split(right, 1, middle, right);
+
+        _root = merge(left, right);
+        if (_root)
+            _root->parent = nullptr;
+
+        return middle;
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::attach(size_t index, Node *node) {
+        Node *left, *right;
+        split(_root, index, left, right);
+
+        _root = merge(merge(left, node), right);
+        _root->parent = nullptr;
+    }
+
+    template <typename T>
+    size_t IndexedSequence<T>::size() const {
+        return sizeOf(_root);
+    }
+
+    template <typename T>
+    bool IndexedSequence<T>::empty() const {
+        return _root == nullptr;
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Handle IndexedSequence<T>::insert(size_t index, T value) {
+        Node *node = new Node(std::move(value));
+        node->priority = nextPriority();
+
+        attach(index > size() ? size() : index, node);
+        return node;
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Handle IndexedSequence<T>::pushBack(T value) {
+        return insert(size(), std::move(value));
+    }
+
+    template <typename T>
+    T IndexedSequence<T>::erase(size_t index) {
+        Node *node = detach(index);
+        T value = std::move(node->value);
+        delete node;
+        return value;
+    }
+
+    template <typename T>
+    T IndexedSequence<T>::erase(Handle handle) {
+        return erase(indexOf(handle));
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::move(size_t from, size_t to) {
+        if (from >= size() || to >= size())
+            throw std::out_of_range("Índice fora da sequência");
+        if (from == to)
+            return;
+
+        Node *node = detach(from);
+        node->left = node->right = nullptr;
+        update(node);
+        attach(to, node);
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Handle IndexedSequence<T>::handleAt(size_t index) const {
+        Node *node = _root;
+        while (node) {
+            size_t leftSize = sizeOf(node->left);
+            if (index < leftSize) {
+                node = node->left;
+            } else if (index == leftSize) {
+                return node;
+            } else {
+                index -= leftSize + 1;
+                node = node->right;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    const T &IndexedSequence<T>::at(size_t index) const {
+        Handle node = handleAt(index);
+        if (!node)
+            throw std::out_of_range("Índice fora da sequência");
+        return node->value;
+    }
+
+    template <typename T>
+    size_t IndexedSequence<T>::indexOf(Handle handle) const {
+        size_t index = sizeOf(handle->left);
+        for (const Node *node = handle; node->parent; node = node->parent) {
+            if (node == node->parent->right)
+                index += sizeOf(node->parent->left) + 1;
+        }
+        return index;
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::setMarked(Handle handle, bool marked) {
+        if (handle->marked == marked)
+            return;
+
+        handle->marked = marked;
+        for (Node *node = handle; node; node = node->parent)
+            node->marked_count = (node->marked ? 1 : 0) + markedOf(node->left)
+                                 + markedOf(node->right);
+    }
+
+    template <typename T>
+    size_t IndexedSequence<T>::markedCount() const {
+        return markedOf(_root);
+    }
+
+    template <typename T>
+    typename IndexedSequence<T>::Handle IndexedSequence<T>::unmarkedAt(size_t index) const {
+        Node *node = _root;
+        while (node) {
+            size_t leftUnmarked = sizeOf(node->left) - markedOf(node->left);
+            if (index < leftUnmarked) {
+                node = node->left;
+                continue;
+            }
+
+            index -= leftUnmarked;
+            if (!node->marked) {
+                if (index == 0)
+                    return node;
+                --index;
+            }
+            node = node->right;
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    void IndexedSequence<T>::clear() {
+        destroy(_root);
+        _root = nullptr;
+    }
+
+    template <typename T>
+    template <typename F>
+    void IndexedSequence<T>::forEach(F visit) const {
+        std::vector<const Node *> stack;
+        const Node *node = _root;
+
+        while (node || !stack.empty()) {
+            while (node) {
+                stack.push_back(node);
+                node = node->left;
+            }
+            node = stack.back();
+            stack.pop_back();
+            visit(node->value);
+            node = node->right;
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file LoudnessMeter.hpp
+ * @brief Medidor de loudness EBU R128 / ITU-R BS.1770
+ *
+ * Calcula a loudness integrada (LUFS) com filtro K, blocos de 400 ms com
+ * sobreposição de 75% e gating absoluto/relativo, além do true peak por
+ * sobreamostragem 4x. As partes que percorrem blocos de amostras usam os
+ * kernels de SimdKernels.hpp.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Ganho de referência do ReplayGain 2.0 em LUFS
+     */
+    inline constexpr double REPLAY_GAIN_REFERENCE_LUFS = -18.0;
+
+    /**
+     * @class LoudnessMeter
+     * @brief Acumula amostras intercaladas e calcula loudness integrada e true peak
+     */
+    class LoudnessMeter {
+    private:
+        struct Biquad {
+            double b0, b1, b2, a1, a2;
+        };
+
+        struct ChannelState {
+            double z1[2] = {0.0, 0.0};  /*!< @brief Estado dos dois estágios do filtro K */
+            double z2[2] = {0.0, 0.0};
+            std::vector<float> history; /*!< @brief Últimas amostras para o filtro de sobreamostragem */
+            float weight = 1.0f;
+        };
+
+        unsigned _sample_rate;
+        unsigned _channels;
+        Biquad _stages[2];
+        std::vector<ChannelState> _state;
+
+        size_t _subblock_frames;           /*!< @brief Quadros em 100 ms */
+        size_t _subblock_filled;
+        double _subblock_energy;
+        std::vector<double> _recent_subblocks; /*!< @brief Últimos 4 sub-blocos (um bloco de 400 ms) */
+        std::vector<double> _block_energies;
+
+        std::vector<std::vector<float>> _phases; /*!< @brief Coeficientes polifásicos do true peak */
+        float _true_peak;
+
+        std::vector<float> _channel_buffer;
+        std::vector<float> _filtered_buffer;
+        std::vector<float> _oversampled_buffer;
+
+        void processChannel(unsigned channel, const float *interleaved, size_t frames);
+        void updateTruePeak(ChannelState &state, const float *samples, size_t frames);
+        void closeSubblock();
+
+    public:
+        /**
+         * @brief Construtor
+         * @param sample_rate Taxa de amostragem em Hz
+         * @param channels Número de canais das amostras intercaladas
+         */
+        LoudnessMeter(unsigned sample_rate, unsigned channels);
+
+        /**
+         * @brief Adiciona quadros de áudio
+         * @param interleaved Amostras float intercaladas por canal
+         * @param frames Quantidade de quadros
+         */
+        void addFrames(const float *interleaved, size_t frames);
+
+        /**
+         * @brief Loudness integrada com gating
+         * @return Loudness em LUFS, ou -70 se não houver blocos acima do gate absoluto
+         */
+        double integratedLoudness() const;
+
+        /**
+         * @brief Maior pico verdadeiro entre os canais
+         * @return Pico linear (1.0 = 0 dBTP)
+         */
+        float truePeak() const;
+
+        /**
+         * @brief Ganho ReplayGain 2.0 correspondente à loudness medida
+         * @return Ganho em dB relativo a -18 LUFS
+         */
+        double replayGain() const;
+
+        /**
+         * @brief Reinicia o medidor para uma nova faixa
+         */
+        void reset();
+    };
+}
@@ -0,0 +1,58 @@
+/**
+ * @file OrderKey.hpp
+ * @brief Chaves de posição fracionárias para listas ordenadas
+ *
+ * Uma chave é a parte fracionária de um número em base 26, escrita com as
+ * letras 'a' (zero) a 'z'. Como as chaves nunca terminam em 'a', comparar
+ * duas delas como texto é o mesmo que comparar os números, e entre
+ * quaisquer duas chaves sempre existe uma terceira. Inserir ou mover um
+ * item grava só a chave dele; as chaves crescem com o uso e podem ser
+ * redistribuídas de tempos em tempos.
+ *
+ * Só letras: nem o SQLite em uma coluna INTEGER converte a chave em número.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Verifica se um texto é uma chave de posição válida
+     * @param key Texto a verificar
+     * @return true se não for vazio, só tiver letras de 'a' a 'z' e não terminar em 'a'
+     */
+    bool isOrderKey(const std::string &key);
+
+    /**
+     * @brief Gera uma chave entre duas outras
+     * @param before Chave anterior (vazia = início da lista)
+     * @param after Chave seguinte (vazia = fim da lista)
+     * @return Chave k com before < k < after
+     * @throws std::invalid_argument se before não for menor que after
+     */
+    std::string orderKeyBetween(const std::string &before, const std::string &after);
+
+    /**
+     * @brief Gera várias chaves crescentes entre duas outras
+     *
+     * As chaves são espalhadas por bisseção, então o comprimento cresce com
+     * o logaritmo de count. Com before e after vazios, serve para
+     * redistribuir uma lista inteira.
+     *
+     * @param before Chave anterior (vazia = início da lista)
+     * @param after Chave seguinte (vazia = fim da lista)
+     * @param count Número de chaves
+     * @return Chaves em ordem crescente
+     * @throws std::invalid_argument se before não for menor que after
+     */
+    std::vector<std::string> orderKeysBetween(const std::string &before,
+                                              const std::string &after, size_t count);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file RingBuffer.hpp
+ * @brief Fila circular limitada e sem locks
+ *
+ * Fila de capacidade fixa para vários produtores e consumidores, no estilo
+ * da fila limitada de Dmitry Vyukov: cada célula guarda um número de
+ * sequência que diz se ela está livre para escrita ou pronta para leitura,
+ * então empilhar e desempilhar são um compare-and-swap no índice, sem
+ * mutex. Quando cheia, tryPush falha em vez de esperar.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace core {
+
+    /**
+     * @brief Fila circular limitada e sem locks
+     * @tparam T Tipo dos elementos (construtível por padrão e copiável)
+     */
+    template <typename T>
+    class RingBuffer {
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            T value;
+        };
+
+        std::unique_ptr<Cell[]> _cells;
+        size_t _mask;
+
+        // em linhas de cache separadas: produtores e consumidor não disputam
+        alignas(64) std::atomic<size_t> _enqueue_pos;
+        alignas(64) std::atomic<size_t> _dequeue_pos;
+
+    public:
+        /**
+         * @brief Construtor
+         * @param capacity Capacidade mínima (arredondada para potência de 2)
+         */
+        explicit RingBuffer(size_t capacity);
+
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer &operator=(const RingBuffer &) = delete;
+
+        /**
+         * @brief Tenta adicionar um elemento
+         * @param value Elemento
+         * @return false se a fila estiver cheia
+         */
+        bool tryPush(const T &value);
+
+        /**
+         * @brief Tenta retirar o elemento mais antigo
+         * @param value Recebe o elemento retirado
+         * @return false se a fila estiver vazia
+         */
+        bool tryPop(T &value);
+
+        /**
+         * @brief Capacidade da fila
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Número aproximado de elementos (exato sem concorrência)
+         */
+        size_t sizeApprox() const;
+    };
+}
+
+#include "core/util/RingBuffer.tpp"
@@ -0,0 +1,95 @@
+/**
+ * @file RingBuffer.tpp
+ * @brief Implementação da fila circular sem locks
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#ifndef RING_BUFFER_TPP
+#define RING_BUFFER_TPP
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace core {
+
+    template <typename T>
+    RingBuffer<T>::RingBuffer(size_t capacity)
+        : _mask(0), _enqueue_pos(0), _dequeue_pos(0) {
+        if (capacity == 0)
+            throw std::invalid_argument("Capacidade da fila deve ser positiva");
+
+        size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+
+        _cells.reset(new Cell[size]);
+        _mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    bool RingBuffer<T>::tryPush(const T &value) {
+        size_t position = _enqueue_pos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Cell &cell = _cells[position & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (diff == 0) {
+                if (_enqueue_pos.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // cheia: a célula ainda não foi lida
+            } else {
+                position = _enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T>
+    bool RingBuffer<T>::tryPop(T &value) {
+        size_t position = _dequeue_pos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Cell &cell = _cells[position & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+            if (diff == 0) {
+                if (_dequeue_pos.compare_exchange_weak(position, position + 1,
+                                                       std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // vazia
+            } else {
+                position = _dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <typename T>
+    size_t RingBuffer<T>::capacity() const {
+        return _mask + 1;
+    }
+
+    template <typename T>
+    size_t RingBuffer<T>::sizeApprox() const {
+        size_t enqueued = _enqueue_pos.load(std::memory_order_relaxed);
+        size_t dequeued = _dequeue_pos.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+}
+
+#endif
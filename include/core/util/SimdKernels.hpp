@@ -0,0 +1,62 @@
+/**
+ * @file SimdKernels.hpp
+ * @brief Kernels vetorizados usados na análise de áudio
+ *
+ * Operações sobre blocos contíguos de amostras float. A versão SSE2 é usada
+ * em qualquer x86-64; a versão AVX quando o código é compilado com suporte
+ * (ex.: -mavx ou FRANKENSTEIN_NATIVE_SIMD). Nos demais alvos cai na versão
+ * escalar, que também fica exposta para comparação em testes e benchmarks.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#pragma once
+
+#include <cstddef>
+
+namespace core {
+    namespace simd {
+
+        /**
+         * @brief Soma dos quadrados das amostras
+         * @param data Amostras
+         * @param count Quantidade de amostras
+         * @return Soma de data[i]^2 (acumulada em double por bloco)
+         */
+        double sumOfSquares(const float *data, size_t count);
+
+        /**
+         * @brief Maior valor absoluto entre as amostras
+         * @param data Amostras
+         * @param count Quantidade de amostras
+         * @return max |data[i]|, 0 se count == 0
+         */
+        float maxAbs(const float *data, size_t count);
+
+        /**
+         * @brief Multiplica e acumula: out[i] += gain * in[i]
+         * @param gain Fator multiplicador
+         * @param in Amostras de entrada
+         * @param out Acumulador
+         * @param count Quantidade de amostras
+         */
+        void multiplyAdd(float gain, const float *in, float *out, size_t count);
+
+        /**
+         * @brief Nome do conjunto de instruções selecionado na compilação
+         * @return "AVX", "SSE2" ou "scalar"
+         */
+        const char *instructionSet();
+
+        /**
+         * @brief Implementações de referência, sem intrínsecos
+         */
+        namespace scalar {
+            double sumOfSquares(const float *data, size_t count);
+            float maxAbs(const float *data, size_t count);
+            void multiplyAdd(float gain, const float *in, float *out, size_t count);
+        }
+    }
+}
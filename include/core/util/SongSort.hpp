@@ -0,0 +1,125 @@
+/**
+ * @file SongSort.hpp
+ * @brief Ordenação de listas de músicas por chaves pré-calculadas
+ *
+ * Ordenar com Song::operator< paga um dynamic_cast por comparação e lê
+ * campos espalhados pelos objetos. Aqui cada música vira uma chave compacta
+ * (artista e álbum empacotados, faixa, ano e chave de ordenação do título),
+ * calculada uma única vez; a ordenação roda só sobre as chaves, sem banco
+ * nem relações, e listas grandes são divididas entre threads.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-01
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/entities/EntitiesFWD.hpp"
+
+#define SONG_SORT_PARALLEL_MIN_DEFAULT 50000 /*!< @brief Tamanho a partir do qual a ordenação usa threads */
+
+namespace core {
+
+    /**
+     * @brief Critérios de ordenação de músicas
+     */
+    enum class SongOrder {
+        TITLE,              /*!< @brief Título, depois artista/álbum/faixa */
+        ARTIST_ALBUM_TRACK, /*!< @brief Artista, álbum e número da faixa */
+        YEAR                /*!< @brief Ano, depois artista/álbum/faixa */
+    };
+
+    /**
+     * @brief Chave de ordenação de uma música
+     */
+    struct SongSortKey {
+        uint64_t group = 0;   /*!< @brief ID do artista nos 32 bits altos, do álbum nos baixos */
+        uint32_t track = 0;   /*!< @brief Número da faixa */
+        int32_t year = 0;     /*!< @brief Ano de lançamento */
+        uint32_t index = 0;   /*!< @brief Posição da música na lista original */
+        std::string title;    /*!< @brief Chave de ordenação do título */
+
+        /**
+         * @brief Monta a chave de uma música, sem carregar relações
+         * @param song Música
+         * @param index Posição da música na lista
+         */
+        static SongSortKey of(const Song &song, uint32_t index);
+    };
+
+    /**
+     * @brief Ordem por título
+     */
+    struct SongTitleLess {
+        bool operator()(const SongSortKey &a, const SongSortKey &b) const {
+            if (a.title != b.title)
+                return a.title < b.title;
+            if (a.group != b.group)
+                return a.group < b.group;
+            if (a.track != b.track)
+                return a.track < b.track;
+            return a.index < b.index;
+        }
+    };
+
+    /**
+     * @brief Ordem por artista, álbum e faixa
+     */
+    struct SongArtistAlbumTrackLess {
+        bool operator()(const SongSortKey &a, const SongSortKey &b) const {
+            if (a.group != b.group)
+                return a.group < b.group;
+            if (a.track != b.track)
+                return a.track < b.track;
+            if (a.title != b.title)
+                return a.title < b.title;
+            return a.index < b.index;
+        }
+    };
+
+    /**
+     * @brief Ordem por ano
+     */
+    struct SongYearLess {
+        bool operator()(const SongSortKey &a, const SongSortKey &b) const {
+            if (a.year != b.year)
+                return a.year < b.year;
+            return SongArtistAlbumTrackLess()(a, b);
+        }
+    };
+
+    /**
+     * @brief Calcula as chaves de uma lista de músicas
+     * @param songs Músicas (nulas são ignoradas)
+     * @return Uma chave por música não nula, com index apontando para songs
+     */
+    std::vector<SongSortKey> makeSortKeys(const std::vector<std::shared_ptr<Song>> &songs);
+
+    /**
+     * @brief Ordena chaves de música
+     *
+     * As ordens são totais (o índice desempata), então o resultado é o
+     * mesmo com ou sem threads.
+     *
+     * @param keys Chaves a ordenar
+     * @param order Critério
+     * @param workers Número de threads (0 = núcleos disponíveis; listas
+     * menores que SONG_SORT_PARALLEL_MIN_DEFAULT usam uma só)
+     */
+    void sortKeys(std::vector<SongSortKey> &keys, SongOrder order, unsigned workers = 0);
+
+    /**
+     * @brief Ordena uma lista de músicas
+     * @param songs Músicas a ordenar (nulas vão para o fim)
+     * @param order Critério
+     * @param workers Número de threads (ver sortKeys)
+     */
+    void sortSongs(std::vector<std::shared_ptr<Song>> &songs, SongOrder order, unsigned workers = 0);
+}
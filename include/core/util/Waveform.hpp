@@ -0,0 +1,100 @@
+/**
+ * @file Waveform.hpp
+ * @brief Resumo de forma de onda (picos/RMS) de uma música
+ *
+ * O resumo é calculado uma única vez, na mesma decodificação da análise de
+ * loudness, e guardado em 8 bits por bucket. Interfaces que desenham a
+ * forma de onda ou permitem navegar pela faixa usam o resumo sem decodificar
+ * o áudio de novo.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-22
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Quantidade padrão de buckets de um resumo
+     */
+    inline constexpr size_t WAVEFORM_BUCKETS = 1000;
+
+    /**
+     * @brief Resumo compacto da forma de onda
+     *
+     * Cada bucket guarda o pico e o RMS do trecho correspondente, com
+     * 0..255 representando 0..1 (0 dBFS).
+     */
+    struct WaveformSummary {
+        unsigned song_id = 0;
+        std::vector<uint8_t> peaks;
+        std::vector<uint8_t> rms;
+
+        /**
+         * @brief Número de buckets do resumo
+         */
+        size_t buckets() const;
+
+        /**
+         * @brief Verifica se o resumo não tem dados (ex.: arquivo ilegível)
+         */
+        bool empty() const;
+
+        /**
+         * @brief Reduz os picos para a largura de exibição
+         * @param columns Número de colunas desejado
+         * @return Picos entre 0.0 e 1.0, um por coluna
+         */
+        std::vector<float> resample(size_t columns) const;
+    };
+
+    /**
+     * @class WaveformBuilder
+     * @brief Acumula amostras intercaladas e gera o WaveformSummary
+     *
+     * O tamanho total da faixa não precisa ser conhecido: as amostras são
+     * agrupadas em janelas de 10 ms e redistribuídas nos buckets no final.
+     */
+    class WaveformBuilder {
+    private:
+        unsigned _channels;
+        size_t _window_frames;
+
+        std::vector<float> _window_peaks;
+        std::vector<double> _window_energy;
+
+        float _current_peak;
+        double _current_energy;
+        size_t _current_frames;
+
+        void closeWindow();
+
+    public:
+        /**
+         * @brief Construtor
+         * @param sample_rate Taxa de amostragem em Hz
+         * @param channels Número de canais das amostras intercaladas
+         */
+        WaveformBuilder(unsigned sample_rate, unsigned channels);
+
+        /**
+         * @brief Adiciona quadros de áudio
+         * @param interleaved Amostras float intercaladas por canal
+         * @param frames Quantidade de quadros
+         */
+        void addFrames(const float *interleaved, size_t frames);
+
+        /**
+         * @brief Gera o resumo
+         * @param buckets Número de buckets (limitado ao número de janelas de 10 ms)
+         * @return Resumo quantizado em 8 bits
+         */
+        WaveformSummary build(size_t buckets = WAVEFORM_BUCKETS) const;
+    };
+}
@@ -0,0 +1,77 @@
+/**
+ * @file WeightedSampler.hpp
+ * @brief Sorteio ponderado com pesos alteráveis
+ *
+ * Árvore de Fenwick sobre os pesos: sortear, alterar um peso e adicionar
+ * uma posição custam O(log n). Usado pelo embaralhamento inteligente da
+ * fila, em que o peso de uma música vai a zero quando ela é sorteada.
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-25
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace core {
+
+    /**
+     * @brief Sorteio proporcional ao peso de cada posição
+     */
+    class WeightedSampler {
+    private:
+        std::vector<double> _weights; /*!< @brief Peso de cada posição */
+        std::vector<double> _tree;    /*!< @brief Somas parciais (base 1) */
+
+        void addToTree(size_t slot, double delta);
+        void rebuild();
+
+    public:
+        WeightedSampler() = default;
+
+        /**
+         * @brief Número de posições
+         */
+        size_t size() const;
+
+        /**
+         * @brief Adiciona uma posição no fim
+         * @param weight Peso (negativos contam como zero)
+         * @return Índice da nova posição
+         */
+        size_t add(double weight);
+
+        /**
+         * @brief Altera o peso de uma posição
+         * @param slot Índice da posição
+         * @param weight Novo peso (negativos contam como zero)
+         */
+        void set(size_t slot, double weight);
+
+        /**
+         * @brief Obtém o peso de uma posição
+         */
+        double weight(size_t slot) const;
+
+        /**
+         * @brief Soma de todos os pesos
+         */
+        double total() const;
+
+        /**
+         * @brief Sorteia uma posição
+         * @param unit Valor uniforme em [0, 1)
+         * @return Posição sorteada, com probabilidade peso / total
+         * @throws std::logic_error se todos os pesos forem zero
+         */
+        size_t sample(double unit) const;
+
+        /**
+         * @brief Remove todas as posições
+         */
+        void clear();
+    };
+}
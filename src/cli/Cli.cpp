@@ -9,12 +9,29 @@
  */
 
 #include "cli/Cli.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include "core/bd/DatabaseManager.hpp"
 
 namespace cli {
+    namespace {
+        // linhas do terminal, lidas fora da thread que controla o player
+        struct InputLines {
+            std::mutex mutex;
+            std::condition_variable ready;
+            std::deque<std::string> lines;
+            bool closed = false;
+        };
+    }
+
     std::string trimSpaces(const std::string& str) {
         size_t firstNonSpace = str.find_first_not_of(" \t\n\r\f\v");
 
@@ -72,11 +89,51 @@ namespace cli {
         // std::string input_path;
         // std::string uid;
 
-        _player = std::make_shared<core::Player>();
+        std::string backend = config_manager.audioBackend();
+        if (backend == "null") {
+            _player = std::make_shared<core::Player>(
+                core::AudioBackend::NULL_DEVICE, config_manager.timeScale());
+        } else {
+            try {
+                _player = std::make_shared<core::Player>();
+            } catch (const std::exception& e) {
+                if (backend != "auto")
+                    throw;
+
+                std::cerr << "Sem dispositivo de áudio (" << e.what()
+                          << "), usando relógio virtual." << std::endl;
+                _player = std::make_shared<core::Player>(
+                    core::AudioBackend::NULL_DEVICE,
+                    config_manager.timeScale());
+            }
+        }
+        _player->setCrossfade(config_manager.crossfadeMilliseconds());
+        _player->setReplayGain(config_manager.replayGainEnabled());
 
         _db = _db_manager.getDatabase();
         _library = std::make_shared<core::Library>(_user, _db);
 
+        // a thread do writer abre as próprias transações: conexão própria
+        _historyWriter = std::make_shared<core::HistoryWriter>(
+            std::make_shared<core::HistoryPlaybackRepository>(
+                _db_manager.openConnection()));
+        _player->setHistoryWriter(_historyWriter, _user);
+
+        // a primeira compactação pode reescrever o arquivo (VACUUM): fora da inicialização
+        _compactionJob = std::make_shared<core::HistoryCompactionJob>(
+            _db_manager.openConnection(), config_manager.historyRetentionDays());
+        _compactionJob->start();
+
+        // como o writer, a redistribuição abre transações fora da thread principal
+        _rebalanceJob = std::make_shared<core::PlaylistRebalanceJob>(
+            std::make_shared<core::PlaylistRepository>(
+                _db_manager.openConnection()));
+        _rebalanceJob->start();
+
+        _queueStore = std::make_shared<core::QueueSnapshotStore>(
+            config_manager.queueSnapshotPath());
+        restoreQueue();
+
         try {
             std::ifstream helpFile("../resources/help.json");
             helpFile >> _helpData;
@@ -186,6 +243,15 @@ namespace cli {
         }
     }
 
+    void Cli::setCrossfade(unsigned int seconds) {
+        _player->setCrossfade(seconds * 1000);
+        if (seconds == 0)
+            std::cout << "Crossfade desativado." << std::endl;
+        else
+            std::cout << "Crossfade de " << seconds << "s entre as faixas."
+                      << std::endl;
+    }
+
     void Cli::addToQueue(core::IPlayable& playabel) {
         std::cout << "queue adicionar 6" << std::endl;
         try {
@@ -246,8 +312,17 @@ namespace cli {
         }
     }
 
-    void Cli::shuffle() {
-        _player->getPlaybackQueue()->shuffle();
+    void Cli::shuffle(const std::string& mode) {
+        auto queue = _player->getPlaybackQueue();
+        if (mode == "smart")
+            queue->setShuffleMode(core::ShuffleMode::SMART);
+        else if (mode == "normal")
+            queue->setShuffleMode(core::ShuffleMode::UNIFORM);
+
+        queue->shuffle();
+        std::cout << "Modo aleatório "
+                  << (queue->getShuffleMode() == core::ShuffleMode::SMART ? "inteligente" : "normal")
+                  << " ativado." << std::endl;
     }
 
     void Cli::removeFromQueue(unsigned idx) {
@@ -256,100 +331,79 @@ namespace cli {
 
     void Cli::showStatus() const {
         try {
+            // lê o último estado publicado; não aciona o engine nem a fila
+            auto status = _player->getStatus();
+            if (!status) {
+                std::cout << "Player ainda não publicou seu estado." << std::endl;
+                return;
+            }
+
+            auto formatTime = [](unsigned totalSeconds) {
+                unsigned h = totalSeconds / 3600;
+                unsigned m = (totalSeconds % 3600) / 60;
+                unsigned s = totalSeconds % 60;
+
+                std::string formatted;
+                if (h > 0) {
+                    formatted = std::to_string(h) + ":" + (m < 10 ? "0" : "");
+                }
+                formatted += std::to_string(m) + ":" + (s < 10 ? "0" : "")
+                             + std::to_string(s);
+                return formatted;
+            };
+
             std::cout << "=== Player Status ===" << std::endl;
 
             std::string state;
-            if (_player->isPlaying())
+            if (status->state == core::PlayerState::PLAYING)
                 state = "Playing";
-            else if (_player->isPaused())
+            else if (status->state == core::PlayerState::PAUSED)
                 state = "Paused";
             else
                 state = "Stopped";
 
             std::cout << "Estado: " << state << std::endl;
 
-            float vol = _player->getVolume() * 100.0f;
+            float vol = status->volume * 100.0f;
             std::cout << "Volume: " << static_cast<unsigned int>(vol) << "%";
-            if (_player->isMuted())
+            if (status->muted)
                 std::cout << " (muted)";
             std::cout << std::endl;
 
-            std::cout << "Loop: " << (_player->isLooping() ? "on" : "off")
+            std::cout << "Loop: " << (status->looping ? "on" : "off")
                       << std::endl;
 
-            std::shared_ptr<core::PlaybackQueue> queue;
-
-            queue = _player->getPlaybackQueue();
-
-            if (queue) {
-                std::cout << "Tamanho da fila: " << queue->size() << std::endl;
-
-                auto curr = queue->getCurrentSong();
-                if (curr) {
-                    std::cout << "Musica atual: " << curr->getTitle();
-                    if (curr->getArtist())
-                        std::cout << " - " << curr->getArtist()->getName();
-                    std::cout << std::endl;
+            std::cout << "Fila: " << status->queue_name << " ("
+                      << status->queue_size << " músicas)" << std::endl;
 
-                    unsigned int elapsed = 0;
-                    float progress = 0.0f;
+            if (status->has_song) {
+                std::cout << "Musica atual: " << status->title;
+                if (!status->artist.empty())
+                    std::cout << " - " << status->artist;
+                std::cout << std::endl;
 
-                    elapsed = _player->getElapsedTime();
+                uint64_t now = _player->getEngineTime();
+                unsigned int elapsed = status->elapsedAt(now);
+                float progress = status->progressAt(now);
 
-                    progress = _player->getProgress();
+                std::cout << "Progresso: " << formatTime(elapsed) << " / "
+                          << formatTime(status->duration) << std::endl;
 
-                    if (progress > 0.0f && elapsed > 0) {
-                        // unsigned int total = static_cast<unsigned
-                        // int>(elapsed / progress); unsigned int m = elapsed /
-                        // 60; unsigned int sec = elapsed % 60; char
-                        // bufElapsed[32]; std::snprintf(bufElapsed,
-                        // sizeof(bufElapsed), "%02u:%02u", m, sec); m = total /
-                        // 60; sec = total % 60; char bufTotal[32];
-                        // std::snprintf(bufTotal, sizeof(bufTotal),
-                        // "%02u:%02u", m, sec);
-
-                        int totalSeconds = elapsed;
-                        int h = totalSeconds / 3600;
-                        int m = (totalSeconds % 3600) / 60;
-                        int s = totalSeconds % 60;
-
-                        std::string formatted;
-                        if (h > 0) {
-                            formatted =
-                                std::to_string(h) + ":" + (m < 10 ? "0" : "")
-                                + std::to_string(m) + ":" + (s < 10 ? "0" : "")
-                                + std::to_string(s);
-                        } else {
-                            formatted = std::to_string(m) + ":"
-                                        + (s < 10 ? "0" : "")
-                                        + std::to_string(s);
-                        }
-
-                        auto totalDuration = _player->getPlaybackQueue()
-                                                 ->getCurrentSong()
-                                                 ->getFormattedDuration();
-
-                        std::cout << "Progresso: " << formatted << " / "
-                                  << totalDuration << std::endl;
-                    } else {
-                        std::cout << "Progresso: 0:0/0:0" << std::endl;
-                    }
-                } else {
-                    std::cout << "Nenhuma musica carregada atualmente."
-                              << std::endl;
-                }
+                std::string bar = waveformBar(status->song_id, progress, 60);
+                if (!bar.empty())
+                    std::cout << bar << std::endl;
+            } else {
+                std::cout << "Nenhuma musica carregada atualmente."
+                          << std::endl;
+            }
 
-                auto next = queue->getNextSong();
-                if (next) {
-                    std::cout << "Proxima musica: " << next->getTitle();
-                    if (next->getArtist())
-                        std::cout << " - " << next->getArtist()->getName();
-                    std::cout << std::endl;
-                } else {
-                    std::cout << "Proxima musica: (nenhuma)" << std::endl;
-                }
+            if (!status->next_title.empty()) {
+                std::cout << "Proxima musica: " << status->next_title;
+                if (!status->next_artist.empty())
+                    std::cout << " - " << status->next_artist;
+                std::cout << std::endl;
             } else {
-                std::cout << "Fila: N/D" << std::endl;
+                std::cout << "Proxima musica: (nenhuma)" << std::endl;
             }
 
             std::cout << "======================" << std::endl;
@@ -359,6 +413,44 @@ namespace cli {
         }
     }
 
+    std::string Cli::waveformBar(unsigned song_id, float progress,
+                                 size_t columns) const {
+        static const char* levels[] = {"▁", "▂", "▃", "▄",
+                                       "▅", "▆", "▇", "█"};
+
+        bool stale = !_waveform || _waveform->song_id != song_id
+                     || (_waveform->empty() && _analysisJob
+                         && _analysisJob->isRunning());
+        if (stale) {
+            core::RepositoryFactory repo_factory(_db);
+            _waveform = repo_factory.createSongRepository()->findWaveform(
+                song_id);
+            if (!_waveform) {
+                // marca como buscado para não consultar o banco a cada status
+                _waveform = std::make_shared<core::WaveformSummary>();
+                _waveform->song_id = song_id;
+            }
+        }
+
+        if (_waveform->empty())
+            return "";
+
+        auto peaks = _waveform->resample(columns);
+        size_t cursor = static_cast<size_t>(progress * columns);
+
+        std::string bar;
+        for (size_t c = 0; c < columns; ++c) {
+            if (c == cursor)
+                bar += "|";
+            size_t level = static_cast<size_t>(peaks[c] * 7.0f + 0.5f);
+            bar += levels[std::min<size_t>(level, 7)];
+        }
+        if (cursor >= columns)
+            bar += "|";
+
+        return bar;
+    }
+
     void Cli::updateUsers() {
         try {
             _usersManager->updateUsersList();
@@ -374,12 +466,118 @@ namespace cli {
         try {
             _manager->update();
             std::cout << "Biblioteca atualizada com sucesso." << std::endl;
+
+            // gera loudness e forma de onda das músicas novas em segundo plano
+            analyze("start");
         } catch (const std::exception& e) {
             std::cerr << "Erro ao atualizar a biblioteca: " << e.what()
                       << std::endl;
         }
     }
 
+    void Cli::analyze(const std::string& command) {
+        if (!_analysisJob) {
+            // o job lê e grava na thread dele: conexão própria
+            core::RepositoryFactory repo_factory(_db_manager.openConnection());
+            _analysisJob = std::make_shared<core::AudioAnalysisJob>(
+                std::shared_ptr<core::SongRepository>(
+                    repo_factory.createSongRepository()));
+        }
+
+        if (command == "start") {
+            if (_analysisJob->isRunning()) {
+                std::cout << "A análise já está em andamento." << std::endl;
+                return;
+            }
+            _analysisJob->start();
+            std::cout << "Análise de loudness e forma de onda iniciada em "
+                         "segundo plano."
+                      << std::endl;
+        } else if (command == "stop") {
+            _analysisJob->stop();
+            std::cout << "Análise interrompida; continua de onde parou no "
+                         "próximo 'analyze'."
+                      << std::endl;
+        } else {
+            auto report = _analysisJob->report();
+            std::cout << "Análise: "
+                      << (_analysisJob->isRunning() ? "em andamento"
+                                                    : "parada")
+                      << std::endl;
+            std::cout << "  Analisadas: " << report.analyzed
+                      << " | Falhas: " << report.failed << std::endl;
+            std::cout << "  Vazão: " << std::fixed << std::setprecision(2)
+                      << report.tracksPerSecondPerCore()
+                      << " músicas/s por núcleo (" << report.workers
+                      << " threads)" << std::endl;
+        }
+    }
+
+    void Cli::showStats(unsigned days) const {
+        // eventos ainda no buffer do writer também devem entrar na conta
+        _historyWriter->flush();
+
+        core::HistoryPlaybackRepository history(_db);
+        auto formatTime = [](long long seconds) {
+            std::ostringstream out;
+            out << seconds / 3600 << "h" << std::setw(2) << std::setfill('0')
+                << (seconds / 60) % 60 << "min";
+            return out.str();
+        };
+
+        std::cout << "=== Músicas mais ouvidas ===" << std::endl;
+        size_t position = 1;
+        for (const auto& entry : history.findTopSongs(*_user, 10)) {
+            std::cout << std::setw(2) << position++ << ". " << entry.name
+                      << " (" << entry.plays << "x, "
+                      << formatTime(entry.listened_seconds) << ")" << std::endl;
+        }
+
+        std::cout << "=== Artistas mais ouvidos ===" << std::endl;
+        position = 1;
+        for (const auto& entry : history.findTopArtists(*_user, 10)) {
+            std::cout << std::setw(2) << position++ << ". " << entry.name
+                      << " (" << entry.plays << "x, "
+                      << formatTime(entry.listened_seconds) << ")" << std::endl;
+        }
+
+        std::time_t now = std::time(nullptr);
+        std::time_t from = now - static_cast<std::time_t>(days) * 24 * 60 * 60;
+        unsigned plays = 0;
+        long long seconds = 0;
+        for (const auto& day : history.findDailyListening(*_user, from, now)) {
+            plays += day.plays;
+            seconds += day.listened_seconds;
+        }
+
+        std::cout << "Últimos " << days << " dias: " << plays
+                  << " reproduções, " << formatTime(seconds) << " de escuta."
+                  << std::endl;
+    }
+
+    void Cli::render(const std::string& output_path) {
+        auto queue = _player->getPlaybackQueue();
+        if (!queue || queue->empty()) {
+            std::cout << "Fila vazia, nada para renderizar." << std::endl;
+            return;
+        }
+
+        core::OfflineRenderer renderer;
+        renderer.setCrossfade(_player->getCrossfade());
+        renderer.setReplayGain(_player->isReplayGainEnabled());
+
+        std::cout << "Renderizando " << queue->size() << " músicas em '"
+                  << output_path << "'..." << std::endl;
+
+        auto report = renderer.render(*queue, output_path);
+        std::cout << "Renderizadas: " << report.tracks
+                  << " | Falhas: " << report.failed << std::endl;
+        std::cout << "  " << std::fixed << std::setprecision(1)
+                  << report.audio_seconds << "s de áudio em "
+                  << report.elapsed_seconds << "s (" << report.speedUp()
+                  << "x tempo real)" << std::endl;
+    }
+
     void Cli::showHelp() const {
         if (_helpData.empty() || !_helpData.contains("commands")) {
             std::cout << "Nenhuma informação de ajuda disponível." << std::endl;
@@ -525,17 +723,96 @@ namespace cli {
         }
     }
 
+    void Cli::restoreQueue() {
+        try {
+            core::RepositoryFactory repo_factory(_db);
+            auto songs = std::shared_ptr<core::SongRepository>(
+                repo_factory.createSongRepository());
+
+            uint32_t position = 0;
+            auto queue = _player->getPlaybackQueue();
+            if (queue && _queueStore->restore(*queue, songs, position)) {
+                if (auto current = queue->getCurrentSong())
+                    _player->setResumePosition(current->getId(), position);
+                std::cout << "Fila restaurada: " << queue->size() << " músicas."
+                          << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Erro ao restaurar a fila de reprodução: " << e.what()
+                      << std::endl;
+        }
+    }
+
+    void Cli::saveQueue() {
+        auto queue = _player->getPlaybackQueue();
+        if (!queue)
+            return;
+
+        if (!_queueStore->save(*queue, queuePosition())) {
+            std::cerr << "Erro ao salvar a fila de reprodução em '"
+                      << _queueStore->path() << "'" << std::endl;
+        }
+    }
+
+    void Cli::saveQueueIfChanged() {
+        auto queue = _player->getPlaybackQueue();
+        if (queue && _queueStore->isDirty(*queue))
+            _queueStore->saveIfChanged(*queue, queuePosition());
+    }
+
+    uint32_t Cli::queuePosition() const {
+        return _player->isPlaying() || _player->isPaused()
+                   ? _player->getElapsedTime()
+                   : 0;
+    }
+
     void Cli::start() {
         std::string command;
         std::cout << "Bem-vindo ao frankenstein Music Player!" << std::endl;
         std::cout << "Digite 'help' para ver a lista de comandos disponíveis."
                   << std::endl;
 
+        // getline bloqueia: a leitura fica em outra thread para o loop
+        // continuar tratando o fim das faixas enquanto espera um comando
+        auto input = std::make_shared<InputLines>();
+        std::thread([input]() {
+            std::string line;
+            while (std::getline(std::cin, line)) {
+                std::lock_guard<std::mutex> lock(input->mutex);
+                input->lines.push_back(line);
+                input->ready.notify_one();
+            }
+            std::lock_guard<std::mutex> lock(input->mutex);
+            input->closed = true;
+            input->ready.notify_one();
+        }).detach();
+
         while (true) {
-            std::cout << "frankenstein> ";
-            std::getline(std::cin, command);
+            std::cout << "frankenstein> " << std::flush;
+
+            {
+                std::unique_lock<std::mutex> lock(input->mutex);
+                while (input->lines.empty() && !input->closed) {
+                    lock.unlock();
+                    _player->poll();
+                    // mudanças adiadas pelo intervalo mínimo são gravadas aqui
+                    saveQueueIfChanged();
+                    lock.lock();
+                    input->ready.wait_for(lock, std::chrono::milliseconds(CLI_POLL_INTERVAL_MS_DEFAULT),
+                                          [&input]() { return !input->lines.empty() || input->closed; });
+                }
+
+                if (input->lines.empty()) {
+                    command = "exit";
+                } else {
+                    command = input->lines.front();
+                    input->lines.pop_front();
+                }
+            }
+            _player->poll();
 
             if (command == "exit" || command == "quit") {
+                saveQueue();
                 std::cout << "Saindo do frankenstein Music Player. Até logo!"
                           << std::endl;
                 break;
@@ -545,6 +822,10 @@ namespace cli {
             if (!success) {
                 std::cout << "Digite um comando valido!" << std::endl;
             }
+
+            // comandos como 'queue add' mexem na fila sem passar pelo player
+            _player->refreshStatus();
+            saveQueueIfChanged();
         }
     }
 
@@ -637,7 +918,15 @@ namespace cli {
                 deslike();
                 return true;
             } else if (firstCommand == "shuffle") {
-                shuffle();
+                std::string mode;
+                ss >> mode;
+                if (!mode.empty() && mode != "smart" && mode != "normal") {
+                    std::cout << "Comando inválido para shuffle. Use 'shuffle', "
+                                 "'shuffle smart' ou 'shuffle normal'."
+                              << std::endl;
+                    return false;
+                }
+                shuffle(mode);
                 return true;
             } else if (firstCommand == "loop") {
                 std::string loopCommand;
@@ -655,6 +944,28 @@ namespace cli {
                 }
                 showHelp("loop");
                 return true;
+            } else if (firstCommand == "crossfade") {
+                std::string crossfadeCommand;
+                if (ss >> crossfadeCommand) {
+                    if (crossfadeCommand == "off") {
+                        setCrossfade(0);
+                        return true;
+                    }
+
+                    try {
+                        setCrossfade(std::stoul(crossfadeCommand));
+                        return true;
+                    } catch (const std::exception&) {
+                        std::cout << "Comando inválido para crossfade. Use "
+                                     "'crossfade <segundos>' ou 'crossfade off'."
+                                  << std::endl;
+                        return false;
+                    }
+                }
+
+                std::cout << "Crossfade: " << _player->getCrossfade() / 1000
+                          << "s" << std::endl;
+                return true;
             } else if (firstCommand == "queue") {
                 std::string queueCommand;
 
@@ -698,10 +1009,39 @@ namespace cli {
                                       << std::endl;
                             return false;
                         }
+                    } else if (queueCommand == "list") {
+                        for (const auto& name : _player->getQueueNames()) {
+                            std::cout
+                                << (name == _player->getCurrentQueueName() ? "* "
+                                                                           : "  ")
+                                << name << std::endl;
+                        }
+                        return true;
+                    } else if (queueCommand == "new" || queueCommand == "switch"
+                               || queueCommand == "drop") {
+                        std::string name;
+                        std::getline(ss, name);
+                        name = trimSpaces(name);
+                        if (name.empty()) {
+                            std::cout << "Por favor, forneça o nome da fila."
+                                      << std::endl;
+                            return false;
+                        }
+
+                        if (queueCommand == "new") {
+                            _player->createQueue(name);
+                            _player->switchQueue(name);
+                        } else if (queueCommand == "switch") {
+                            _player->switchQueue(name);
+                        } else {
+                            _player->dropQueue(name);
+                        }
+                        return true;
                     } else {
                         std::cout << "Comando inválido para queue. Use 'queue "
-                                     "show', 'queue clear', 'queue add <song>' "
-                                     "ou 'queue remove <index>'."
+                                     "show', 'queue clear', 'queue add <song>', "
+                                     "'queue remove <index>', 'queue list' ou "
+                                     "'queue <new|switch|drop> <nome>'."
                                   << std::endl;
                         return false;
                     }
@@ -858,6 +1198,40 @@ namespace cli {
 
                 showHelp("search");
                 return true;
+            } else if (firstCommand == "analyze") {
+                std::string analyzeCommand = "start";
+                ss >> analyzeCommand;
+                if (analyzeCommand != "start" && analyzeCommand != "stop"
+                    && analyzeCommand != "status") {
+                    showHelp("analyze");
+                    return false;
+                }
+                analyze(analyzeCommand);
+                return true;
+            } else if (firstCommand == "render") {
+                std::string outputPath;
+                if (!(ss >> outputPath)) {
+                    showHelp("render");
+                    return false;
+                }
+                render(outputPath);
+                return true;
+            } else if (firstCommand == "stats") {
+                std::string daysArg;
+                if (!(ss >> daysArg)) {
+                    showStats();
+                    return true;
+                }
+
+                try {
+                    showStats(std::stoul(daysArg));
+                    return true;
+                } catch (const std::exception&) {
+                    std::cout << "Comando inválido para stats. Use 'stats' "
+                                 "ou 'stats <dias>'."
+                              << std::endl;
+                    return false;
+                }
             } else if (firstCommand == "help") {
                 ss >> firstCommand ? showHelp(firstCommand) : showHelp();
                 return true;
@@ -5,6 +5,7 @@
 #include "core/bd/SongRepository.hpp"
 #include "core/entities/Album.hpp"
 #include "core/entities/Song.hpp"
+#include "core/util/Collation.hpp"
 #include <memory>
 #include <string>
 
@@ -23,16 +24,24 @@
 namespace core {
 
     AlbumRepository::AlbumRepository(std::shared_ptr<SQLite::Database> db)
-        : core::SQLiteRepositoryBase<Album>(db, "albums") {};
+        : core::SQLiteRepositoryBase<Album>(db, "albums") {
+        _songs = std::make_shared<SongListLoader>([db](const std::vector<unsigned> &ids) {
+            return SongRepository(db).findByAlbums(ids);
+        });
+        _featuring = std::make_shared<ArtistListLoader>([db](const std::vector<unsigned> &ids) {
+            return ArtistRepository(db).findFeaturingByAlbums(ids);
+        });
+    };
 
     bool AlbumRepository::insert(Album &entity) {
-        std::string sql = "INSERT INTO " + _table_name + " (title, release_year, genre, user_id) " + "VALUES (?, ?, ?, ?);";
+        std::string sql = "INSERT INTO " + _table_name + " (title, release_year, genre, user_id, title_key) " + "VALUES (?, ?, ?, ?, ?);";
         SQLite::Statement query = prepare(sql);
 
         query.bind(1, entity.getTitle());
         query.bind(2, entity.getYear());
         query.bind(3, entity.getGenre());
         query.bind(4, entity.getUser()->getId());
+        query.bind(5, collationKey(entity.getTitle()));
 
         bool success = query.exec() > 0;
 
@@ -44,37 +53,57 @@ namespace core {
 
     bool AlbumRepository::update(const Album &entity) {
         std::string sql =
-            "UPDATE " + _table_name + " SET title = ?, release_year = ?, genre = ?" + "WHERE id = ?";
+            "UPDATE " + _table_name + " SET title = ?, release_year = ?, genre = ?, title_key = ?" + " WHERE id = ?";
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, entity.getTitle());
         query.bind(2, entity.getYear());
         query.bind(3, entity.getGenre());
-        query.bind(4, entity.getId());
+        query.bind(4, collationKey(entity.getTitle()));
+        query.bind(5, entity.getId());
 
         return query.exec() > 0;
     };
 
     std::shared_ptr<Album>
     AlbumRepository::mapRowToEntity(SQLite::Statement &query) const {
-        unsigned id = query.getColumn("id").getInt();
-        std::string title = query.getColumn("title").getString();
-        int year = query.getColumn("release_year").getInt();
-        std::string genre = query.getColumn("genre").getString();
-        unsigned user_id = query.getColumn("user_id").getInt();
+        return mapJoinedRow(query, "");
+    };
 
-        // TODO carregar usuário do album
-        // auto album = std::make_shared<Album>(id, title, year, genre, user_id);
-        std::shared_ptr<Album> album;
+    std::shared_ptr<Album>
+    AlbumRepository::mapJoinedRow(SQLite::Statement &query, const std::string &prefix) const {
+        unsigned id = query.getColumn((prefix + "id").c_str()).getInt();
+        std::string title = query.getColumn((prefix + "title").c_str()).getString();
+        int year = query.getColumn((prefix + "release_year").c_str()).getInt();
+        std::string genre = query.getColumn((prefix + "genre").c_str()).getString();
+        unsigned user_id = query.getColumn((prefix + "user_id").c_str()).getInt();
+
+        CollectionTotals totals;
+        totals.songs = query.getColumn((prefix + "song_count").c_str()).getUInt();
+        totals.duration = query.getColumn((prefix + "total_duration").c_str()).getUInt();
 
-        auto artists_loader = [this, id]() -> std::vector<std::shared_ptr<Artist>> {
-            Album tempAlbum;
-            tempAlbum.setId(id);
-            return this->getFeaturingArtists(tempAlbum);
+        // TODO carregar usuário do album
+        auto album = std::make_shared<Album>();
+        album->setId(id);
+        album->setTitle(title);
+        album->setYear(year);
+        if (!genre.empty())
+            album->setGenre(genre);
+        album->setTotals(totals);
+        album->setDataCriacao(readCreatedAt(query, prefix + "created_at"));
+
+        // as chaves entram no lote; o primeiro acesso resolve todas de uma vez
+        auto songs = _songs;
+        auto featuring = _featuring;
+        songs->enqueue(id);
+        featuring->enqueue(id);
+
+        auto artists_loader = [featuring, id]() -> std::vector<std::shared_ptr<Artist>> {
+            return featuring->load(id);
         };
 
-        auto songs_loader = [this, album]() -> std::vector<std::shared_ptr<Song>> {
-            return this->getSongs(*album);
+        auto songs_loader = [songs, id]() -> std::vector<std::shared_ptr<Song>> {
+            return songs->load(id);
         };
 
         album->setSongsLoader(songs_loader);
@@ -104,11 +133,33 @@ namespace core {
     std::vector<std::shared_ptr<Album>>
     AlbumRepository::findByTitleAndUser(const std::string &title,
                                         const User &user) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE title LIKE ? AND user_id = ?;";
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? AND title_key LIKE ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, "%" + title + "%");
-        query.bind(2, user.getId());
+        query.bind(1, user.getId());
+        query.bind(2, "%" + collationKey(title) + "%");
+
+        std::vector<std::shared_ptr<Album>> albums;
+        while (query.executeStep()) {
+            albums.push_back(mapRowToEntity(query));
+        }
+
+        return albums;
+    }
+
+    std::vector<std::shared_ptr<Album>>
+    AlbumRepository::findByTitlePrefix(const std::string &prefix, const User &user) const {
+        std::string key = collationKey(prefix);
+        std::string end = collationPrefixEnd(key);
+
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? AND title_key >= ?"
+                          + (end.empty() ? "" : " AND title_key < ?") + " ORDER BY title_key;";
+
+        SQLite::Statement query = prepare(sql);
+        query.bind(1, user.getId());
+        query.bind(2, key);
+        if (!end.empty())
+            query.bind(3, end);
 
         std::vector<std::shared_ptr<Album>> albums;
         while (query.executeStep()) {
@@ -121,7 +172,7 @@ namespace core {
     std::vector<std::shared_ptr<Album>>
     AlbumRepository::findByUser(const User &user) const {
         std::string sql =
-            "SELECT * FROM " + _table_name + " WHERE user_id = ?;";
+            "SELECT * FROM " + _table_name + " WHERE user_id = ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, user.getId());
@@ -141,10 +192,11 @@ namespace core {
         std::string sql = "SELECT alb.* FROM albums alb "
                           "JOIN album_artists aa ON alb.id = aa.album_id "
                           "JOIN artists art ON aa.artist_id = art.id "
-                          "WHERE art.name LIKE ? AND aa.is_principal = 1;";
+                          "WHERE art.name_key LIKE ? AND aa.is_principal = 1 "
+                          "ORDER BY alb.title_key;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, "%" + artist_name + "%");
+        query.bind(1, "%" + collationKey(artist_name) + "%");
 
         std::vector<std::shared_ptr<Album>> albums;
         while (query.executeStep()) {
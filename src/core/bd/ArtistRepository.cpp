@@ -4,6 +4,8 @@
 #include "core/bd/AlbumRepository.hpp"
 #include "core/bd/SQLiteRepositoryBase.hpp"
 #include "core/bd/SongRepository.hpp"
+#include "core/util/Collation.hpp"
+#include <algorithm>
 #include <memory>
 
 /*
@@ -24,11 +26,12 @@ namespace core {
     bool ArtistRepository::insert(Artist& entity) {
         if (!entity.getUser())
             throw std::invalid_argument("Artist must be associated with a User.");
-        std::string sql = "INSERT INTO " + _table_name + " (name, user_id) "
-                            + "VALUES(?, ?);";
+        std::string sql = "INSERT INTO " + _table_name + " (name, user_id, name_key) "
+                            + "VALUES(?, ?, ?);";
         SQLite::Statement query = prepare(sql);
         query.bind(1, entity.getName());
         query.bind(2, entity.getUser()->getId());
+        query.bind(3, collationKey(entity.getName()));
 
         bool success = query.exec() > 0;
 
@@ -40,25 +43,38 @@ namespace core {
 
     bool ArtistRepository::update(const Artist& entity) {
         std::string sql =
-            "UPDATE " + _table_name + " SET name = ?, user_id = ? WHERE id = ?";
+            "UPDATE " + _table_name + " SET name = ?, user_id = ?, name_key = ? WHERE id = ?";
         SQLite::Statement query = prepare(sql);
 
         query.bind(1, entity.getName());
         query.bind(2, entity.getUser()->getId());
-        query.bind(3, entity.getId());
+        query.bind(3, collationKey(entity.getName()));
+        query.bind(4, entity.getId());
 
         return query.exec() > 0;
     };
 
     std::shared_ptr<Artist>
     ArtistRepository::mapRowToEntity(SQLite::Statement& query) const {
-        unsigned id = query.getColumn("id").getInt();
-        std::string name = query.getColumn("name").getString();
-        unsigned user_id = query.getColumn("user_id").getInt();
+        return mapJoinedRow(query, "");
+    };
+
+    std::shared_ptr<Artist>
+    ArtistRepository::mapJoinedRow(SQLite::Statement& query, const std::string& prefix) const {
+        unsigned id = query.getColumn((prefix + "id").c_str()).getInt();
+        std::string name = query.getColumn((prefix + "name").c_str()).getString();
+        unsigned user_id = query.getColumn((prefix + "user_id").c_str()).getInt();
+
+        CollectionTotals totals;
+        totals.songs = query.getColumn((prefix + "song_count").c_str()).getUInt();
+        totals.duration = query.getColumn((prefix + "total_duration").c_str()).getUInt();
 
-        // return std::make_shared<Artist>(id, name, user_id);
         // TODO carregar usuário do artista
-        return std::make_shared<Artist>();
+        auto artist = std::make_shared<Artist>(name, "");
+        artist->setId(id);
+        artist->setTotals(totals);
+        artist->setDataCriacao(readCreatedAt(query, prefix + "created_at"));
+        return artist;
     };
 
     bool ArtistRepository::save(Artist& entity) {
@@ -82,11 +98,34 @@ namespace core {
     ArtistRepository::findByNameAndUser(const std::string& name,
                                         const User& user) const {
         std::string sql = "SELECT * FROM " + _table_name
-                          + " WHERE name LIKE ? AND user_id = ?;";
+                          + " WHERE user_id = ? AND name_key LIKE ? ORDER BY name_key;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, "%" + name + "%");
-        query.bind(2, user.getId());
+        query.bind(1, user.getId());
+        query.bind(2, "%" + collationKey(name) + "%");
+
+        std::vector<std::shared_ptr<Artist>> artists;
+        while (query.executeStep()) {
+            artists.push_back(mapRowToEntity(query));
+        }
+
+        return artists;
+    }
+
+    std::vector<std::shared_ptr<Artist>>
+    ArtistRepository::findByNamePrefix(const std::string& prefix,
+                                       const User& user) const {
+        std::string key = collationKey(prefix);
+        std::string end = collationPrefixEnd(key);
+
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? AND name_key >= ?"
+                          + (end.empty() ? "" : " AND name_key < ?") + " ORDER BY name_key;";
+
+        SQLite::Statement query = prepare(sql);
+        query.bind(1, user.getId());
+        query.bind(2, key);
+        if (!end.empty())
+            query.bind(3, end);
 
         std::vector<std::shared_ptr<Artist>> artists;
         while (query.executeStep()) {
@@ -121,4 +160,40 @@ namespace core {
         return song_repository.findByArtist(artist);
     };
 
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+    ArtistRepository::findFeaturingBy(const std::string& relation,
+                                      const std::string& owner_column,
+                                      const std::vector<unsigned>& owner_ids) const {
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>> featuring;
+
+        for (size_t begin = 0; begin < owner_ids.size(); begin += BATCH_LOADER_MAX_KEYS_DEFAULT) {
+            size_t count = std::min<size_t>(BATCH_LOADER_MAX_KEYS_DEFAULT, owner_ids.size() - begin);
+            std::string sql = "SELECT r." + owner_column + " AS owner_id, a.* FROM artists a "
+                              "JOIN " + relation + " r ON a.id = r.artist_id "
+                              "WHERE r.is_principal = 0 AND r." + owner_column + " IN ("
+                              + sqlPlaceholders(count) + ");";
+
+            SQLite::Statement query = prepare(sql);
+            for (size_t i = 0; i < count; ++i)
+                query.bind(static_cast<int>(i + 1), owner_ids[begin + i]);
+
+            while (query.executeStep()) {
+                unsigned owner_id = query.getColumn("owner_id").getUInt();
+                featuring[owner_id].push_back(mapRowToEntity(query));
+            }
+        }
+
+        return featuring;
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+    ArtistRepository::findFeaturingBySongs(const std::vector<unsigned>& song_ids) const {
+        return findFeaturingBy("song_artists", "song_id", song_ids);
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Artist>>>
+    ArtistRepository::findFeaturingByAlbums(const std::vector<unsigned>& album_ids) const {
+        return findFeaturingBy("album_artists", "album_id", album_ids);
+    }
+
 };  // namespace core
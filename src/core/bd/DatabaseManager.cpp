@@ -8,13 +8,38 @@
  */
 
 #include "core/bd/DatabaseManager.hpp"
+#include "core/util/Collation.hpp"
+#include "core/util/OrderKey.hpp"
+
+#include <sqlite3.h>
 
 #include <filesystem>
 #include <fstream>
 #include <sstream>
-
+#include <stdexcept>
+#include <vector>
 
 namespace core {
+    namespace {
+        void foldFunction(sqlite3_context *context, int, sqlite3_value **argv) {
+            if (sqlite3_value_type(argv[0]) == SQLITE_NULL) {
+                sqlite3_result_null(context);
+                return;
+            }
+
+            const char *text = reinterpret_cast<const char *>(sqlite3_value_text(argv[0]));
+            std::string key = collationKey(std::string(text, sqlite3_value_bytes(argv[0])));
+            sqlite3_result_text(context, key.c_str(), static_cast<int>(key.size()), SQLITE_TRANSIENT);
+        }
+
+        int foldCompare(void *, int a_size, const void *a, int b_size, const void *b) {
+            std::string a_key = collationKey(std::string(static_cast<const char *>(a), a_size));
+            std::string b_key = collationKey(std::string(static_cast<const char *>(b), b_size));
+            int result = a_key.compare(b_key);
+            return result < 0 ? -1 : (result > 0 ? 1 : 0);
+        }
+    }
+
     DatabaseManager::DatabaseManager(std::string db_path,
                                     std::string schema_path)
         : _db_path(db_path), _schema_path(schema_path) {
@@ -22,8 +47,12 @@ namespace core {
             _db_path,
             SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
 
-        SQLite::Statement query(*_db, "PRAGMA foreign_keys = ON;");
-        query.exec();
+        configureConnection(*_db);
+
+        // só tem efeito antes da primeira tabela; bancos antigos passam por migrate()
+        _db->exec("PRAGMA auto_vacuum = INCREMENTAL;");
+        // fica gravado no arquivo; vale para todas as conexões
+        _db->exec("PRAGMA journal_mode = WAL;");
 
         std::filesystem::path schema_file(_schema_path);
         if (std::filesystem::exists(schema_file)) {
@@ -39,6 +68,188 @@ namespace core {
         } else {
             throw std::runtime_error("Schema file not found");
         }
+
+        migrate();
+    }
+
+    void DatabaseManager::configureConnection(SQLite::Database &db) {
+        db.exec("PRAGMA foreign_keys = ON;");
+        db.setBusyTimeout(DATABASE_BUSY_TIMEOUT_MS_DEFAULT);
+        registerCollation(db);
+    }
+
+    std::shared_ptr<SQLite::Database> DatabaseManager::openConnection() const {
+        // outra conexão com ":memory:" seria outro banco, vazio
+        if (_db_path == ":memory:")
+            return _db;
+
+        auto db = std::make_shared<SQLite::Database>(_db_path, SQLite::OPEN_READWRITE);
+        configureConnection(*db);
+        return db;
+    }
+
+    void DatabaseManager::migrate() {
+        addColumnIfMissing("songs", "replay_gain", "REAL");
+        addColumnIfMissing("songs", "replay_gain_peak", "REAL");
+        addColumnIfMissing("songs", "integrated_loudness", "REAL");
+        addColumnIfMissing("songs", "true_peak", "REAL");
+        addColumnIfMissing("songs", "analyzed_at", "DATETIME");
+        addColumnIfMissing("songs", "title_key", "TEXT");
+        addColumnIfMissing("albums", "title_key", "TEXT");
+        addColumnIfMissing("artists", "name_key", "TEXT");
+        backfillCollationKeys();
+
+        bool missing_totals = false;
+        for (const char *table : {"playlists", "albums", "artists"}) {
+            missing_totals |= addColumnIfMissing(table, "song_count", "INTEGER NOT NULL DEFAULT 0");
+            missing_totals |= addColumnIfMissing(table, "total_duration", "INTEGER NOT NULL DEFAULT 0");
+        }
+        if (missing_totals)
+            backfillCollectionTotals();
+
+        convertPlaylistPositions();
+        normalizeHistoryTimestamps();
+        backfillPlayStats();
+    }
+
+    bool DatabaseManager::addColumnIfMissing(const std::string &table,
+                                             const std::string &column,
+                                             const std::string &definition) {
+        SQLite::Statement query(*_db, "PRAGMA table_info(" + table + ");");
+
+        while (query.executeStep()) {
+            if (query.getColumn("name").getString() == column)
+                return false;
+        }
+
+        _db->exec("ALTER TABLE " + table + " ADD COLUMN " + column + " "
+                  + definition + ";");
+        return true;
+    }
+
+    void DatabaseManager::registerCollation(SQLite::Database &db) {
+        db.createFunction(COLLATION_FUNCTION_NAME, 1, true, nullptr, foldFunction);
+
+        int result = sqlite3_create_collation_v2(db.getHandle(), COLLATION_NAME, SQLITE_UTF8,
+                                                 nullptr, foldCompare, nullptr);
+        if (result != SQLITE_OK)
+            throw std::runtime_error("Falha ao registrar a collation " COLLATION_NAME);
+    }
+
+    void DatabaseManager::backfillCollationKeys() {
+        _db->exec("UPDATE songs SET title_key = fold(title) WHERE title_key IS NULL;");
+        _db->exec("UPDATE albums SET title_key = fold(title) WHERE title_key IS NULL;");
+        _db->exec("UPDATE artists SET name_key = fold(name) WHERE name_key IS NULL;");
+
+        // as colunas podem ter acabado de chegar por addColumnIfMissing
+        _db->exec("CREATE INDEX IF NOT EXISTS idx_songs_user_title_key ON songs(user_id, title_key);");
+        _db->exec("CREATE INDEX IF NOT EXISTS idx_albums_user_title_key ON albums(user_id, title_key);");
+        _db->exec("CREATE INDEX IF NOT EXISTS idx_artists_user_name_key ON artists(user_id, name_key);");
+    }
+
+    void DatabaseManager::backfillCollectionTotals() {
+        SQLite::Transaction transaction(*_db);
+
+        _db->exec(
+            "UPDATE playlists SET"
+            " song_count = (SELECT COUNT(1) FROM playlist_songs ps WHERE ps.playlist_id = playlists.id),"
+            " total_duration = (SELECT COALESCE(SUM(s.duration), 0) FROM playlist_songs ps"
+            " JOIN songs s ON s.id = ps.song_id WHERE ps.playlist_id = playlists.id);");
+        _db->exec(
+            "UPDATE albums SET"
+            " song_count = (SELECT COUNT(1) FROM songs WHERE album_id = albums.id),"
+            " total_duration = (SELECT COALESCE(SUM(duration), 0) FROM songs WHERE album_id = albums.id);");
+        _db->exec(
+            "UPDATE artists SET"
+            " song_count = (SELECT COUNT(1) FROM songs WHERE artist_id = artists.id),"
+            " total_duration = (SELECT COALESCE(SUM(duration), 0) FROM songs WHERE artist_id = artists.id);");
+
+        transaction.commit();
+    }
+
+    void DatabaseManager::convertPlaylistPositions() {
+        std::vector<unsigned> playlist_ids;
+        SQLite::Statement pending(*_db,
+            "SELECT DISTINCT playlist_id FROM playlist_songs"
+            " WHERE typeof(position) <> 'text' OR position = ''"
+            " OR position GLOB '*[^a-z]*' OR position GLOB '*a';");
+        while (pending.executeStep())
+            playlist_ids.push_back(pending.getColumn(0).getUInt());
+        if (playlist_ids.empty())
+            return;
+
+        SQLite::Transaction transaction(*_db);
+        SQLite::Statement update(*_db,
+            "UPDATE playlist_songs SET position = ? WHERE playlist_id = ? AND song_id = ?;");
+
+        for (unsigned playlist_id : playlist_ids) {
+            // posições numéricas primeiro, em ordem numérica mesmo se gravadas como texto
+            std::vector<unsigned> song_ids;
+            SQLite::Statement songs(*_db,
+                "SELECT song_id FROM playlist_songs WHERE playlist_id = ?"
+                " ORDER BY position GLOB '*[^0-9]*', CAST(position AS INTEGER), position;");
+            songs.bind(1, playlist_id);
+            while (songs.executeStep())
+                song_ids.push_back(songs.getColumn(0).getUInt());
+
+            std::vector<std::string> keys = orderKeysBetween("", "", song_ids.size());
+            for (size_t i = 0; i < song_ids.size(); ++i) {
+                update.bind(1, keys[i]);
+                update.bind(2, playlist_id);
+                update.bind(3, song_ids[i]);
+                update.exec();
+                update.reset();
+            }
+        }
+
+        transaction.commit();
+    }
+
+    void DatabaseManager::normalizeHistoryTimestamps() {
+        // texto é maior que qualquer número no SQLite: played_at >= '' pega
+        // só as linhas antigas e usa o índice (user_id, played_at)
+        _db->exec(
+            "UPDATE playback_history"
+            " SET played_at = CAST(strftime('%s', played_at) AS INTEGER)"
+            " WHERE user_id IN (SELECT id FROM users) AND played_at >= '';");
+    }
+
+    void DatabaseManager::backfillPlayStats() {
+        SQLite::Statement check(*_db,
+            "SELECT EXISTS(SELECT 1 FROM playback_history)"
+            " AND NOT EXISTS(SELECT 1 FROM song_play_stats);");
+        if (!check.executeStep() || check.getColumn(0).getInt() == 0)
+            return;
+
+        // versões antigas gravavam played_at como texto (CURRENT_TIMESTAMP)
+        const std::string played_at =
+            "CASE WHEN typeof(played_at) = 'integer' THEN played_at"
+            " ELSE CAST(strftime('%s', played_at) AS INTEGER) END";
+
+        SQLite::Transaction transaction(*_db);
+
+        _db->exec(
+            "INSERT INTO song_play_stats (user_id, song_id, play_count, listened_seconds, last_played_at)"
+            " SELECT user_id, song_id, COUNT(1), COALESCE(SUM(play_duration), 0), MAX(" + played_at + ")"
+            " FROM playback_history GROUP BY user_id, song_id;");
+
+        _db->exec(
+            "INSERT INTO artist_play_stats (user_id, artist_id, play_count, listened_seconds)"
+            " SELECT stats.user_id, songs.artist_id, SUM(stats.play_count), SUM(stats.listened_seconds)"
+            " FROM song_play_stats stats JOIN songs ON songs.id = stats.song_id"
+            " WHERE songs.artist_id IS NOT NULL"
+            " GROUP BY stats.user_id, songs.artist_id;");
+
+        _db->exec(
+            "INSERT INTO daily_play_stats (user_id, day, play_count, listened_seconds)"
+            " SELECT user_id, (" + played_at + ") / 86400, COUNT(1), COALESCE(SUM(play_duration), 0)"
+            " FROM playback_history GROUP BY 1, 2;");
+
+        _db->exec(
+            "UPDATE songs SET play_count ="
+            " (SELECT COALESCE(SUM(play_count), 0) FROM song_play_stats WHERE song_id = songs.id);");
+
+        transaction.commit();
     }
 
     DatabaseManager::~DatabaseManager() {}
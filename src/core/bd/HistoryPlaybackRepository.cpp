@@ -13,8 +13,25 @@
 #include "core/bd/SongRepository.hpp"
 #include "core/entities/User.hpp"
 
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
 
 namespace core {
+    static const std::time_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+    static PlaybackEvent toPlaybackEvent(const HistoryPlayback& entity) {
+        PlaybackEvent event;
+        event.user_id = entity.getUser()->getId();
+        event.song_id = entity.getSong()->getId();
+        event.played_at = entity.getPlayedAt();
+        // o tempo ouvido, não a duração da faixa: pular conta só o que tocou
+        event.duration = entity.getPlayDuration();
+        return event;
+    }
+
     HistoryPlaybackRepository::HistoryPlaybackRepository()
         : SQLiteRepositoryBase<HistoryPlayback>(
               nullptr,
@@ -27,32 +44,68 @@ namespace core {
               "playback_history") {}
 
     bool HistoryPlaybackRepository::insert(HistoryPlayback& entity) {
-        std::string sql =
-            "INSERT INTO " + _table_name +
-            " (user_id, song_id, played_at) "
-            "VALUES (?, ?, ?);";
-
-        SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(entity.getUser()->getId()));
-        query.bind(2, static_cast<int>(entity.getSong()->getId()));
-        query.bind(3, entity.getPlayedAt());
-
-        return query.exec() > 0;
+        // passa pelos eventos para os agregados continuarem completos
+        return insertPlaybackEvents({toPlaybackEvent(entity)});
     }
 
     bool HistoryPlaybackRepository::update(const HistoryPlayback& entity) {
+        SQLite::Transaction transaction(*_db);
+
+        SQLite::Statement current = prepare(
+            "SELECT user_id, song_id, played_at, play_duration FROM " + _table_name +
+            " WHERE id = ?;");
+        current.bind(1, static_cast<int>(entity.getId()));
+        if (!current.executeStep())
+            return false;
+
+        PlaybackEvent previous;
+        previous.user_id = static_cast<unsigned>(current.getColumn(0).getInt());
+        previous.song_id = static_cast<unsigned>(current.getColumn(1).getInt());
+        previous.played_at = static_cast<std::time_t>(current.getColumn(2).getInt64());
+        previous.duration = static_cast<unsigned>(current.getColumn(3).getInt());
+        current.reset();
+
         std::string sql =
             "UPDATE " + _table_name +
-            " SET user_id = ?, song_id = ?, played_at = ? "
+            " SET user_id = ?, song_id = ?, played_at = ?, play_duration = ? "
             "WHERE id = ?;";
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, static_cast<int>(entity.getUser()->getId()));
         query.bind(2, static_cast<int>(entity.getSong()->getId()));
         query.bind(3, entity.getPlayedAt());
-        query.bind(4, static_cast<int>(entity.getId()));
+        query.bind(4, static_cast<int>(entity.getPlayDuration()));
+        query.bind(5, static_cast<int>(entity.getId()));
+        query.exec();
+
+        // os agregados trocam o evento antigo pelo novo na mesma transação
+        applyAggregates({previous}, -1);
+        applyAggregates({toPlaybackEvent(entity)}, 1);
+
+        // a última reprodução do par antigo volta a vir das linhas que restaram
+        SQLite::Statement lastPlayed = prepare(
+            "UPDATE song_play_stats SET last_played_at = COALESCE("
+            "(SELECT MAX(played_at) FROM " + _table_name +
+            " WHERE user_id = ?1 AND song_id = ?2), last_played_at) "
+            "WHERE user_id = ?1 AND song_id = ?2;");
+        lastPlayed.bind(1, static_cast<int>(previous.user_id));
+        lastPlayed.bind(2, static_cast<int>(previous.song_id));
+        lastPlayed.exec();
+
+        transaction.commit();
+        return true;
+    }
+
+    std::shared_ptr<User> HistoryPlaybackRepository::loadUser(unsigned id) const {
+        return _users.get(id, [this](unsigned user_id) {
+            return UserRepository(_db).findById(user_id);
+        });
+    }
 
-        return query.exec() > 0;
+    std::shared_ptr<Song> HistoryPlaybackRepository::loadSong(unsigned id) const {
+        return _songs.get(id, [this](unsigned song_id) {
+            return SongRepository(_db).findById(song_id);
+        });
     }
 
     std::shared_ptr<HistoryPlayback>
@@ -62,17 +115,13 @@ namespace core {
         unsigned song_id = static_cast<unsigned>(query.getColumn("song_id").getInt());
         std::time_t played_at = query.getColumn("played_at").getInt64();
 
-        auto user_repo = UserRepository(_db);
-        auto user = user_repo.findById(user_id);
-
-        auto song_repo = SongRepository(_db);
-        auto song = song_repo.findById(song_id);
-
-        return std::make_shared<HistoryPlayback>(
+        auto playback = std::make_shared<HistoryPlayback>(
             id,
-            *user,
-            *song,
+            loadUser(user_id),
+            loadSong(song_id),
             played_at);
+        playback->setPlayDuration(static_cast<unsigned>(query.getColumn("play_duration").getInt()));
+        return playback;
     }
 
     bool HistoryPlaybackRepository::save(HistoryPlayback& entity) {
@@ -83,45 +132,212 @@ namespace core {
     }
 
     std::vector<std::shared_ptr<HistoryPlayback>>
-    HistoryPlaybackRepository::findByUser(const User& user) const {
+    HistoryPlaybackRepository::findByUser(const User& user, size_t limit) const {
         std::vector<std::shared_ptr<HistoryPlayback>> results;
         std::string sql =
-            "SELECT * FROM " + _table_name +
+            "SELECT id, song_id, played_at, play_duration FROM " + _table_name +
             " WHERE user_id = ? "
-            "ORDER BY played_at DESC;";
+            "ORDER BY played_at DESC"
+            + std::string(limit > 0 ? " LIMIT ?;" : ";");
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, static_cast<int>(user.getId()));
+        if (limit > 0)
+            query.bind(2, static_cast<int64_t>(limit));
+
+        auto owner = _users.get(user.getId(), [&user](unsigned) {
+            return std::make_shared<User>(user);
+        });
 
-        while (query.executeStep())
-            results.push_back(this->mapRowToEntity(query));
+        while (query.executeStep()) {
+            auto song = loadSong(static_cast<unsigned>(query.getColumn(1).getInt()));
+            if (!song)
+                continue;
+
+            auto playback = std::make_shared<HistoryPlayback>(
+                static_cast<unsigned>(query.getColumn(0).getInt()),
+                owner,
+                song,
+                static_cast<std::time_t>(query.getColumn(2).getInt64()));
+            playback->setPlayDuration(static_cast<unsigned>(query.getColumn(3).getInt()));
+            results.push_back(playback);
+        }
 
         return results;
     }
 
+    std::vector<RecentPlay> HistoryPlaybackRepository::findRecentlyPlayed(
+        const User& user, size_t limit, std::time_t from,
+        std::time_t before, unsigned before_id) const {
+        std::vector<RecentPlay> page;
+        if (limit == 0)
+            return page;
+
+        SQLite::Statement query = prepare(
+            "SELECT h.id, h.played_at, s.id, s.title, s.artist_id, a.name"
+            " FROM " + _table_name + " h"
+            " JOIN songs s ON s.id = h.song_id"
+            " LEFT JOIN artists a ON a.id = s.artist_id"
+            " WHERE h.user_id = ? AND h.played_at >= ?"
+            " AND (h.played_at, h.id) < (?, ?)"
+            " ORDER BY h.played_at DESC, h.id DESC"
+            " LIMIT ?;");
+        query.bind(1, static_cast<int>(user.getId()));
+        query.bind(2, static_cast<int64_t>(from));
+        query.bind(3, static_cast<int64_t>(before));
+        query.bind(4, static_cast<int>(before_id));
+        query.bind(5, static_cast<int64_t>(limit));
+
+        page.reserve(limit);
+        while (query.executeStep()) {
+            RecentPlay entry;
+            entry.history_id = static_cast<unsigned>(query.getColumn(0).getInt());
+            entry.played_at = static_cast<std::time_t>(query.getColumn(1).getInt64());
+            entry.song_id = static_cast<unsigned>(query.getColumn(2).getInt());
+            entry.title = query.getColumn(3).getString();
+            entry.artist_id = static_cast<unsigned>(query.getColumn(4).getInt());
+            entry.artist = query.getColumn(5).getString();
+            page.push_back(entry);
+        }
+
+        return page;
+    }
+
     bool HistoryPlaybackRepository::insertHistoryPlayback(HistoryPlayback& entity) {
         return insert(entity);
     }
 
     bool HistoryPlaybackRepository::insertMultipleHistoryPlaybacks(
         std::vector<HistoryPlayback>& entities) {
-        bool all_inserted = true;
-        for (auto& entity : entities) {
-            if (!insert(entity))
-                all_inserted = false;
+        std::vector<PlaybackEvent> events;
+        events.reserve(entities.size());
+        for (const auto& entity : entities)
+            events.push_back(toPlaybackEvent(entity));
+
+        return insertPlaybackEvents(events);
+    }
+
+    bool HistoryPlaybackRepository::insertPlaybackEvents(
+        const std::vector<PlaybackEvent>& events) {
+        if (events.empty())
+            return true;
+
+        SQLite::Transaction transaction(*_db);
+
+        SQLite::Statement query = prepare(
+            "INSERT INTO " + _table_name +
+            " (user_id, song_id, played_at, play_duration) "
+            "VALUES (?, ?, ?, ?);");
+
+        for (const auto& event : events) {
+            query.bind(1, static_cast<int>(event.user_id));
+            query.bind(2, static_cast<int>(event.song_id));
+            query.bind(3, static_cast<int64_t>(event.played_at));
+            query.bind(4, static_cast<int>(event.duration));
+            query.exec();
+            query.reset();
+        }
+
+        applyAggregates(events, 1);
+
+        transaction.commit();
+        return true;
+    }
+
+    void HistoryPlaybackRepository::applyAggregates(
+        const std::vector<PlaybackEvent>& events, int sign) {
+        // o lote é somado antes: um upsert por música/dia, não por evento
+        struct Totals {
+            int plays = 0;
+            long long seconds = 0;
+            std::time_t last_played_at = 0;
+        };
+        std::map<std::pair<unsigned, unsigned>, Totals> bySong;
+        std::map<std::pair<unsigned, long long>, Totals> byDay;
+
+        for (const auto& event : events) {
+            Totals& song = bySong[{event.user_id, event.song_id}];
+            song.plays += sign;
+            song.seconds += sign * static_cast<long long>(event.duration);
+            if (sign > 0)
+                song.last_played_at = std::max(song.last_played_at, event.played_at);
+
+            Totals& day = byDay[{event.user_id, event.played_at / SECONDS_PER_DAY}];
+            day.plays += sign;
+            day.seconds += sign * static_cast<long long>(event.duration);
+        }
+
+        SQLite::Statement songStats = prepare(
+            "INSERT INTO song_play_stats (user_id, song_id, play_count, listened_seconds, last_played_at) "
+            "VALUES (?, ?, ?, ?, ?) "
+            "ON CONFLICT(user_id, song_id) DO UPDATE SET "
+            "play_count = play_count + excluded.play_count, "
+            "listened_seconds = listened_seconds + excluded.listened_seconds, "
+            "last_played_at = MAX(COALESCE(last_played_at, 0), excluded.last_played_at);");
+        SQLite::Statement artistStats = prepare(
+            "INSERT INTO artist_play_stats (user_id, artist_id, play_count, listened_seconds) "
+            "SELECT ?, artist_id, ?, ? FROM songs WHERE id = ? AND artist_id IS NOT NULL "
+            "ON CONFLICT(user_id, artist_id) DO UPDATE SET "
+            "play_count = play_count + excluded.play_count, "
+            "listened_seconds = listened_seconds + excluded.listened_seconds;");
+        SQLite::Statement songCount = prepare(
+            "UPDATE songs SET play_count = COALESCE(play_count, 0) + ? WHERE id = ?;");
+
+        for (const auto& [key, totals] : bySong) {
+            songStats.bind(1, static_cast<int>(key.first));
+            songStats.bind(2, static_cast<int>(key.second));
+            songStats.bind(3, totals.plays);
+            songStats.bind(4, static_cast<int64_t>(totals.seconds));
+            songStats.bind(5, static_cast<int64_t>(totals.last_played_at));
+            songStats.exec();
+            songStats.reset();
+
+            artistStats.bind(1, static_cast<int>(key.first));
+            artistStats.bind(2, totals.plays);
+            artistStats.bind(3, static_cast<int64_t>(totals.seconds));
+            artistStats.bind(4, static_cast<int>(key.second));
+            artistStats.exec();
+            artistStats.reset();
+
+            songCount.bind(1, totals.plays);
+            songCount.bind(2, static_cast<int>(key.second));
+            songCount.exec();
+            songCount.reset();
+        }
+
+        SQLite::Statement dailyStats = prepare(
+            "INSERT INTO daily_play_stats (user_id, day, play_count, listened_seconds) "
+            "VALUES (?, ?, ?, ?) "
+            "ON CONFLICT(user_id, day) DO UPDATE SET "
+            "play_count = play_count + excluded.play_count, "
+            "listened_seconds = listened_seconds + excluded.listened_seconds;");
+
+        for (const auto& [key, totals] : byDay) {
+            dailyStats.bind(1, static_cast<int>(key.first));
+            dailyStats.bind(2, static_cast<int64_t>(key.second));
+            dailyStats.bind(3, totals.plays);
+            dailyStats.bind(4, static_cast<int64_t>(totals.seconds));
+            dailyStats.exec();
+            dailyStats.reset();
         }
-        return all_inserted;
     }
 
     unsigned HistoryPlaybackRepository::countPlaybacksBySongAndUser(const Song& song) const {
+        auto user = song.getUser();
+        if (!user)
+            return 0;
+
+        return countPlaybacksBySongAndUser(song, *user);
+    }
+
+    unsigned HistoryPlaybackRepository::countPlaybacksBySongAndUser(const Song& song, const User& user) const {
         std::string sql =
-            "SELECT COUNT(1) FROM " + _table_name +
-            " WHERE song_id = ? AND user_id = ?;" +
-            " ORDER BY played_at DESC;";
+            "SELECT play_count FROM song_play_stats"
+            " WHERE user_id = ? AND song_id = ?;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(song.getId()));
-        query.bind(2, static_cast<int>(song.getUser()->getId()));
+        query.bind(1, static_cast<int>(user.getId()));
+        query.bind(2, static_cast<int>(song.getId()));
 
         if (query.executeStep())
             return static_cast<unsigned>(query.getColumn(0).getInt());
@@ -129,18 +345,132 @@ namespace core {
         return 0;
     }
 
-    unsigned HistoryPlaybackRepository::countPlaybacksBySongAndUser(const Song& song, const User& user) const {
-        std::string sql =
-            "SELECT COUNT(1) FROM " + _table_name +
-            " WHERE song_id = ? AND user_id = ?;";
+    std::unordered_map<unsigned, SongPlayStats>
+    HistoryPlaybackRepository::findPlayStatsByUser(const User& user, std::time_t since) const {
+        std::unordered_map<unsigned, SongPlayStats> stats;
+
+        // sem janela, o agregado já tem a resposta
+        std::string sql = since <= 0
+            ? "SELECT song_id, play_count, last_played_at FROM song_play_stats"
+              " WHERE user_id = ?;"
+            : "SELECT song_id, COUNT(1), MAX(played_at) FROM " + _table_name +
+              " WHERE user_id = ? AND played_at >= ?"
+              " GROUP BY song_id;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, static_cast<int>(song.getId()));
-        query.bind(2, static_cast<int>(user.getId()));
+        query.bind(1, static_cast<int>(user.getId()));
+        if (since > 0)
+            query.bind(2, static_cast<int64_t>(since));
 
-        if (query.executeStep())
-            return static_cast<unsigned>(query.getColumn(0).getInt());
+        while (query.executeStep()) {
+            SongPlayStats entry;
+            entry.plays = static_cast<unsigned>(query.getColumn(1).getInt());
+            entry.last_played_at = query.getColumn(2).getInt64();
+            stats[static_cast<unsigned>(query.getColumn(0).getInt())] = entry;
+        }
 
-        return 0;
+        return stats;
+    }
+
+    std::vector<PlayRanking> HistoryPlaybackRepository::findTopSongs(const User& user,
+                                                                     size_t limit) const {
+        std::vector<PlayRanking> ranking;
+        SQLite::Statement query = prepare(
+            "SELECT stats.song_id, songs.title, stats.play_count, stats.listened_seconds"
+            " FROM song_play_stats stats JOIN songs ON songs.id = stats.song_id"
+            " WHERE stats.user_id = ?"
+            " ORDER BY stats.play_count DESC LIMIT ?;");
+        query.bind(1, static_cast<int>(user.getId()));
+        query.bind(2, static_cast<int64_t>(limit));
+
+        while (query.executeStep()) {
+            PlayRanking entry;
+            entry.id = static_cast<unsigned>(query.getColumn(0).getInt());
+            entry.name = query.getColumn(1).getString();
+            entry.plays = static_cast<unsigned>(query.getColumn(2).getInt());
+            entry.listened_seconds = query.getColumn(3).getInt64();
+            ranking.push_back(entry);
+        }
+
+        return ranking;
+    }
+
+    std::vector<PlayRanking> HistoryPlaybackRepository::findTopArtists(const User& user,
+                                                                       size_t limit) const {
+        std::vector<PlayRanking> ranking;
+        SQLite::Statement query = prepare(
+            "SELECT stats.artist_id, artists.name, stats.play_count, stats.listened_seconds"
+            " FROM artist_play_stats stats JOIN artists ON artists.id = stats.artist_id"
+            " WHERE stats.user_id = ?"
+            " ORDER BY stats.play_count DESC LIMIT ?;");
+        query.bind(1, static_cast<int>(user.getId()));
+        query.bind(2, static_cast<int64_t>(limit));
+
+        while (query.executeStep()) {
+            PlayRanking entry;
+            entry.id = static_cast<unsigned>(query.getColumn(0).getInt());
+            entry.name = query.getColumn(1).getString();
+            entry.plays = static_cast<unsigned>(query.getColumn(2).getInt());
+            entry.listened_seconds = query.getColumn(3).getInt64();
+            ranking.push_back(entry);
+        }
+
+        return ranking;
+    }
+
+    std::vector<DailyListening> HistoryPlaybackRepository::findDailyListening(
+        const User& user, std::time_t from, std::time_t to) const {
+        std::vector<DailyListening> days;
+        SQLite::Statement query = prepare(
+            "SELECT day, play_count, listened_seconds FROM daily_play_stats"
+            " WHERE user_id = ? AND day BETWEEN ? AND ?"
+            " ORDER BY day;");
+        query.bind(1, static_cast<int>(user.getId()));
+        query.bind(2, static_cast<int64_t>(from / SECONDS_PER_DAY));
+        query.bind(3, static_cast<int64_t>(to / SECONDS_PER_DAY));
+
+        while (query.executeStep()) {
+            DailyListening entry;
+            entry.day = static_cast<std::time_t>(query.getColumn(0).getInt64()) * SECONDS_PER_DAY;
+            entry.plays = static_cast<unsigned>(query.getColumn(1).getInt());
+            entry.listened_seconds = query.getColumn(2).getInt64();
+            days.push_back(entry);
+        }
+
+        return days;
+    }
+
+    size_t HistoryPlaybackRepository::deleteHistoryBefore(std::time_t before,
+                                                          size_t batch_size) {
+        if (batch_size == 0)
+            throw std::invalid_argument("Tamanho de lote inválido");
+
+        std::vector<unsigned> users;
+        SQLite::Statement user_query = prepare("SELECT id FROM users;");
+        while (user_query.executeStep())
+            users.push_back(static_cast<unsigned>(user_query.getColumn(0).getInt()));
+
+        SQLite::Statement query = prepare(
+            "DELETE FROM " + _table_name + " WHERE id IN ("
+            "SELECT id FROM " + _table_name +
+            " WHERE user_id = ? AND played_at < ? LIMIT ?);");
+
+        size_t removed = 0;
+        for (unsigned user_id : users) {
+            size_t deleted;
+            do {
+                SQLite::Transaction transaction(*_db);
+                query.bind(1, static_cast<int>(user_id));
+                query.bind(2, static_cast<int64_t>(before));
+                query.bind(3, static_cast<int64_t>(batch_size));
+                deleted = static_cast<size_t>(query.exec());
+                query.reset();
+                transaction.commit();
+
+                removed += deleted;
+            } while (deleted == batch_size);
+        }
+
+        return removed;
     }
 }  // namespace core
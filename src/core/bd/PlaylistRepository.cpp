@@ -8,15 +8,33 @@
  */
 
 #include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
 #include "core/bd/UserRepository.hpp"
+#include "core/util/OrderKey.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <iostream>
+#include <unordered_map>
 
 namespace core {
     PlaylistRepository::PlaylistRepository(std::shared_ptr<SQLite::Database> db)
-        : SQLiteRepositoryBase<Playlist>(db, "playlists") {}
+        : SQLiteRepositoryBase<Playlist>(db, "playlists") {
+        _songs = std::make_shared<SongListLoader>([db](const std::vector<unsigned>& ids) {
+            return SongRepository(db).findByPlaylists(ids);
+        });
+    }
+
+    bool PlaylistRepository::save(Playlist& entity) {
+        if (!SQLiteRepositoryBase<Playlist>::save(entity))
+            return false;
+
+        entity.clearChanges();
+        return true;
+    }
 
     bool PlaylistRepository::insert(Playlist& entity) {
+        SQLite::Transaction transaction(*_db);
+
         SQLite::Statement query(*_db,
                                 "INSERT INTO playlists (title, user_id) "
                                 "VALUES (?, ?);");
@@ -28,32 +46,31 @@ namespace core {
 
         entity.setId(static_cast<unsigned>(getLastInsertId()));
 
-        size_t size = entity.getSongsCount();
-        for (size_t i {0}; i < size; ++i) {
-            const auto& song =
-                *std::dynamic_pointer_cast<Song>(entity.getSongAt(i));
-            if (!addSongToPlaylist(entity, i, song))
-                return false;
+        std::vector<unsigned> song_ids;
+        for (const auto& song : entity.getSongs())
+            if (song)
+                song_ids.push_back(song->getId());
+        std::vector<std::string> keys = orderKeysBetween("", "", song_ids.size());
+
+        SQLite::Statement insertSong(*_db,
+                                     "INSERT INTO playlist_songs (playlist_id, "
+                                     "song_id, position) "
+                                     "VALUES (?, ?, ?);");
+        for (size_t i = 0; i < song_ids.size(); ++i) {
+            insertSong.bind(1, entity.getId());
+            insertSong.bind(2, song_ids[i]);
+            insertSong.bind(3, keys[i]);
+            insertSong.exec();
+            insertSong.reset();
         }
 
+        transaction.commit();
         return true;
     }
 
-    bool PlaylistRepository::addSongToPlaylist(const Playlist& playlist,
-                                               size_t pos,
-                                               const Song& song) {
-        SQLite::Statement query(*_db,
-                                "INSERT INTO playlist_songs (playlist_id, "
-                                "song_id, position) "
-                                "VALUES (?, ?, ?);");
-        query.bind(1, playlist.getId());
-        query.bind(2, song.getId());
-        query.bind(3, static_cast<unsigned>(pos));
-
-        return query.exec() > 0;
-    }
-
     bool PlaylistRepository::update(const Playlist& entity) {
+        SQLite::Transaction transaction(*_db);
+
         SQLite::Statement query(*_db,
                                 "UPDATE playlists SET title = ?, user_id = ? "
                                 "WHERE id = ?;");
@@ -64,25 +81,100 @@ namespace core {
         if (!query.exec())
             return false;
 
-        SQLite::Statement deleteQuery(*_db,
-                                      "DELETE FROM playlist_songs WHERE "
-                                      "playlist_id = ?;");
-        deleteQuery.bind(1, entity.getId());
+        if (entity.hasChanges())
+            applyChanges(entity);
 
-        if (!deleteQuery.exec())
-            return false;
+        transaction.commit();
+        return true;
+    }
 
+    void PlaylistRepository::applyChanges(const Playlist& playlist) {
+        const PlaylistChanges& changes = playlist.getChanges();
 
-        size_t size = entity.getSongsCount();
-        auto songs = entity.getSongs();
-        for (size_t i {0}; i < size; ++i) {
-            const auto& song =
-                *std::dynamic_pointer_cast<Song>(songs[i]);
-            if (!addSongToPlaylist(entity, i, song))
-                return false;
+        SQLite::Statement remove(*_db,
+                                 "DELETE FROM playlist_songs "
+                                 "WHERE playlist_id = ? AND song_id = ?;");
+        for (unsigned song_id : changes.removed) {
+            remove.bind(1, playlist.getId());
+            remove.bind(2, song_id);
+            remove.exec();
+            remove.reset();
         }
 
-        return true;
+        if (changes.inserted.empty() && changes.moved.empty())
+            return;
+
+        std::unordered_map<unsigned, std::string> stored;
+        SQLite::Statement select(*_db,
+                                 "SELECT song_id, position FROM playlist_songs "
+                                 "WHERE playlist_id = ?;");
+        select.bind(1, playlist.getId());
+        while (select.executeStep())
+            stored[select.getColumn(0).getUInt()] = select.getColumn(1).getString();
+
+        std::vector<std::shared_ptr<Song>> songs;
+        for (const auto& song : playlist.getSongs())
+            if (song)
+                songs.push_back(song);
+
+        // mantém as músicas que não mudaram e continuam em ordem crescente
+        std::vector<std::string> keys(songs.size());
+        std::vector<bool> keep(songs.size(), false);
+        std::string last;
+        for (size_t i = 0; i < songs.size(); ++i) {
+            unsigned id = songs[i]->getId();
+            auto it = stored.find(id);
+            if (it == stored.end() || changes.inserted.count(id) || changes.moved.count(id))
+                continue;
+            if (!isOrderKey(it->second) || (!last.empty() && it->second <= last))
+                continue;
+
+            keep[i] = true;
+            keys[i] = last = it->second;
+        }
+
+        // cada trecho sem chave recebe chaves entre as vizinhas mantidas
+        for (size_t begin = 0; begin < songs.size();) {
+            if (keep[begin]) {
+                ++begin;
+                continue;
+            }
+
+            size_t end = begin;
+            while (end < songs.size() && !keep[end])
+                ++end;
+
+            std::vector<std::string> fresh = orderKeysBetween(
+                begin > 0 ? keys[begin - 1] : "", end < songs.size() ? keys[end] : "", end - begin);
+            std::move(fresh.begin(), fresh.end(), keys.begin() + static_cast<std::ptrdiff_t>(begin));
+            begin = end;
+        }
+
+        SQLite::Statement move(*_db,
+                               "UPDATE playlist_songs SET position = ? "
+                               "WHERE playlist_id = ? AND song_id = ?;");
+        SQLite::Statement insert(*_db,
+                                 "INSERT INTO playlist_songs (playlist_id, song_id, position) "
+                                 "VALUES (?, ?, ?);");
+        for (size_t i = 0; i < songs.size(); ++i) {
+            if (keep[i])
+                continue;
+
+            unsigned id = songs[i]->getId();
+            if (stored.count(id)) {
+                move.bind(1, keys[i]);
+                move.bind(2, playlist.getId());
+                move.bind(3, id);
+                move.exec();
+                move.reset();
+            } else {
+                insert.bind(1, playlist.getId());
+                insert.bind(2, id);
+                insert.bind(3, keys[i]);
+                insert.exec();
+                insert.reset();
+            }
+        }
     }
 
     std::shared_ptr<Playlist>
@@ -92,15 +184,23 @@ namespace core {
         unsigned user_id = query.getColumn("user_id").getUInt();
         Playlist playlist(id, title);
 
+        CollectionTotals totals;
+        totals.songs = query.getColumn("song_count").getUInt();
+        totals.duration = query.getColumn("total_duration").getUInt();
+        playlist.setTotals(totals);
+        playlist.setDataCriacao(readCreatedAt(query));
+
         std::shared_ptr<UserRepository> userRepo =
             std::make_shared<UserRepository>(_db);
         std::shared_ptr<User> user = userRepo->findById(user_id);
         playlist.setUser(*user);
 
-        auto playlistPtr = std::make_shared<Playlist>(playlist);
+        // a chave entra no lote; o primeiro acesso resolve todas de uma vez
+        auto songs = _songs;
+        songs->enqueue(id);
         playlist.setSongsLoader(
-            [this, playlistPtr]() -> std::vector<std::shared_ptr<Song>> {
-                return this->getSongs(*playlistPtr);
+            [songs, id]() -> std::vector<std::shared_ptr<Song>> {
+                return songs->load(id);
             });
 
         return std::make_shared<Playlist>(playlist);
@@ -137,23 +237,50 @@ namespace core {
 
     std::vector<std::shared_ptr<Song>>
     PlaylistRepository::getSongs(const Playlist& playlist) const {
+        auto songs = SongRepository(_db).findByPlaylists({playlist.getId()});
+        auto it = songs.find(playlist.getId());
+        if (it == songs.end())
+            return {};
+        return it->second;
+    }
+
+    std::vector<unsigned>
+    PlaylistRepository::findUnbalanced(size_t max_length) const {
         SQLite::Statement query(*_db,
-                                "SELECT s.* FROM songs s "
-                                "JOIN playlist_songs ps ON s.id = ps.song_id "
-                                "WHERE ps.playlist_id = ?;");
-        query.bind(1, playlist.getId());
+                                "SELECT DISTINCT playlist_id FROM playlist_songs "
+                                "WHERE length(position) > ?;");
+        query.bind(1, static_cast<int64_t>(max_length));
 
-        std::vector<std::shared_ptr<Song>> songs;
-        while (query.executeStep()) {
-            unsigned song_id = query.getColumn("id").getUInt();
-            std::string title = query.getColumn("title").getString();
-            unsigned artist_id = query.getColumn("artist_id").getUInt();
+        std::vector<unsigned> playlist_ids;
+        while (query.executeStep())
+            playlist_ids.push_back(query.getColumn(0).getUInt());
+        return playlist_ids;
+    }
+
+    size_t PlaylistRepository::rebalance(unsigned playlist_id) {
+        SQLite::Transaction transaction(*_db);
+
+        std::vector<unsigned> song_ids;
+        SQLite::Statement select(*_db,
+                                 "SELECT song_id FROM playlist_songs "
+                                 "WHERE playlist_id = ? ORDER BY position;");
+        select.bind(1, playlist_id);
+        while (select.executeStep())
+            song_ids.push_back(select.getColumn(0).getUInt());
 
-            Song song(song_id, title, artist_id);
-            song.setUser(*playlist.getUser());
-            songs.push_back(std::make_shared<Song>(song));
+        std::vector<std::string> keys = orderKeysBetween("", "", song_ids.size());
+        SQLite::Statement update(*_db,
+                                 "UPDATE playlist_songs SET position = ? "
+                                 "WHERE playlist_id = ? AND song_id = ?;");
+        for (size_t i = 0; i < song_ids.size(); ++i) {
+            update.bind(1, keys[i]);
+            update.bind(2, playlist_id);
+            update.bind(3, song_ids[i]);
+            update.exec();
+            update.reset();
         }
 
-        return songs;
+        transaction.commit();
+        return song_ids.size();
     }
 }  // namespace core
@@ -7,6 +7,9 @@
 #include "core/bd/UserRepository.hpp"
 #include "core/entities/Artist.hpp"
 #include "core/entities/Song.hpp"
+#include "core/util/Collation.hpp"
+#include "core/util/LoudnessMeter.hpp"
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -25,6 +28,11 @@
     bitrate INTEGER,
     sample_rate INTEGER,
     play_count INTEGER DEFAULT 0,
+    replay_gain REAL,
+    replay_gain_peak REAL,
+    integrated_loudness REAL,
+    true_peak REAL,
+    analyzed_at DATETIME,
     created_at DATETIME DEFAULT CURRENT_TIMESTAMP,
     user_id INTEGER NOT NULL,
     FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE,
@@ -35,13 +43,35 @@
 
 namespace core {
 
+    void SongRepository::bindReplayGain(SQLite::Statement &query, int index, const Song &entity) {
+        if (entity.hasReplayGain()) {
+            query.bind(index, static_cast<double>(entity.getReplayGain()));
+            query.bind(index + 1, static_cast<double>(entity.getReplayGainPeak()));
+        } else {
+            query.bind(index);
+            query.bind(index + 1);
+        }
+    }
+
     SongRepository::SongRepository(std::shared_ptr<SQLite::Database> db)
         : SQLiteRepositoryBase<Song>(db, "songs") {
+        // os loaders guardam o banco, não o repositório
+        _artists = std::make_shared<ArtistLoader>([db](const std::vector<unsigned> &ids) {
+            return ArtistRepository(db).findByIds(ids);
+        });
+        _albums = std::make_shared<AlbumLoader>([db](const std::vector<unsigned> &ids) {
+            return AlbumRepository(db).findByIds(ids);
+        });
+        _featuring = std::make_shared<ArtistListLoader>([db](const std::vector<unsigned> &ids) {
+            return ArtistRepository(db).findFeaturingBySongs(ids);
+        });
+        _artistCache = std::make_shared<EntityCache<Artist>>();
+        _albumCache = std::make_shared<EntityCache<Album>>();
     }
 
     bool SongRepository::insert(Song &entity) {
-        std::string sql = "INSERT INTO " + _table_name + " (title, duration, track_number, artist_id, album_id, user_id, release_year) "
-                                                    "VALUES (?, ?, ?, ?, ?, ?, ?);";
+        std::string sql = "INSERT INTO " + _table_name + " (title, duration, track_number, artist_id, album_id, user_id, release_year, replay_gain, replay_gain_peak, title_key) "
+                                                    "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, entity.getTitle());
@@ -51,6 +81,8 @@ namespace core {
         query.bind(5, entity.getAlbumId());
         query.bind(6, entity.getUser()->getId());
         query.bind(7, entity.getYear());
+        bindReplayGain(query, 8, entity);
+        query.bind(10, collationKey(entity.getTitle()));
 
         bool success = query.exec() > 0;
 
@@ -61,51 +93,90 @@ namespace core {
     };
 
     bool SongRepository::update(const Song &entity) {
-        std::string sql = "UPDATE " + _table_name + " SET title = ?, artist_id = ?, user_id = ? "
+        std::string sql = "UPDATE " + _table_name + " SET title = ?, artist_id = ?, user_id = ?, "
+                                                    "replay_gain = ?, replay_gain_peak = ?, title_key = ? "
                                                     "WHERE id = ?;"; // nao faz sentido trocar duration
 
         SQLite::Statement query = prepare(sql);
         query.bind(1, entity.getTitle());
         query.bind(2, entity.getArtistId());
         query.bind(3, entity.getUser()->getId());
+        bindReplayGain(query, 4, entity);
+        query.bind(6, collationKey(entity.getTitle()));
+        query.bind(7, entity.getId());
 
         return query.exec() > 0;
     };
 
     std::shared_ptr<Song> SongRepository::mapRowToEntity(SQLite::Statement &query) const {
+        auto user_repo = UserRepository(_db);
+        auto user = user_repo.findById(query.getColumn("user_id").getInt());
+        return mapRowToEntity(query, *user);
+    }
+
+    std::shared_ptr<Song> SongRepository::mapRowToEntity(SQLite::Statement &query, const User &user) const {
         unsigned id = query.getColumn("id").getInt();
         std::string title = query.getColumn("title").getString();
         unsigned duration = query.getColumn("duration").getInt();
         unsigned track_number = query.getColumn("track_number").getInt();
         unsigned artist_id = query.getColumn("artist_id").getInt();
-        unsigned user_id = query.getColumn("user_id").getInt();
+        unsigned album_id = query.getColumn("album_id").getInt();
         int year = query.getColumn("release_year").getInt();
 
-        auto song = std::make_shared<Song>(id, title, artist_id, user_id);
+        auto song = std::make_shared<Song>(id, title, artist_id, album_id);
         song->setDuration(duration);
         song->setTrackNumber(track_number);
         song->setYear(year);
+        song->setDataCriacao(readCreatedAt(query));
 
-        auto artistLoader = [this, song]() -> std::shared_ptr<Artist> {
-            return this->getArtist(*song);
+        if (!query.getColumn("replay_gain").isNull()) {
+            float peak = query.getColumn("replay_gain_peak").isNull()
+                             ? 1.0f
+                             : static_cast<float>(query.getColumn("replay_gain_peak").getDouble());
+            song->setReplayGain(static_cast<float>(query.getColumn("replay_gain").getDouble()), peak);
+        }
+
+        // as chaves entram no lote; o primeiro acesso resolve todas de uma vez.
+        // Relações que a sessão já guarda não voltam ao lote.
+        auto artists = _artists;
+        auto albums = _albums;
+        auto featuring = _featuring;
+        if (artist_id > 0 && !_artistCache->contains(artist_id))
+            artists->enqueue(artist_id);
+        if (album_id > 0 && !_albumCache->contains(album_id))
+            albums->enqueue(album_id);
+        featuring->enqueue(id);
+
+        std::weak_ptr<EntityCache<Artist>> artistCache = _artistCache;
+        std::weak_ptr<EntityCache<Album>> albumCache = _albumCache;
+
+        auto artistLoader = [artists, artistCache, artist_id]() -> std::shared_ptr<Artist> {
+            if (artist_id == 0)
+                return nullptr;
+            auto fetch = [&artists](unsigned key) { return artists->load(key); };
+            if (auto cache = artistCache.lock())
+                return cache->get(artist_id, fetch);
+            return fetch(artist_id);
         };
 
-        auto featuringArtistsLoader = [this, id]() -> std::vector<std::shared_ptr<Artist>> {
-            Song tempSong;
-            tempSong.setId(id);
-            return this->getFeaturingArtists(tempSong);
+        auto featuringArtistsLoader = [featuring, id]() -> std::vector<std::shared_ptr<Artist>> {
+            return featuring->load(id);
         };
 
-        auto albumLoader = [this, song]() -> std::shared_ptr<Album> {
-            return this->getAlbum(*song);
+        auto albumLoader = [albums, albumCache, album_id]() -> std::shared_ptr<Album> {
+            if (album_id == 0)
+                return nullptr;
+            auto fetch = [&albums](unsigned key) { return albums->load(key); };
+            if (auto cache = albumCache.lock())
+                return cache->get(album_id, fetch);
+            return fetch(album_id);
         };
 
         song->setArtistLoader(artistLoader);
         song->setFeaturingArtistsLoader(featuringArtistsLoader);
         song->setAlbumLoader(albumLoader);
 
-        auto user_repo = UserRepository(_db);
-        song->setUser(*user_repo.findById(user_id));
+        song->setUser(user);
 
         return song;
     }
@@ -130,11 +201,34 @@ namespace core {
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByTitleAndUser(const std::string &title,
                                        const User &user) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE title LIKE ? AND user_id = ? ORDER BY title;";
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? AND title_key LIKE ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
-        query.bind(1, "%" + title + "%"); // "%" nao considera char especial
-        query.bind(2, user.getId());
+        query.bind(1, user.getId());
+        query.bind(2, "%" + collationKey(title) + "%"); // "%" nao considera char especial
+
+        std::vector<std::shared_ptr<Song>> songs;
+        while (query.executeStep()) {
+            songs.push_back(mapRowToEntity(query));
+        }
+
+        return songs;
+    }
+
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::findByTitlePrefix(const std::string &prefix, const User &user) const {
+        std::string key = collationKey(prefix);
+        std::string end = collationPrefixEnd(key);
+
+        // intervalo sobre o índice (user_id, title_key), já na ordem da chave
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? AND title_key >= ?"
+                          + (end.empty() ? "" : " AND title_key < ?") + " ORDER BY title_key;";
+
+        SQLite::Statement query = prepare(sql);
+        query.bind(1, user.getId());
+        query.bind(2, key);
+        if (!end.empty())
+            query.bind(3, end);
 
         std::vector<std::shared_ptr<Song>> songs;
         while (query.executeStep()) {
@@ -147,7 +241,7 @@ namespace core {
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByUser(const User &user) const {
 
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? ORDER BY title;";
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE user_id = ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
 
@@ -162,10 +256,129 @@ namespace core {
         return songs;
     };
 
+    std::unordered_set<unsigned> SongRepository::findAllIds() const {
+        SQLite::Statement query = prepare("SELECT id FROM " + _table_name + ";");
+
+        std::unordered_set<unsigned> ids;
+        while (query.executeStep()) {
+            ids.insert(static_cast<unsigned>(query.getColumn(0).getInt()));
+        }
+
+        return ids;
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+    SongRepository::mapRowsByOwner(SQLite::Statement &query) const {
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>> songs;
+        while (query.executeStep()) {
+            unsigned owner_id = query.getColumn("owner_id").getUInt();
+            songs[owner_id].push_back(mapRowToEntity(query));
+        }
+
+        return songs;
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+    SongRepository::findByAlbums(const std::vector<unsigned> &album_ids) const {
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>> songs;
+
+        for (size_t begin = 0; begin < album_ids.size(); begin += BATCH_LOADER_MAX_KEYS_DEFAULT) {
+            size_t count = std::min<size_t>(BATCH_LOADER_MAX_KEYS_DEFAULT, album_ids.size() - begin);
+            std::string sql = "SELECT album_id AS owner_id, * FROM " + _table_name +
+                              " WHERE album_id IN (" + sqlPlaceholders(count) + ")"
+                              " ORDER BY album_id, title_key;";
+
+            SQLite::Statement query = prepare(sql);
+            for (size_t i = 0; i < count; ++i)
+                query.bind(static_cast<int>(i + 1), album_ids[begin + i]);
+
+            songs.merge(mapRowsByOwner(query));
+        }
+
+        return songs;
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+    SongRepository::findByPlaylists(const std::vector<unsigned> &playlist_ids) const {
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>> songs;
+
+        for (size_t begin = 0; begin < playlist_ids.size(); begin += BATCH_LOADER_MAX_KEYS_DEFAULT) {
+            size_t count = std::min<size_t>(BATCH_LOADER_MAX_KEYS_DEFAULT, playlist_ids.size() - begin);
+            // artista e álbum vêm na mesma linha; ordem pelo índice (playlist_id, position)
+            std::string sql = "SELECT ps.playlist_id AS owner_id, s.*, "
+                              "ar.id AS \"artist.id\", ar.name AS \"artist.name\", "
+                              "ar.user_id AS \"artist.user_id\", "
+                              "ar.song_count AS \"artist.song_count\", "
+                              "ar.total_duration AS \"artist.total_duration\", "
+                              "ar.created_at AS \"artist.created_at\", "
+                              "al.id AS \"album.id\", al.title AS \"album.title\", "
+                              "al.release_year AS \"album.release_year\", al.genre AS \"album.genre\", "
+                              "al.user_id AS \"album.user_id\", "
+                              "al.song_count AS \"album.song_count\", "
+                              "al.total_duration AS \"album.total_duration\", "
+                              "al.created_at AS \"album.created_at\" "
+                              "FROM playlist_songs ps "
+                              "JOIN " + _table_name + " s ON s.id = ps.song_id "
+                              "LEFT JOIN artists ar ON ar.id = s.artist_id "
+                              "LEFT JOIN albums al ON al.id = s.album_id "
+                              "WHERE ps.playlist_id IN (" + sqlPlaceholders(count) + ") "
+                              "ORDER BY ps.playlist_id, ps.position;";
+
+            SQLite::Statement query = prepare(sql);
+            for (size_t i = 0; i < count; ++i)
+                query.bind(static_cast<int>(i + 1), playlist_ids[begin + i]);
+
+            songs.merge(mapHydratedRowsByOwner(query));
+        }
+
+        return songs;
+    }
+
+    std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>>
+    SongRepository::mapHydratedRowsByOwner(SQLite::Statement &query) const {
+        ArtistRepository artist_repo(_db);
+        AlbumRepository album_repo(_db);
+        UserRepository user_repo(_db);
+        std::unordered_map<unsigned, std::shared_ptr<User>> users;
+
+        std::unordered_map<unsigned, std::vector<std::shared_ptr<Song>>> songs;
+        while (query.executeStep()) {
+            unsigned user_id = query.getColumn("user_id").getUInt();
+            auto &user = users[user_id];
+            if (!user)
+                user = user_repo.findById(user_id);
+
+            // a sessão reaproveita a instância já carregada, se houver
+            std::shared_ptr<Artist> artist;
+            if (!query.getColumn("artist.id").isNull()) {
+                artist = _artistCache->get(query.getColumn("artist.id").getUInt(), [&](unsigned) {
+                    return artist_repo.mapJoinedRow(query, "artist.");
+                });
+            }
+            std::shared_ptr<Album> album;
+            if (!query.getColumn("album.id").isNull()) {
+                album = _albumCache->get(query.getColumn("album.id").getUInt(), [&](unsigned) {
+                    return album_repo.mapJoinedRow(query, "album.");
+                });
+            }
+
+            auto song = mapRowToEntity(query, *user);
+            // a música segura as relações: continuam válidas depois do repositório
+            if (artist)
+                song->setArtistLoader([artist]() { return artist; });
+            if (album)
+                song->setAlbumLoader([album]() { return album; });
+
+            songs[query.getColumn("owner_id").getUInt()].push_back(song);
+        }
+
+        return songs;
+    }
+
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByArtist(const Artist &artist) const {
 
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE artist_id = ? ORDER BY title;";
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE artist_id = ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
 
@@ -182,7 +395,7 @@ namespace core {
 
     std::vector<std::shared_ptr<Song>>
     SongRepository::findByAlbum(const Album &album) const {
-        std::string sql = "SELECT * FROM " + _table_name + " WHERE album_id = ? ORDER BY title;";
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE album_id = ? ORDER BY title_key;";
 
         SQLite::Statement query = prepare(sql);
 
@@ -316,4 +529,110 @@ namespace core {
         return insert_query.exec() > 0;
     }
 
+    std::vector<std::shared_ptr<Song>>
+    SongRepository::findPendingAnalysis(unsigned after_id, size_t limit) const {
+        std::string sql = "SELECT * FROM " + _table_name + " WHERE id > ? AND ((analyzed_at IS NULL AND replay_gain IS NULL) "
+                                                           "OR id NOT IN (SELECT song_id FROM song_waveforms)) "
+                                                           "ORDER BY id LIMIT ?;";
+
+        SQLite::Statement query = prepare(sql);
+        query.bind(1, after_id);
+        query.bind(2, static_cast<long long>(limit));
+
+        std::vector<std::shared_ptr<Song>> songs;
+        while (query.executeStep()) {
+            songs.push_back(mapRowToEntity(query));
+        }
+
+        return songs;
+    }
+
+    bool SongRepository::saveLoudnessAnalyses(const std::vector<LoudnessAnalysis> &results) {
+        if (results.empty())
+            return true;
+
+        SQLite::Transaction transaction(*_db);
+
+        SQLite::Statement analyzed = prepare("UPDATE " + _table_name + " SET integrated_loudness = ?, true_peak = ?, "
+                                                                       "replay_gain = ?, replay_gain_peak = ?, "
+                                                                       "analyzed_at = CURRENT_TIMESTAMP WHERE id = ?;");
+        SQLite::Statement failed = prepare("UPDATE " + _table_name + " SET analyzed_at = CURRENT_TIMESTAMP WHERE id = ?;");
+
+        for (const auto &result : results) {
+            if (result.success) {
+                analyzed.bind(1, result.integrated_loudness);
+                analyzed.bind(2, static_cast<double>(result.true_peak));
+                analyzed.bind(3, REPLAY_GAIN_REFERENCE_LUFS - result.integrated_loudness);
+                analyzed.bind(4, static_cast<double>(result.true_peak));
+                analyzed.bind(5, result.song_id);
+                analyzed.exec();
+                analyzed.reset();
+            } else {
+                failed.bind(1, result.song_id);
+                failed.exec();
+                failed.reset();
+            }
+        }
+
+        transaction.commit();
+        return true;
+    }
+
+    bool SongRepository::saveWaveforms(const std::vector<WaveformSummary> &waveforms) {
+        if (waveforms.empty())
+            return true;
+
+        SQLite::Transaction transaction(*_db);
+
+        SQLite::Statement query = prepare("INSERT OR REPLACE INTO song_waveforms (song_id, buckets, peaks, rms) "
+                                          "VALUES (?, ?, ?, ?);");
+
+        for (const auto &waveform : waveforms) {
+            query.bind(1, waveform.song_id);
+            query.bind(2, static_cast<long long>(waveform.buckets()));
+            if (waveform.empty()) {
+                query.bind(3);
+                query.bind(4);
+            } else {
+                query.bind(3, waveform.peaks.data(), static_cast<int>(waveform.peaks.size()));
+                query.bind(4, waveform.rms.data(), static_cast<int>(waveform.rms.size()));
+            }
+            query.exec();
+            query.reset();
+        }
+
+        transaction.commit();
+        return true;
+    }
+
+    std::shared_ptr<WaveformSummary> SongRepository::findWaveform(unsigned song_id) const {
+        SQLite::Statement query = prepare("SELECT peaks, rms FROM song_waveforms WHERE song_id = ?;");
+        query.bind(1, song_id);
+
+        if (!query.executeStep())
+            return nullptr;
+
+        auto waveform = std::make_shared<WaveformSummary>();
+        waveform->song_id = song_id;
+
+        for (int column = 0; column < 2; ++column) {
+            SQLite::Column blob = query.getColumn(column);
+            if (blob.isNull())
+                continue;
+
+            auto data = static_cast<const uint8_t *>(blob.getBlob());
+            auto &target = column == 0 ? waveform->peaks : waveform->rms;
+            target.assign(data, data + blob.getBytes());
+        }
+
+        return waveform;
+    }
+
+    void SongRepository::clearRelationCache() {
+        _artistCache->clear();
+        _albumCache->clear();
+        _artists->clear();
+        _albums->clear();
+    }
+
 } // namespace core
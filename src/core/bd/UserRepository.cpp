@@ -100,6 +100,8 @@ namespace core {
             uid = static_cast<userid>(std::stoul(query.getColumn("uid").getString()));
         #endif
 
-        return std::make_shared<User>(id, username, home_path, input_path, uid);
+        auto user = std::make_shared<User>(id, username, home_path, input_path, uid);
+        user->setDataCriacao(readCreatedAt(query));
+        return user;
     }
 }
@@ -4,6 +4,7 @@
 #include "core/entities/Artist.hpp"
 #include "core/entities/User.hpp"
 #include <cstddef>
+#include <iostream>
 #include <memory>
 #include <stdexcept>
 #include <vector>
@@ -63,8 +64,8 @@ namespace core {
     };
 
     std::shared_ptr<const Artist> Album::getArtist() const {
-        if (!_artist.expired())
-            return std::const_pointer_cast<const Artist>(_artist.lock());
+        if (auto artist = _artist.lock())
+            return std::const_pointer_cast<const Artist>(artist);
 
         auto artist = artistLoader();
         _artist = artist;
@@ -109,7 +110,16 @@ namespace core {
     };
 
     size_t Album::getSongsCount() const {
-        return static_cast<int>(loadSongs().size());
+        if (!_songsLoaded && _hasTotals)
+            return _totals.songs;
+
+        return loadSongs().size();
+    };
+
+    void Album::setTotals(const CollectionTotals &totals) {
+        _hasTotals = true;
+        if (!_songsLoaded)
+            _totals = totals;
     };
 
     bool Album::isSongsLoaded() const {
@@ -127,8 +137,13 @@ namespace core {
             _songs = songsLoader();
             _songsLoaded = true;
             _song_ids.clear();
-            for (const auto &s : _songs)
-                if (s) _song_ids.insert(s->getId());
+            _totals = CollectionTotals();
+            for (const auto &s : _songs) {
+                if (!s)
+                    continue;
+                _song_ids.insert(s->getId());
+                _totals.add(s->getDuration());
+            }
         }
 
         return _songs;
@@ -231,7 +246,7 @@ namespace core {
         if (otherAlbum == nullptr) {
             throw std::invalid_argument("Erro no casting");
         }
-        if (this->getArtist() == otherAlbum->getArtist())
+        if (_artist_id == otherAlbum->_artist_id)
             return this->getYear() < otherAlbum->getYear();
         return this->getTitle() < otherAlbum->getTitle();
     };
@@ -247,7 +262,7 @@ namespace core {
         if (otherAlbum == nullptr) {
             throw std::invalid_argument("Erro no casting");
         }
-        if (this->getArtist() == otherAlbum->getArtist())
+        if (_artist_id == otherAlbum->_artist_id)
             return this->getYear() > otherAlbum->getYear();
         return this->getTitle() > otherAlbum->getTitle();
     };
@@ -290,6 +305,7 @@ namespace core {
         if (containsSong(song))
             return;
         _songs.push_back(std::make_shared<Song>(song));
+        _totals.add(song.getDuration());
     };
 
     bool Album::removeSong(unsigned id) {
@@ -300,6 +316,7 @@ namespace core {
         if (it == _songs.end())
             return false;
 
+        _totals.remove((*it)->getDuration());
         _songs.erase(it);
         return true;
     };
@@ -330,12 +347,11 @@ namespace core {
     };
 
     unsigned Album::calculateTotalDuration() {
+        if (!_songsLoaded && _hasTotals)
+            return _totals.duration;
+
         loadSongs();
-        int totalSeconds = 0;
-        for (auto const &s : _songs) {
-            totalSeconds += s->getDuration();
-        }
-        return totalSeconds;
+        return _totals.duration;
     };
 
     bool Album::containsSong(unsigned songId) const {
@@ -39,8 +39,13 @@ namespace core {
             _songs = songsLoader();
             _songsLoaded = true;
             _song_ids.clear();
-            for (const auto &s : _songs)
-                if (s) _song_ids.insert(s->getId());
+            _totals = CollectionTotals();
+            for (const auto &s : _songs) {
+                if (!s)
+                    continue;
+                _song_ids.insert(s->getId());
+                _totals.add(s->getDuration());
+            }
         }
 
         return _songs;
@@ -90,10 +95,16 @@ namespace core {
     };
 
     size_t Artist::getSongsCount() const {
-        if (!_songsLoaded)
-            loadSongs();
+        if (!_songsLoaded && _hasTotals)
+            return _totals.songs;
 
-        return getSongs().size();
+        return loadSongs().size();
+    };
+
+    void Artist::setTotals(const CollectionTotals &totals) {
+        _hasTotals = true;
+        if (!_songsLoaded)
+            _totals = totals;
     };
 
     size_t Artist::getAlbumsCount() const {
@@ -143,6 +154,7 @@ namespace core {
             return;
 
         _songs.push_back(std::make_shared<Song>(song));
+        _totals.add(song.getDuration());
     };
 
     void Artist::addAlbum(const Album &album) {
@@ -356,6 +368,7 @@ namespace core {
         if (it == _songs.end())
             return false;
 
+        _totals.remove((*it)->getDuration());
         _songs.erase(it);
         return true;
     }
@@ -394,12 +407,11 @@ namespace core {
     };
 
     unsigned Artist::calculateTotalDuration() {
+        if (!_songsLoaded && _hasTotals)
+            return _totals.duration;
+
         loadSongs();
-        unsigned totalSeconds = 0;
-        for (auto const &s : _songs) {
-            totalSeconds += s->getDuration();
-        }
-        return totalSeconds;
+        return _totals.duration;
     }
 
     void Artist::setSongsLoader(const std::function<std::vector<std::shared_ptr<Song>>()> &loader) {
@@ -9,6 +9,7 @@
 
 #include "core/entities/HistoryPlayback.hpp"
 #include <string>
+#include <utility>
 
 namespace core {
     HistoryPlayback::HistoryPlayback() :
@@ -48,6 +49,15 @@ namespace core {
         _song(std::make_shared<Song>(song)),
         _played_at(played_at) {}
 
+    HistoryPlayback::HistoryPlayback(unsigned id,
+                                     std::shared_ptr<User> user,
+                                     std::shared_ptr<Song> song,
+                                     std::time_t played_at) :
+        Entity(id),
+        _user(std::move(user)),
+        _song(std::move(song)),
+        _played_at(played_at) {}
+
     std::shared_ptr<const User> HistoryPlayback::getUser() const {
         return _user;
     }
@@ -72,6 +82,14 @@ namespace core {
         _played_at = played_at;
     }
 
+    unsigned HistoryPlayback::getPlayDuration() const {
+        return _play_duration;
+    }
+
+    void HistoryPlayback::setPlayDuration(unsigned seconds) {
+        _play_duration = seconds;
+    }
+
     std::string HistoryPlayback::toString() const {
         return "HistoryPlayback{id=" + std::to_string(getId()) +
                ", user=" + (_user ? std::to_string(_user->getId()) : "null") +
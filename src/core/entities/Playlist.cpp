@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 
@@ -70,7 +71,7 @@ namespace core {
         return *this < other || *this == other;
     }
 
-    std::vector<std::shared_ptr<Song>> Playlist::loadSongs() const {
+    const std::vector<std::shared_ptr<Song>> &Playlist::loadSongs() const {
         if (!_loader) {
             throw std::runtime_error("Songs loader nao foi definido");
         }
@@ -78,25 +79,55 @@ namespace core {
         if (!_songsLoaded) {
             _songs = _loader();
             _songsLoaded = true;
-        }
 
-        _song_ids.clear();
-        for (const auto& song : _songs)
-            if (song) _song_ids.insert(song->getId());
+            _positions.clear();
+            _positions.reserve(_songs.size());
+            _totals = CollectionTotals();
+            for (size_t i = 0; i < _songs.size(); ++i) {
+                if (!_songs[i])
+                    continue;
+                _positions[_songs[i]->getId()] = i;
+                _totals.add(_songs[i]->getDuration());
+            }
+            _indexed = _songs.size();
+        }
 
         return _songs;
     }
 
-	std::vector<std::shared_ptr<Song>> Playlist::getSongs() const {
+    size_t Playlist::indexOf(unsigned songId) const {
         loadSongs();
 
-        std::vector<std::shared_ptr<Song>> v;
-        v.reserve(_songs.size() + 5);
+        auto it = _positions.find(songId);
+        if (it == _positions.end())
+            return _songs.size();
 
-        for (auto const &s : _songs)
-            v.push_back(s);
+        if (it->second >= _indexed) {
+            // só as chaves já existentes mudam de valor: it continua válido
+            for (size_t i = _indexed; i < _songs.size(); ++i)
+                if (_songs[i]) _positions[_songs[i]->getId()] = i;
+            _indexed = _songs.size();
+        }
+
+        return it->second;
+    }
 
-        return v;
+    void Playlist::insertAt(size_t pos, const std::shared_ptr<Song> &song) {
+        _songs.insert(_songs.begin() + static_cast<std::ptrdiff_t>(pos), song);
+        _positions[song->getId()] = pos;
+        _indexed = std::min(_indexed, pos);
+        _totals.add(song->getDuration());
+    }
+
+    void Playlist::eraseAt(size_t pos) {
+        _positions.erase(_songs[pos]->getId());
+        _totals.remove(_songs[pos]->getDuration());
+        _songs.erase(_songs.begin() + static_cast<std::ptrdiff_t>(pos));
+        _indexed = std::min(_indexed, pos);
+    }
+
+	std::vector<std::shared_ptr<Song>> Playlist::getSongs() const {
+        return loadSongs();
 	}
 
 	void Playlist::setSongsLoader(
@@ -107,38 +138,26 @@ namespace core {
 	}
 
 	void Playlist::addSong(const Song& song) {
-	    loadSongs();
-
-		if (_song_ids.find(song.getId()) != _song_ids.end())
+		if (containsSong(song.getId()))
             return;
 
-		_songs.push_back(std::make_shared<Song>(song));
+		insertAt(_songs.size(), std::make_shared<Song>(song));
+		markInserted(song.getId());
 	}
 
 	bool Playlist::removeSong(unsigned id) {
-	    loadSongs();
-	    for (size_t i = 0; i < _songs.size(); i++) {
-            if (_songs[i]->getId() == id) {
-                _songs.erase(_songs.begin() + static_cast<int>(i));
-                _song_ids.erase(id);
-                return true;
-            }
-        }
-        return false;
+	    size_t index = indexOf(id);
+	    if (index == _songs.size())
+	        return false;
+
+	    eraseAt(index);
+	    markRemoved(id);
+	    return true;
 	}
 
 	std::shared_ptr<Song> Playlist::findSongById(unsigned songId) {
-        loadSongs();
-
-        if (_song_ids.find(songId) == _song_ids.end())
-            return nullptr;
-
-        auto it = std::find_if(_songs.begin(), _songs.end(),
-                               [songId](const std::shared_ptr<Song>& song) {
-                                   return song->getId() == songId;
-                               });
-
-        return (it != _songs.end()) ? *it : nullptr;
+        size_t index = indexOf(songId);
+        return index < _songs.size() ? _songs[index] : nullptr;
 	}
 
 	std::vector<std::shared_ptr<Song>> Playlist::findSongByTitle(const std::string& title) {
@@ -153,20 +172,26 @@ namespace core {
 	}
 
 	size_t Playlist::getSongsCount() const {
-        loadSongs();
-        return _songs.size();
-	}
+        if (!_songsLoaded && _hasTotals)
+            return _totals.songs;
 
-	unsigned Playlist::calculateTotalDuration() {
-	    loadSongs();
-		int total = 0;
-		for (const auto& s : _songs) {
-			if (!s) continue;
-			total += s->getDuration();
-		}
-		return total;
+        return loadSongs().size();
 	}
 
+    void Playlist::setTotals(const CollectionTotals &totals) {
+        _hasTotals = true;
+        if (!_songsLoaded)
+            _totals = totals;
+    }
+
+    unsigned Playlist::calculateTotalDuration() {
+        if (!_songsLoaded && _hasTotals)
+            return _totals.duration;
+
+        loadSongs();
+        return _totals.duration;
+    }
+
 	std::shared_ptr<Song> Playlist::getSongAt(int index) {
         loadSongs();
 
@@ -205,7 +230,7 @@ namespace core {
 
 	bool Playlist::containsSong(unsigned songId) const {
         loadSongs();
-        return _song_ids.find(songId) != _song_ids.end();
+        return _positions.find(songId) != _positions.end();
     }
 
     bool Playlist::containsSong(const Song& song) const {
@@ -221,8 +246,8 @@ namespace core {
         if (pos > _songs.size())
             pos = _songs.size();
 
-        _songs.insert(_songs.begin() + static_cast<int>(pos),
-                      std::make_shared<Song>(song));
+        insertAt(pos, std::make_shared<Song>(song));
+        markInserted(song.getId());
         return true;
 	}
 
@@ -235,12 +260,10 @@ namespace core {
 
         if (pos > _songs.size())
             pos = _songs.size();
-        auto it_pos = _songs.begin() + static_cast<int>(pos);
-
         for (const auto& song : albumSongs) {
             if (song && !containsSong(song->getId())) {
-                it_pos = _songs.insert(it_pos, song);
-                ++it_pos;
+                insertAt(pos++, song);
+                markInserted(song->getId());
                 inserted = true;
             }
         }
@@ -257,12 +280,10 @@ namespace core {
         if (pos > _songs.size())
             pos = _songs.size();
 
-        auto it_pos = _songs.begin() + static_cast<int>(pos);
-
         for (const auto& song : artistSongs) {
             if (song && !containsSong(song->getId())) {
-                it_pos = _songs.insert(it_pos, song);
-                ++it_pos;
+                insertAt(pos++, song);
+                markInserted(song->getId());
                 inserted = true;
             }
         }
@@ -278,12 +299,10 @@ namespace core {
         if (pos > _songs.size())
             pos = _songs.size();
 
-        auto it_pos = _songs.begin() + static_cast<int>(pos);
-
         for (const auto& song : songs) {
             if (song && !containsSong(song->getId())) {
-                it_pos = _songs.insert(it_pos, song);
-                ++it_pos;
+                insertAt(pos++, song);
+                markInserted(song->getId());
                 inserted = true;
             }
         }
@@ -300,12 +319,10 @@ namespace core {
         if (pos > _songs.size())
             pos = _songs.size();
 
-        auto it_pos = _songs.begin() + static_cast<int>(pos);
-
         for (const auto& song : playlistSongs) {
             if (song && !containsSong(song->getId())) {
-                _songs.insert(it_pos, song);
-                it_pos++;
+                insertAt(pos++, song);
+                markInserted(song->getId());
                 inserted = true;
             }
         }
@@ -314,23 +331,23 @@ namespace core {
     }
 
     bool Playlist::pushBack(const Song &song) {
-        return insert(song, _songs.size());
+        return insert(song, getSongsCount());
     }
 
     bool Playlist::pushBack(const Album &album) {
-        return insert(album, _songs.size());
+        return insert(album, getSongsCount());
     }
 
     bool Playlist::pushBack(const Artist &artist) {
-        return insert(artist, _songs.size());
+        return insert(artist, getSongsCount());
     }
 
     bool Playlist::pushBack(const std::vector<std::shared_ptr<Song>> &songs) {
-        return insert(songs, _songs.size());
+        return insert(songs, getSongsCount());
     }
 
     bool Playlist::pushBack(const Playlist &playlist) {
-        return insert(playlist, _songs.size());
+        return insert(playlist, getSongsCount());
     }
 
     bool Playlist::pushFront(const Song &song) {
@@ -352,4 +369,63 @@ namespace core {
     bool Playlist::pushFront(const Playlist &playlist) {
         return insert(playlist, 0);
     }
+
+    void Playlist::switchSong(unsigned id, unsigned index) {
+        size_t from = indexOf(id);
+        if (from == _songs.size())
+            throw std::invalid_argument("Música não está na playlist");
+
+        moveSong(static_cast<unsigned>(from), index);
+    }
+
+    void Playlist::moveSong(unsigned fromIndex, unsigned toIndex) {
+        loadSongs();
+
+        if (fromIndex >= _songs.size() || toIndex >= _songs.size())
+            throw std::out_of_range("Índice fora dos limites");
+        if (fromIndex == toIndex)
+            return;
+
+        // só a música movida muda de posição; as outras mantêm a ordem relativa
+        auto from = _songs.begin() + fromIndex;
+        auto to = _songs.begin() + toIndex;
+        if (fromIndex < toIndex)
+            std::rotate(from, from + 1, to + 1);
+        else
+            std::rotate(to, from, from + 1);
+        _indexed = std::min<size_t>(_indexed, std::min(fromIndex, toIndex));
+
+        markMoved(_songs[toIndex]->getId());
+    }
+
+    void Playlist::markInserted(unsigned songId) {
+        // removida e adicionada de novo: a linha ainda existe, só muda de lugar
+        if (_changes.removed.erase(songId))
+            _changes.moved.insert(songId);
+        else
+            _changes.inserted.insert(songId);
+    }
+
+    void Playlist::markRemoved(unsigned songId) {
+        _changes.moved.erase(songId);
+        if (!_changes.inserted.erase(songId))
+            _changes.removed.insert(songId);
+    }
+
+    void Playlist::markMoved(unsigned songId) {
+        if (!_changes.inserted.count(songId))
+            _changes.moved.insert(songId);
+    }
+
+    const PlaylistChanges &Playlist::getChanges() const {
+        return _changes;
+    }
+
+    bool Playlist::hasChanges() const {
+        return !_changes.empty();
+    }
+
+    void Playlist::clearChanges() {
+        _changes = PlaylistChanges();
+    }
 }
@@ -6,9 +6,12 @@
 #include "core/entities/Artist.hpp"
 #include "core/entities/Entity.hpp"
 #include "core/entities/User.hpp"
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <miniaudio.h>
 #include <string>
+#include <tuple>
 #include <taglib/fileref.h>
 #include <taglib/tag.h>
 #include <taglib/tpropertymap.h>
@@ -60,8 +63,8 @@ namespace core {
     };
 
     std::shared_ptr<const Artist> Song::getArtist() const {
-        if (!_artist.expired())
-            return std::const_pointer_cast<const Artist>(_artist.lock());
+        if (auto artist = _artist.lock())
+            return std::const_pointer_cast<const Artist>(artist);
 
         if (!artistLoader)
             throw std::runtime_error("Artist loader nao foi definido");
@@ -116,8 +119,8 @@ namespace core {
     };
 
     std::shared_ptr<const Album> Song::getAlbum() const {
-        if (!_album.expired())
-            return std::const_pointer_cast<const Album>(_album.lock());
+        if (auto album = _album.lock())
+            return std::const_pointer_cast<const Album>(album);
 
         if (!albumLoader)
             throw std::runtime_error("Album loader nao foi definido");
@@ -213,6 +216,31 @@ namespace core {
         _duration = sec;
     };
 
+    void Song::setReplayGain(float gain_db, float peak) {
+        _has_replay_gain = true;
+        _replay_gain = gain_db;
+        _replay_gain_peak = peak > 0.0f ? peak : 1.0f;
+
+        float factor = std::pow(10.0f, gain_db / 20.0f);
+        _gain_factor = std::min(factor, 1.0f / _replay_gain_peak);
+    };
+
+    bool Song::hasReplayGain() const {
+        return _has_replay_gain;
+    };
+
+    float Song::getReplayGain() const {
+        return _replay_gain;
+    };
+
+    float Song::getReplayGainPeak() const {
+        return _replay_gain_peak;
+    };
+
+    float Song::getGainFactor() const {
+        return _gain_factor;
+    };
+
     std::string Song::toString() const {
         std::string info = "{Musica: " + _title + ", Artista: " + getArtist()->getName() + ", Duracao: " + std::to_string(getDuration()) + ", Ano: " + std::to_string(_year) + "}";
         return info;
@@ -257,11 +285,7 @@ namespace core {
             throw std::invalid_argument("Erro no casting: objeto não é do tipo Song");
         }
 
-        if (this->getArtist() == otherSong->getArtist() &&
-            this->getAlbum() == otherSong->getAlbum())
-            return this->getTrackNumber() < otherSong->getTrackNumber();
-
-        return this->getTitle() < otherSong->getTitle();
+        return *this < *otherSong;
     };
 
     bool Song::operator<=(const Entity &other) const {
@@ -281,12 +305,7 @@ namespace core {
             throw std::invalid_argument("Erro no casting: objeto não é do tipo Song");
         }
 
-
-        if (this->getArtist() == otherSong->getArtist() &&
-            this->getAlbum() == otherSong->getAlbum())
-            return this->getTrackNumber() > otherSong->getTrackNumber();
-
-        return this->getTitle() > otherSong->getTitle();
+        return *this > *otherSong;
     };
 
     bool Song::operator>=(const Entity &other) const {
@@ -299,6 +318,16 @@ namespace core {
         return *this > *otherSong || *this == *otherSong;
     };
 
+    bool Song::operator<(const Song &other) const {
+        // pelos IDs: comparar não deve carregar artista nem álbum
+        return std::tie(_artist_id, _album_id, _track_number, _title)
+               < std::tie(other._artist_id, other._album_id, other._track_number, other._title);
+    }
+
+    bool Song::operator>(const Song &other) const {
+        return other < *this;
+    }
+
     std::string Song::getAudioFilePath() const {
         std::string path = _user->getHomePath() + getArtist()->getName() + "/";
         if (getAlbum())
@@ -9,6 +9,7 @@
 
 #include "core/entities/User.hpp"
 
+#include <stdexcept>
 
 namespace core {
     User::User() {};
@@ -0,0 +1,265 @@
+/**
+ * @file AudioAnalysisJob.cpp
+ * @brief Implementação do job de análise de áudio
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#include "core/services/AudioAnalysisJob.hpp"
+#include "core/util/LoudnessMeter.hpp"
+#include "core/util/Waveform.hpp"
+
+#include <miniaudio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#elif defined(_WIN32)
+    #include <windows.h>
+#endif
+
+namespace core {
+
+    static const ma_uint64 DECODE_CHUNK_FRAMES = 4096;
+
+    double AnalysisReport::tracksPerSecondPerCore() const {
+        if (elapsed_seconds <= 0.0 || workers == 0)
+            return 0.0;
+        return (analyzed + failed) / elapsed_seconds / workers;
+    }
+
+    AudioAnalysisJob::AudioAnalysisJob(std::shared_ptr<SongRepository> songRepo,
+                                       unsigned workers,
+                                       size_t batch_size)
+        : _songRepo(songRepo),
+          _workers(workers),
+          _batch_size(batch_size),
+          _stop_requested(false),
+          _running(false) {
+        if (!_songRepo)
+            throw std::invalid_argument("Repositório de músicas inválido");
+
+        if (_workers == 0)
+            _workers = std::max(1u, std::thread::hardware_concurrency());
+        if (_batch_size == 0)
+            _batch_size = 64;
+    }
+
+    AudioAnalysisJob::~AudioAnalysisJob() {
+        stop();
+    }
+
+    void AudioAnalysisJob::lowerCurrentThreadPriority() {
+#ifdef __linux__
+        // no Linux o nice é por thread (tid), não afeta o processo todo
+        setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+#elif defined(_WIN32)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#endif
+    }
+
+    LoudnessAnalysis AudioAnalysisJob::analyzeFile(const std::string &path,
+                                                   unsigned song_id,
+                                                   WaveformSummary *waveform) {
+        LoudnessAnalysis result;
+        result.song_id = song_id;
+        if (waveform) {
+            *waveform = WaveformSummary();
+            waveform->song_id = song_id;
+        }
+
+        // f32 no formato nativo do arquivo (canais e taxa originais)
+        ma_decoder_config config = ma_decoder_config_init(ma_format_f32, 0, 0);
+        ma_decoder decoder;
+        if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+            return result;
+
+        ma_uint32 channels = decoder.outputChannels;
+        ma_uint32 sampleRate = decoder.outputSampleRate;
+
+        try {
+            LoudnessMeter meter(sampleRate, channels);
+            WaveformBuilder builder(sampleRate, channels);
+            std::vector<float> buffer(DECODE_CHUNK_FRAMES * channels);
+            ma_uint64 totalFrames = 0;
+
+            while (true) {
+                ma_uint64 framesRead = 0;
+                ma_result status = ma_decoder_read_pcm_frames(&decoder, buffer.data(),
+                                                              DECODE_CHUNK_FRAMES, &framesRead);
+                if (framesRead > 0) {
+                    meter.addFrames(buffer.data(), static_cast<size_t>(framesRead));
+                    if (waveform)
+                        builder.addFrames(buffer.data(), static_cast<size_t>(framesRead));
+                    totalFrames += framesRead;
+                }
+                if (status != MA_SUCCESS || framesRead < DECODE_CHUNK_FRAMES)
+                    break;
+            }
+
+            result.success = totalFrames > 0;
+            result.integrated_loudness = meter.integratedLoudness();
+            result.true_peak = meter.truePeak();
+            result.duration = static_cast<double>(totalFrames) / sampleRate;
+
+            if (waveform) {
+                *waveform = builder.build();
+                waveform->song_id = song_id;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << "Erro ao analisar '" << path << "': " << e.what() << std::endl;
+            result.success = false;
+        }
+
+        ma_decoder_uninit(&decoder);
+        return result;
+    }
+
+    std::vector<AudioAnalysisJob::TaskResult>
+    AudioAnalysisJob::analyzeBatch(const std::vector<Task> &tasks) {
+        std::vector<TaskResult> results(tasks.size());
+        std::vector<char> done(tasks.size(), 0);
+        std::atomic<size_t> next(0);
+
+        auto worker = [&]() {
+            lowerCurrentThreadPriority();
+
+            while (!_stop_requested.load(std::memory_order_relaxed)) {
+                size_t index = next.fetch_add(1);
+                if (index >= tasks.size())
+                    break;
+
+                const Task &task = tasks[index];
+                results[index].loudness = task.loudness;
+                results[index].analysis = analyzeFile(task.path, task.song_id,
+                                                      &results[index].waveform);
+                done[index] = 1;
+            }
+        };
+
+        unsigned count = std::min<unsigned>(_workers, static_cast<unsigned>(tasks.size()));
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < count; ++i)
+            threads.emplace_back(worker);
+        for (auto &t : threads)
+            t.join();
+
+        std::vector<TaskResult> finished;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (done[i])
+                finished.push_back(results[i]);
+        }
+        return finished;
+    }
+
+    AnalysisReport AudioAnalysisJob::run(size_t limit) {
+        auto startTime = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(_report_mutex);
+            _report = AnalysisReport();
+            _report.workers = _workers;
+        }
+
+        unsigned lastId = 0;
+        size_t processed = 0;
+
+        while (!_stop_requested.load() && (limit == 0 || processed < limit)) {
+            size_t pageSize = limit == 0 ? _batch_size : std::min(_batch_size, limit - processed);
+            auto songs = _songRepo->findPendingAnalysis(lastId, pageSize);
+            if (songs.empty())
+                break;
+
+            lastId = songs.back()->getId();
+
+            std::vector<Task> tasks;
+            std::vector<TaskResult> unreadable;
+            for (const auto &song : songs) {
+                try {
+                    tasks.push_back({song->getId(), song->getAudioFilePath(), !song->hasReplayGain()});
+                } catch (const std::exception &e) {
+                    // sem usuário/artista não há como montar o caminho
+                    TaskResult failed;
+                    failed.loudness = true;
+                    failed.analysis.song_id = song->getId();
+                    failed.waveform.song_id = song->getId();
+                    unreadable.push_back(failed);
+                }
+            }
+
+            auto results = analyzeBatch(tasks);
+            results.insert(results.end(), unreadable.begin(), unreadable.end());
+
+            // ReplayGain das tags não é sobrescrito pela medição
+            std::vector<LoudnessAnalysis> analyses;
+            std::vector<WaveformSummary> waveforms;
+            for (const auto &result : results) {
+                if (result.loudness)
+                    analyses.push_back(result.analysis);
+                waveforms.push_back(result.waveform);
+            }
+            _songRepo->saveLoudnessAnalyses(analyses);
+            _songRepo->saveWaveforms(waveforms);
+
+            std::lock_guard<std::mutex> lock(_report_mutex);
+            for (const auto &entry : results) {
+                const LoudnessAnalysis &result = entry.analysis;
+                if (result.success) {
+                    ++_report.analyzed;
+                    _report.audio_seconds += result.duration;
+                } else {
+                    ++_report.failed;
+                }
+            }
+            processed += results.size();
+            _report.elapsed_seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - startTime).count();
+        }
+
+        std::lock_guard<std::mutex> lock(_report_mutex);
+        _report.elapsed_seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        return _report;
+    }
+
+    void AudioAnalysisJob::start(size_t limit) {
+        if (_running.load())
+            return;
+
+        if (_thread.joinable())
+            _thread.join();
+
+        _stop_requested.store(false);
+        _running.store(true);
+        _thread = std::thread([this, limit]() {
+            try {
+                run(limit);
+            } catch (const std::exception &e) {
+                std::cerr << "Erro na análise de áudio: " << e.what() << std::endl;
+            }
+            _running.store(false);
+        });
+    }
+
+    void AudioAnalysisJob::stop() {
+        _stop_requested.store(true);
+        if (_thread.joinable())
+            _thread.join();
+        _stop_requested.store(false);
+    }
+
+    bool AudioAnalysisJob::isRunning() const {
+        return _running.load();
+    }
+
+    AnalysisReport AudioAnalysisJob::report() const {
+        std::lock_guard<std::mutex> lock(_report_mutex);
+        return _report;
+    }
+}
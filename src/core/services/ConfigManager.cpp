@@ -8,6 +8,7 @@
  */
 
 #include "core/services/ConfigManager.hpp"
+#include "core/services/HistoryCompactionJob.hpp"
 
 #include <string>
 #include <filesystem>
@@ -135,6 +136,50 @@ namespace core {
             return Enviroment::DEVELOPMENT;
     }
 
+    unsigned ConfigManager::crossfadeMilliseconds() const {
+        if (!_config_data.contains("playback"))
+            return 0;
+
+        return _config_data["playback"].value("crossfade_ms", 0u);
+    }
+
+    bool ConfigManager::replayGainEnabled() const {
+        if (!_config_data.contains("playback"))
+            return true;
+
+        return _config_data["playback"].value("replay_gain", true);
+    }
+
+    std::string ConfigManager::audioBackend() const {
+        if (!_config_data.contains("playback"))
+            return "device";
+
+        return _config_data["playback"].value("backend", std::string("device"));
+    }
+
+    double ConfigManager::timeScale() const {
+        if (!_config_data.contains("playback"))
+            return 1.0;
+
+        return _config_data["playback"].value("time_scale", 1.0);
+    }
+
+    unsigned ConfigManager::historyRetentionDays() const {
+        if (!_config_data.contains("history"))
+            return HISTORY_RETENTION_DAYS_DEFAULT;
+
+        return _config_data["history"].value("retention_days",
+                                             static_cast<unsigned>(HISTORY_RETENTION_DAYS_DEFAULT));
+    }
+
+    std::string ConfigManager::queueSnapshotPath() const {
+        if (!_config_data.contains("playback"))
+            return "frankenstein.queue";
+
+        return _config_data["playback"].value("queue_snapshot",
+                                              std::string("frankenstein.queue"));
+    }
+
     std::string ConfigManager::toString() const {
         std::string result = "ConfigManager:\n";
         result += " - Config file path: " + _config_file_path + "\n";
@@ -3,6 +3,7 @@
 #include "core/bd/RepositoryFactory.hpp"
 #include "core/entities/User.hpp"
 
+#include <cstdlib>
 #include <iostream>
 
 namespace core
@@ -85,6 +86,7 @@ namespace core
         song->setTrackNumber(tag->track() == 0 ? 1 : tag->track());
         song->setUser(user);
         song->setDuration(file.audioProperties() ? file.audioProperties()->length() : 0);
+        readReplayGain(file, *song);
 
 
         std::string artistNames = tag->artist().isEmpty() ? "Unknown Artist" : tag->artist().toCString();
@@ -165,6 +167,36 @@ namespace core
         return song;
     }
 
+    bool FilesManager::readReplayGain(TagLib::FileRef &file, Song &song)
+    {
+        if (file.isNull() || !file.file())
+            return false;
+
+        TagLib::PropertyMap properties = file.file()->properties();
+        if (!properties.contains("REPLAYGAIN_TRACK_GAIN")
+            || properties["REPLAYGAIN_TRACK_GAIN"].isEmpty())
+            return false;
+
+        // valores no formato "-6.54 dB"; strtof ignora o sufixo
+        std::string gainTag = properties["REPLAYGAIN_TRACK_GAIN"].front().to8Bit(true);
+        char *end = nullptr;
+        float gain = std::strtof(gainTag.c_str(), &end);
+        if (end == gainTag.c_str())
+            return false;
+
+        float peak = 1.0f;
+        if (properties.contains("REPLAYGAIN_TRACK_PEAK")
+            && !properties["REPLAYGAIN_TRACK_PEAK"].isEmpty()) {
+            std::string peakTag = properties["REPLAYGAIN_TRACK_PEAK"].front().to8Bit(true);
+            float value = std::strtof(peakTag.c_str(), nullptr);
+            if (value > 0.0f)
+                peak = value;
+        }
+
+        song.setReplayGain(gain, peak);
+        return true;
+    }
+
     void FilesManager::verifyDir(std::string path)
     {
         fs::path dir(path);
@@ -0,0 +1,110 @@
+/**
+ * @file HistoryCompactionJob.cpp
+ * @brief Implementação da compactação do histórico de reprodução
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-27
+ */
+
+#include "core/services/HistoryCompactionJob.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include <sqlite3.h>
+
+namespace core {
+    HistoryCompactionJob::HistoryCompactionJob(std::shared_ptr<SQLite::Database> db,
+                                               unsigned retention_days)
+        : _db(db),
+          _repository(db),
+          _retention_days(retention_days == 0
+                              ? 0
+                              : std::max<unsigned>(retention_days, HISTORY_RETENTION_MIN_DAYS)),
+          _stop_requested(false),
+          _running(false) {}
+
+    HistoryCompactionJob::~HistoryCompactionJob() {
+        stop();
+    }
+
+    unsigned HistoryCompactionJob::retentionDays() const {
+        return _retention_days;
+    }
+
+    size_t HistoryCompactionJob::freePages() const {
+        SQLite::Statement query(*_db, "PRAGMA freelist_count;");
+        if (!query.executeStep())
+            return 0;
+
+        return static_cast<size_t>(query.getColumn(0).getInt64());
+    }
+
+    bool HistoryCompactionJob::incrementalVacuumEnabled() const {
+        // o VACUUM falha enquanto esta consulta estiver aberta
+        SQLite::Statement query(*_db, "PRAGMA auto_vacuum;");
+        return query.executeStep() && query.getColumn(0).getInt() == 2;
+    }
+
+    CompactionReport HistoryCompactionJob::run(std::time_t now) {
+        CompactionReport report;
+        if (_retention_days == 0)
+            return report;
+
+        std::time_t cutoff = now - static_cast<std::time_t>(_retention_days) * 24 * 60 * 60;
+        report.removed = _repository.deleteHistoryBefore(cutoff);
+        if (report.removed == 0 || _stop_requested.load())
+            return report;
+
+        size_t before = freePages();
+        if (!incrementalVacuumEnabled()) {
+            std::cout << "Ativando o auto_vacuum incremental (VACUUM completo, só desta vez)..."
+                      << std::endl;
+            _db->exec("PRAGMA auto_vacuum = INCREMENTAL;");
+            _db->exec("VACUUM;");
+            report.freed_pages = before;
+            return report;
+        }
+
+        _db->exec("PRAGMA incremental_vacuum;");
+        size_t after = freePages();
+        report.freed_pages = before > after ? before - after : 0;
+
+        return report;
+    }
+
+    void HistoryCompactionJob::start(std::time_t now) {
+        if (_running.load())
+            return;
+
+        if (_thread.joinable())
+            _thread.join();
+
+        _stop_requested.store(false);
+        _running.store(true);
+        _thread = std::thread([this, now]() {
+            try {
+                run(now);
+            } catch (const std::exception &e) {
+                if (!_stop_requested.load())
+                    std::cerr << "Erro ao compactar o histórico de reprodução: "
+                              << e.what() << std::endl;
+            }
+            _running.store(false);
+        });
+    }
+
+    void HistoryCompactionJob::stop() {
+        _stop_requested.store(true);
+        if (_running.load())
+            sqlite3_interrupt(_db->getHandle());
+        if (_thread.joinable())
+            _thread.join();
+        _stop_requested.store(false);
+    }
+
+    bool HistoryCompactionJob::isRunning() const {
+        return _running.load();
+    }
+}
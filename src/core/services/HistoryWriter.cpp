@@ -0,0 +1,158 @@
+/**
+ * @file HistoryWriter.cpp
+ * @brief Implementação da gravação em lote do histórico de reprodução
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-26
+ */
+
+#include "core/services/HistoryWriter.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+namespace core {
+
+    HistoryWriter::HistoryWriter(std::shared_ptr<HistoryPlaybackRepository> repository,
+                                 size_t batch_size,
+                                 std::chrono::milliseconds flush_interval,
+                                 size_t capacity)
+        : _repository(repository),
+          _events(capacity),
+          _batch_size(batch_size),
+          _flush_interval(flush_interval),
+          _running(true),
+          _flush_requested(0),
+          _flush_done(0),
+          _pending(0),
+          _written(0),
+          _dropped(0),
+          _failed(0) {
+        if (!_repository)
+            throw std::invalid_argument("Repositório de histórico inválido");
+        if (_batch_size == 0)
+            throw std::invalid_argument("Tamanho do lote deve ser positivo");
+
+        _thread = std::thread(&HistoryWriter::run, this);
+    }
+
+    HistoryWriter::~HistoryWriter() {
+        stop();
+    }
+
+    bool HistoryWriter::record(const PlaybackEvent &event) {
+        if (!_events.tryPush(event)) {
+            _dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // só acorda a thread quando um lote fecha; senão espera o intervalo
+        if (_pending.fetch_add(1, std::memory_order_relaxed) + 1 == _batch_size)
+            _wake.notify_one();
+        return true;
+    }
+
+    bool HistoryWriter::record(const User &user, const Song &song, unsigned listened_seconds,
+                               std::time_t played_at) {
+        if (user.getId() == 0 || song.getId() == 0)
+            return false;
+
+        PlaybackEvent event;
+        event.user_id = user.getId();
+        event.song_id = song.getId();
+        event.played_at = played_at;
+        event.duration = listened_seconds;
+        return record(event);
+    }
+
+    void HistoryWriter::run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (_running.load()) {
+            _wake.wait_for(lock, _flush_interval, [this]() {
+                return !_running.load()
+                       || _pending.load(std::memory_order_relaxed) >= _batch_size
+                       || _flush_requested != _flush_done;
+            });
+
+            uint64_t requested = _flush_requested;
+            lock.unlock();
+            drain();
+            lock.lock();
+
+            _flush_done = requested;
+            _flushed.notify_all();
+        }
+
+        // eventos registrados durante o encerramento
+        lock.unlock();
+        drain();
+    }
+
+    size_t HistoryWriter::drain() {
+        std::vector<PlaybackEvent> batch;
+        PlaybackEvent event;
+        while (_events.tryPop(event))
+            batch.push_back(event);
+
+        if (batch.empty())
+            return 0;
+
+        _pending.fetch_sub(batch.size(), std::memory_order_relaxed);
+
+        try {
+            _repository->insertPlaybackEvents(batch);
+            _written.fetch_add(batch.size(), std::memory_order_relaxed);
+        } catch (const std::exception &e) {
+            std::cerr << "Erro ao gravar histórico de reprodução: " << e.what()
+                      << std::endl;
+            _failed.fetch_add(batch.size(), std::memory_order_relaxed);
+        }
+
+        return batch.size();
+    }
+
+    void HistoryWriter::flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_running.load()) {
+            lock.unlock();
+            drain();
+            return;
+        }
+
+        uint64_t target = ++_flush_requested;
+        _wake.notify_one();
+        _flushed.wait(lock, [this, target]() {
+            return _flush_done >= target || !_running.load();
+        });
+    }
+
+    void HistoryWriter::stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_running.exchange(false))
+                return;
+        }
+
+        _wake.notify_one();
+        _flushed.notify_all();
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    size_t HistoryWriter::written() const {
+        return _written.load();
+    }
+
+    size_t HistoryWriter::dropped() const {
+        return _dropped.load();
+    }
+
+    size_t HistoryWriter::failed() const {
+        return _failed.load();
+    }
+}
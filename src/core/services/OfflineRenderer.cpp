@@ -0,0 +1,217 @@
+/**
+ * @file OfflineRenderer.cpp
+ * @brief Implementação da renderização offline
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-23
+ */
+
+#include "core/services/OfflineRenderer.hpp"
+
+#include <miniaudio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace core {
+
+    static const ma_uint64 RENDER_CHUNK_FRAMES = 4096;
+
+    double RenderReport::speedUp() const {
+        if (elapsed_seconds <= 0.0)
+            return 0.0;
+        return audio_seconds / elapsed_seconds;
+    }
+
+    OfflineRenderer::OfflineRenderer(unsigned sample_rate, unsigned channels)
+        : _sample_rate(sample_rate),
+          _channels(channels),
+          _crossfadeMs(0),
+          _replayGainEnabled(true) {
+        if (_sample_rate == 0 || _channels == 0)
+            throw std::invalid_argument("Formato de saída inválido");
+    }
+
+    void OfflineRenderer::setCrossfade(unsigned milliseconds) {
+        _crossfadeMs = milliseconds;
+    }
+
+    unsigned OfflineRenderer::getCrossfade() const {
+        return _crossfadeMs;
+    }
+
+    void OfflineRenderer::setReplayGain(bool enabled) {
+        _replayGainEnabled = enabled;
+    }
+
+    float OfflineRenderer::trackGain(const Song &song) const {
+        if (_replayGainEnabled && song.hasReplayGain())
+            return song.getGainFactor();
+        return 1.0f;
+    }
+
+    RenderReport OfflineRenderer::render(const PlaybackQueue &queue,
+                                         const std::string &output_path) const {
+        std::vector<std::shared_ptr<Song>> songs;
+        for (size_t i = 0; i < queue.size(); ++i)
+            songs.push_back(queue.at(i));
+
+        return render(songs, output_path);
+    }
+
+    RenderReport OfflineRenderer::render(const std::vector<std::shared_ptr<Song>> &songs,
+                                         const std::string &output_path) const {
+        std::vector<Track> tracks;
+        size_t unreadable = 0;
+
+        for (const auto &song : songs) {
+            if (!song)
+                continue;
+
+            try {
+                tracks.push_back({song->getAudioFilePath(), trackGain(*song)});
+            } catch (const std::exception &e) {
+                std::cerr << "Erro ao renderizar '" << song->getTitle() << "': "
+                          << e.what() << std::endl;
+                ++unreadable;
+            }
+        }
+
+        RenderReport report = renderTracks(tracks, output_path);
+        report.failed += unreadable;
+        return report;
+    }
+
+    RenderReport OfflineRenderer::renderFiles(const std::vector<std::string> &files,
+                                              const std::string &output_path) const {
+        std::vector<Track> tracks;
+        for (const auto &file : files)
+            tracks.push_back({file, 1.0f});
+
+        return renderTracks(tracks, output_path);
+    }
+
+    RenderReport OfflineRenderer::renderTracks(const std::vector<Track> &tracks,
+                                               const std::string &output_path) const {
+        auto startTime = std::chrono::steady_clock::now();
+        RenderReport report;
+
+        // sem dispositivo: o tempo do engine só avança quando lemos quadros
+        ma_engine_config engineConfig = ma_engine_config_init();
+        engineConfig.noDevice = MA_TRUE;
+        engineConfig.channels = _channels;
+        engineConfig.sampleRate = _sample_rate;
+
+        ma_engine engine;
+        ma_result result = ma_engine_init(&engineConfig, &engine);
+        if (result != MA_SUCCESS) {
+            throw std::runtime_error("Falha ao inicializar Audio Engine: "
+                                     + std::to_string(result));
+        }
+
+        ma_encoder_config encoderConfig = ma_encoder_config_init(
+            ma_encoding_format_wav, ma_format_f32, _channels, _sample_rate);
+
+        ma_encoder encoder;
+        result = ma_encoder_init_file(output_path.c_str(), &encoderConfig, &encoder);
+        if (result != MA_SUCCESS) {
+            ma_engine_uninit(&engine);
+            throw std::runtime_error("Falha ao criar arquivo de saída: " + output_path);
+        }
+
+        std::vector<float> buffer(RENDER_CHUNK_FRAMES * _channels);
+
+        auto renderUntil = [&](ma_uint64 target) {
+            ma_uint64 now = ma_engine_get_time_in_pcm_frames(&engine);
+            while (now < target) {
+                ma_uint64 frames = std::min(RENDER_CHUNK_FRAMES, target - now);
+                ma_uint64 framesRead = 0;
+                ma_engine_read_pcm_frames(&engine, buffer.data(), frames, &framesRead);
+                if (framesRead == 0)
+                    break;
+
+                ma_encoder_write_pcm_frames(&encoder, buffer.data(), framesRead, NULL);
+                now += framesRead;
+            }
+        };
+
+        // dois decks, como no Player: o próximo entra enquanto o atual sai
+        ma_sound decks[2];
+        bool loaded[2] = {false, false};
+        ma_uint64 deckEnd[2] = {0, 0};
+        std::memset(decks, 0, sizeof(decks));
+
+        ma_uint64 crossfadeFrames = static_cast<ma_uint64>(_crossfadeMs) * _sample_rate / 1000;
+        ma_uint64 mixEnd = 0;
+        ma_uint64 previousLength = 0;
+        int previous = -1;
+
+        for (size_t i = 0; i < tracks.size(); ++i) {
+            int slot = previous == 0 ? 1 : 0;
+
+            if (loaded[slot]) {
+                renderUntil(deckEnd[slot]);
+                ma_sound_uninit(&decks[slot]);
+                loaded[slot] = false;
+            }
+
+            ma_sound *sound = &decks[slot];
+            result = ma_sound_init_from_file(&engine, tracks[i].path.c_str(),
+                                             MA_SOUND_FLAG_DECODE, NULL, NULL, sound);
+            if (result != MA_SUCCESS) {
+                std::cerr << "Erro ao carregar '" << tracks[i].path << "': "
+                          << result << std::endl;
+                ++report.failed;
+                continue;
+            }
+            loaded[slot] = true;
+
+            ma_uint32 soundRate = _sample_rate;
+            ma_uint64 length = 0;
+            ma_sound_get_data_format(sound, NULL, NULL, &soundRate, NULL, 0);
+            ma_sound_get_length_in_pcm_frames(sound, &length);
+            if (soundRate != 0 && soundRate != _sample_rate)
+                length = length * _sample_rate / soundRate;
+
+            ma_uint64 fade = 0;
+            if (previous >= 0 && crossfadeFrames > 0)
+                fade = std::min({crossfadeFrames, length / 2, previousLength / 2});
+
+            ma_uint64 now = ma_engine_get_time_in_pcm_frames(&engine);
+            ma_uint64 startAt = std::max(now, mixEnd - fade);
+
+            ma_sound_set_volume(sound, tracks[i].gain);
+            if (fade > 0) {
+                ma_sound_set_fade_start_in_pcm_frames(sound, 0.0f, 1.0f, fade, startAt);
+                ma_sound_set_fade_start_in_pcm_frames(&decks[previous], -1.0f, 0.0f, fade, startAt);
+            }
+            ma_sound_set_start_time_in_pcm_frames(sound, startAt);
+            ma_sound_start(sound);
+
+            deckEnd[slot] = startAt + length;
+            mixEnd = deckEnd[slot];
+            previousLength = length;
+            previous = slot;
+            ++report.tracks;
+        }
+
+        renderUntil(mixEnd);
+
+        for (int slot = 0; slot < 2; ++slot) {
+            if (loaded[slot])
+                ma_sound_uninit(&decks[slot]);
+        }
+
+        ma_encoder_uninit(&encoder);
+        ma_engine_uninit(&engine);
+
+        report.audio_seconds = static_cast<double>(mixEnd) / _sample_rate;
+        report.elapsed_seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - startTime).count();
+        return report;
+    }
+}
@@ -12,105 +12,351 @@
 
 #include <cassert>
 #include <cstddef>
+#include <ctime>
 #include <algorithm>
+#include <iostream>
 #include <random>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace core {
+    // janela do histórico considerada pelo embaralhamento inteligente
+    static const std::time_t SMART_SHUFFLE_WINDOW = 30 * 24 * 60 * 60;
+    // novos sorteios quando sai o mesmo artista da música anterior
+    static const int SMART_SHUFFLE_ARTIST_RETRIES = 8;
+
     PlaybackQueue::PlaybackQueue()
-        : _current(0),
+        : _rng(std::random_device{}()),
+        _shuffle_mode(ShuffleMode::UNIFORM),
+        _current(0),
+        _history(0),
         _max_size(MAX_SIZE_DEFAULT),
         _aleatory(false),
+        _loop(false),
         _history_repo(nullptr),
-        _current_user(nullptr) {}
+        _current_user(nullptr),
+        _revision(0) {}
     PlaybackQueue::PlaybackQueue(std::shared_ptr<User> current_user,
                             std::shared_ptr<HistoryPlaybackRepository> history_repo,
                             size_t max_size)
-    : _current(0),
+    : _rng(std::random_device{}()),
+      _shuffle_mode(ShuffleMode::UNIFORM),
+      _current(0),
+      _history(0),
       _max_size(max_size),
       _aleatory(false),
-      _loop(false), 
+      _loop(false),
       _history_repo(history_repo),
-      _current_user(current_user) {}
+      _current_user(current_user),
+      _revision(0) {}
 
     PlaybackQueue::PlaybackQueue(std::shared_ptr<User> current_user,
                                 const IPlayable& playable,
                                 std::shared_ptr<HistoryPlaybackRepository> history_repo,
                                 size_t max_size)
-        : _current(0),
+        : _rng(std::random_device{}()),
+        _shuffle_mode(ShuffleMode::UNIFORM),
+        _current(0),
+        _history(0),
         _max_size(max_size),
         _aleatory(false),
+        _loop(false),
         _history_repo(history_repo),
-        _current_user(current_user) {
+        _current_user(current_user),
+        _revision(0) {
         add(playable);
     }
 
-    PlaybackQueue::~PlaybackQueue() = default;
+    PlaybackQueue::PlaybackQueue(const PlaybackQueue& other)
+        : _rng(other._rng),
+        _shuffle_mode(ShuffleMode::UNIFORM),
+        _current(0),
+        _history(0),
+        _max_size(other._max_size),
+        _aleatory(false),
+        _loop(false),
+        _revision(0) {
+        copyFrom(other);
+    }
 
-    size_t PlaybackQueue::getCurrentIndex() const {
-        return _aleatory ? _indices_aleatory[_current] : _current;
+    PlaybackQueue& PlaybackQueue::operator=(const PlaybackQueue& other) {
+        if (this != &other) {
+            clear();
+            _rng = other._rng;
+            _max_size = other._max_size;
+            copyFrom(other);
+        }
+        return *this;
     }
 
-    void PlaybackQueue::add(const IPlayable& tracks) {
-        auto new_songs = tracks.getPlayableObjects();
+    PlaybackQueue::~PlaybackQueue() {
+        clear();
+    }
 
-        unsigned count {0};
-        size_t initial_size = _queue.size();
-        for (const auto& song : new_songs) {
-            if (_queue.size() < _max_size) {
-                _queue.push_back(std::dynamic_pointer_cast<Song>(song));
-                count++;
-            } else {
-                throw std::length_error("PlaybackQueue reached its maximum size");
-            }
+    void PlaybackQueue::copyFrom(const PlaybackQueue& other) {
+        std::unordered_map<const QueueEntry*, QueueEntry*> copies;
+
+        other._ordered.forEach([&](QueueEntry* source) {
+            copies[source] = pushEntry(source->song, source->song_id);
+        });
+
+        other._shuffled.forEach([&](QueueEntry* source) {
+            QueueEntry* entry = copies[source];
+            entry->shuffled = _shuffled.pushBack(entry);
+            _ordered.setMarked(entry->ordered, true);
+        });
+
+        _current = other._current;
+        _history = other._history;
+        _aleatory = other._aleatory;
+        _loop = other._loop;
+        _history_repo = other._history_repo;
+        _current_user = other._current_user;
+        _shuffle_mode = other._shuffle_mode;
+        _play_stats = other._play_stats;
+        _song_loader = other._song_loader;
+        ++_revision;
+
+        if (_aleatory && _shuffle_mode == ShuffleMode::SMART)
+            buildSampler();
+    }
+
+    PlaybackQueue::QueueEntry* PlaybackQueue::entryAt(size_t index) const {
+        if (index >= size())
+            return nullptr;
+
+        if (!_aleatory)
+            return _ordered.at(index);
+
+        drawUntil(index);
+        if (index < _history)
+            return _ordered.at(index);
+        return _shuffled.at(index - _history);
+    }
+
+    size_t PlaybackQueue::activeIndexOf(const QueueEntry* entry) const {
+        if (!_aleatory)
+            return _ordered.indexOf(entry->ordered);
+
+        if (!entry->shuffled) {
+            size_t index = _ordered.indexOf(entry->ordered);
+            if (index < _history)
+                return index;
+
+            // ainda não sorteada: a posição só existe depois do sorteio
+            while (!entry->shuffled)
+                drawNext();
         }
 
-        std::vector<size_t> new_indices;
-        for (size_t i = 0; i < count; ++i)
-            new_indices.push_back(initial_size + i);
+        return _history + _shuffled.indexOf(entry->shuffled);
+    }
 
-        if (_aleatory) {
-            auto rng = std::default_random_engine{std::random_device{}()};
-            std::shuffle(_indices_aleatory.begin(), _indices_aleatory.end(), rng);
+    size_t PlaybackQueue::drawnCount() const {
+        return _history + _shuffled.size();
+    }
+
+    PlaybackQueue::QueueEntry* PlaybackQueue::drawNext() const {
+        QueueEntry* entry;
+        if (_shuffle_mode == ShuffleMode::SMART) {
+            entry = drawWeighted();
+        } else {
+            // Fisher–Yates: uma das músicas restantes, com a mesma chance. As
+            // não sorteadas são as não marcadas de _ordered depois do histórico.
+            std::uniform_int_distribution<size_t> pick(0, size() - drawnCount() - 1);
+            entry = _ordered.unmarkedAt(_history + pick(_rng))->value;
         }
 
-        _indices_aleatory.insert(_indices_aleatory.end(),
-                                new_indices.begin(),
-                                new_indices.end());
+        _ordered.setMarked(entry->ordered, true);
+        entry->shuffled = _shuffled.pushBack(entry);
+        ++_revision;
+        return entry;
     }
 
-    void PlaybackQueue::operator+=(const IPlayable& tracks) {
-        add(tracks);
+    PlaybackQueue::QueueEntry* PlaybackQueue::drawWeighted() const {
+        QueueEntry* previous = nullptr;
+        if (!_shuffled.empty())
+            previous = _shuffled.at(_shuffled.size() - 1);
+        else if (_history > 0)
+            previous = _ordered.at(_history - 1);
+
+        auto previousSong = previous ? songOf(previous) : nullptr;
+        unsigned previousArtist = previousSong ? previousSong->getArtistId() : 0;
+
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        QueueEntry* entry = nullptr;
+        for (int attempt = 0; attempt <= SMART_SHUFFLE_ARTIST_RETRIES; ++attempt) {
+            entry = _slot_entries[_sampler.sample(unit(_rng))];
+            if (previousArtist == 0)
+                break;
+
+            auto song = songOf(entry);
+            if (!song || song->getArtistId() != previousArtist)
+                break;
+        }
+
+        removeFromSampler(entry);
+        return entry;
     }
 
-    void PlaybackQueue::add(const PlaybackQueue& other_queue) {
-        size_t initial_size = _queue.size(), size_other = other_queue.size();
-        unsigned count {0};
-
-        for (size_t i = 0; i < size_other; ++i) {
-            if (_queue.size() < _max_size) {
-                _queue.push_back(other_queue.at(i));
-                count++;
-            } else {
-                throw std::length_error("PlaybackQueue reached its maximum size");
-            }
+    double PlaybackQueue::smartWeight(const QueueEntry* entry) const {
+        if (entry->song_id == 0)
+            return 1.0;
+
+        auto stats = _play_stats.find(entry->song_id);
+        unsigned plays = stats == _play_stats.end() ? 0 : stats->second.plays;
+        return 1.0 / (1.0 + plays);
+    }
+
+    void PlaybackQueue::loadPlayStats() {
+        _play_stats.clear();
+        if (!_history_repo || !_current_user)
+            return;
+
+        try {
+            _play_stats = _history_repo->findPlayStatsByUser(
+                *_current_user, std::time(nullptr) - SMART_SHUFFLE_WINDOW);
+        } catch (const std::exception& e) {
+            // sem histórico o sorteio só evita repetir o artista
+            std::cerr << "Erro ao carregar histórico de reprodução: " << e.what()
+                      << std::endl;
         }
+    }
 
-        std::vector<size_t> new_indices;
-        for (size_t i = 0; i < count; ++i)
-            new_indices.push_back(initial_size + i);
+    void PlaybackQueue::buildSampler() {
+        _sampler.clear();
+        _slot_entries.clear();
 
-        if (_aleatory) {
-            auto rng = std::default_random_engine{std::random_device{}()};
-            std::shuffle(_indices_aleatory.begin(), _indices_aleatory.end(), rng);
+        size_t index = 0;
+        _ordered.forEach([&](QueueEntry* entry) {
+            if (index++ >= _history && !entry->shuffled)
+                addToSampler(entry);
+        });
+    }
+
+    void PlaybackQueue::addToSampler(QueueEntry* entry) {
+        if (entry->slot < _slot_entries.size() && _slot_entries[entry->slot] == entry) {
+            _sampler.set(entry->slot, smartWeight(entry));
+            return;
+        }
+
+        entry->slot = _sampler.add(smartWeight(entry));
+        _slot_entries.push_back(entry);
+    }
+
+    void PlaybackQueue::removeFromSampler(QueueEntry* entry) const {
+        if (entry->slot < _slot_entries.size() && _slot_entries[entry->slot] == entry)
+            _sampler.set(entry->slot, 0.0);
+    }
+
+    void PlaybackQueue::drawUntil(size_t index) const {
+        while (drawnCount() <= index && drawnCount() < size())
+            drawNext();
+    }
+
+    bool PlaybackQueue::isDrawn(const QueueEntry* entry) const {
+        return !_aleatory || entry->shuffled
+               || _ordered.indexOf(entry->ordered) < _history;
+    }
+
+    void PlaybackQueue::undrawUpcoming() {
+        if (_current + 1 < _history)
+            flattenHistory();
+
+        while (drawnCount() > _current + 1) {
+            QueueEntry* entry = _shuffled.erase(_shuffled.size() - 1);
+            _ordered.setMarked(entry->ordered, false);
+            entry->shuffled = nullptr;
+            if (_shuffle_mode == ShuffleMode::SMART)
+                addToSampler(entry);
         }
+    }
+
+    void PlaybackQueue::flattenHistory() {
+        for (size_t i = _history; i > 0; --i) {
+            auto handle = _ordered.handleAt(i - 1);
+            handle->value->shuffled = _shuffled.insert(0, handle->value);
+            _ordered.setMarked(handle, true);
+        }
+        _history = 0;
+    }
+
+    void PlaybackQueue::indexEntry(QueueEntry* entry) {
+        if (entry->song)
+            _entries_by_song.emplace(entry->song.get(), entry);
+        if (entry->song_id != 0)
+            _entries_by_id.emplace(entry->song_id, entry);
+    }
+
+    void PlaybackQueue::unindexEntry(QueueEntry* entry) {
+        auto eraseFrom = [entry](auto& map, const auto& key) {
+            auto range = map.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == entry) {
+                    map.erase(it);
+                    return;
+                }
+            }
+        };
+
+        if (entry->song)
+            eraseFrom(_entries_by_song, entry->song.get());
+        if (entry->song_id != 0)
+            eraseFrom(_entries_by_id, entry->song_id);
+    }
+
+    PlaybackQueue::QueueEntry* PlaybackQueue::pushEntry(const std::shared_ptr<Song>& song,
+                                                        unsigned song_id) {
+        auto entry = new QueueEntry{song};
+        entry->song_id = song_id;
+        entry->ordered = _ordered.pushBack(entry);
+        indexEntry(entry);
+        ++_revision;
+        return entry;
+    }
+
+    std::shared_ptr<Song> PlaybackQueue::songOf(QueueEntry* entry) const {
+        if (!entry->song && entry->song_id != 0 && _song_loader) {
+            entry->song = _song_loader(entry->song_id);
+            if (entry->song)
+                _entries_by_song.emplace(entry->song.get(), entry);
+        }
+
+        return entry->song;
+    }
+
+    void PlaybackQueue::append(const std::shared_ptr<Song>& song) {
+        if (size() >= _max_size)
+            throw std::length_error("PlaybackQueue reached its maximum size");
+
+        // no modo aleatório a entrada nova fica entre as não sorteadas
+        QueueEntry* entry = pushEntry(song, song ? song->getId() : 0);
 
-        _indices_aleatory.insert(_indices_aleatory.end(),
-                                new_indices.begin(),
-                                new_indices.end());
+        if (_aleatory && _shuffle_mode == ShuffleMode::SMART)
+            addToSampler(entry);
+    }
+
+    void PlaybackQueue::add(const IPlayable& tracks) {
+        auto new_songs = tracks.getPlayableObjects();
+
+        for (const auto& song : new_songs)
+            append(std::dynamic_pointer_cast<Song>(song));
+    }
+
+    void PlaybackQueue::operator+=(const IPlayable& tracks) {
+        add(tracks);
+    }
+
+    void PlaybackQueue::add(const PlaybackQueue& other_queue) {
+        // cópia antes de inserir: other_queue pode ser esta mesma fila
+        std::vector<std::shared_ptr<Song>> songs;
+        for (size_t i = 0; i < other_queue.size(); ++i)
+            songs.push_back(other_queue.at(i));
+
+        for (const auto& song : songs)
+            append(song);
     }
 
     void PlaybackQueue::operator+=(const PlaybackQueue& other_queue) {
@@ -118,93 +364,150 @@ namespace core {
     }
 
     bool PlaybackQueue::remove(size_t index) {
-        if (index >= _queue.size()) {
+        QueueEntry* entry = entryAt(index);
+        if (!entry) {
             return false;
         }
 
-        size_t actual_index = _aleatory ? _indices_aleatory[index] : index;
+        if (entry->shuffled)
+            _shuffled.erase(entry->shuffled);
+        else if (_aleatory)
+            _history--;  // entryAt só devolve sorteadas ou do histórico
+        _ordered.erase(entry->ordered);
+        unindexEntry(entry);
+        removeFromSampler(entry);
+        delete entry;
+        ++_revision;
+
+        if ((_current > index && _current > 0) ||
+            (_current == index && _current == size() && _current > 0))
+            (_current)--;
 
-        _queue.erase(_queue.begin() + actual_index);
+        return true;
+    }
 
-        if ((_current > actual_index && _current > 0) ||
-            (_current == actual_index && _current == _queue.size() && _current > 0))
-            (_current)--;
+    bool PlaybackQueue::move(size_t from, size_t to) {
+        if (from >= size() || to >= size())
+            return false;
 
+        if (!_aleatory) {
+            _ordered.move(from, to);
+        } else {
+            drawUntil(std::max(from, to));
+            if (std::min(from, to) < _history)
+                flattenHistory();
+            _shuffled.move(from - _history, to - _history);
+        }
+
+        if (_current == from)
+            _current = to;
+        else if (from < _current && to >= _current)
+            _current--;
+        else if (from > _current && to <= _current)
+            _current++;
+
+        ++_revision;
         return true;
     }
 
     int PlaybackQueue::findNextIndex(const Song& song) const {
-        for (size_t i = _current + 1; i < _queue.size(); ++i) {
-            if ((!_aleatory && *_queue[i] == song) ||
-                (_aleatory && *_queue[_indices_aleatory[i]] == song))
-                return i;
+        int found = -1;
+
+        std::vector<QueueEntry*> matches;
+
+        auto bySong = _entries_by_song.equal_range(&song);
+        for (auto it = bySong.first; it != bySong.second; ++it)
+            matches.push_back(it->second);
+
+        if (song.getId() != 0) {
+            auto byId = _entries_by_id.equal_range(song.getId());
+            for (auto it = byId.first; it != byId.second; ++it) {
+                auto candidate = songOf(it->second);
+                if (candidate && *candidate == song)
+                    matches.push_back(it->second);
+            }
+        }
+
+        auto consider = [&](QueueEntry* entry) {
+            size_t index = activeIndexOf(entry);
+            if (index >= _current && (found < 0 || index < static_cast<size_t>(found)))
+                found = static_cast<int>(index);
+        };
+
+        // posições já definidas vêm antes de qualquer uma ainda não sorteada,
+        // então só sorteamos se nenhuma definida servir
+        for (QueueEntry* entry : matches) {
+            if (isDrawn(entry))
+                consider(entry);
+        }
+
+        if (found < 0) {
+            for (QueueEntry* entry : matches)
+                consider(entry);
         }
 
-        return -1;
+        return found;
     }
 
     int PlaybackQueue::findCurrentIndex() const {
-        if (_queue.empty()) return -1;
-        return static_cast<int>(getCurrentIndex());
+        if (empty()) return -1;
+        return static_cast<int>(_current);
     }
 
     int PlaybackQueue::findPreviousIndex() const {
-        if (_queue.empty()) return -1;
+        if (empty()) return -1;
 
-        return static_cast<int>(getCurrentIndex() == 0 ? 0 : getCurrentIndex() - 1);
+        return static_cast<int>(_current == 0 ? 0 : _current - 1);
     }
 
     std::shared_ptr<Song> PlaybackQueue::at(size_t index) const {
-        if (index >= _queue.size())
-            return nullptr;
-
-        size_t actual_index = _aleatory ? _indices_aleatory[index] : index;
-
-        return _queue[actual_index];
+        QueueEntry* entry = entryAt(index);
+        return entry ? songOf(entry) : nullptr;
     }
 
     std::shared_ptr<Song> PlaybackQueue::getNextSong() {
-        if (_queue.empty() || _current >= _queue.size())
+        if (empty() || _current >= size())
             return nullptr;
 
         if (_current + 1 == _current && _loop)
             return at(0);
-        else if (_current + 1 >= _queue.size())
+        else if (_current + 1 >= size())
             return nullptr;
 
         return at(_current + 1);
     }
 
     std::shared_ptr<const Song> PlaybackQueue::getCurrentSong() const {
-        if (_queue.empty() || _current >= _queue.size())
+        if (empty() || _current >= size())
             return nullptr;
 
-        return _queue[getCurrentIndex()];
+        return at(_current);
     }
 
     std::shared_ptr<const Song> PlaybackQueue::getPreviousSong() const {
-        if (_queue.empty() || (_current == 0 && !_loop))
+        if (empty() || (_current == 0 && !_loop))
             return nullptr;
 
         if (_current == 0 && _loop)
-            return at(_queue.size() - 1);
+            return at(size() - 1);
 
         return at(_current - 1);
     }
 
     std::shared_ptr<const Song> PlaybackQueue::next() {
-        if (_queue.empty() || _current >= _queue.size())
+        if (empty() || _current >= size())
             return nullptr;
 
-        if (_current + 1 == _queue.size() && _loop) {
+        if (_current + 1 == size() && _loop) {
             _current = 0;
-        } else if (_current + 1 >= _queue.size()) {
+        } else if (_current + 1 >= size()) {
             return nullptr;
         } else {
             _current++;
         }
 
-        return _queue[getCurrentIndex()];
+        ++_revision;
+        return at(_current);
     }
 
     std::shared_ptr<const Song> PlaybackQueue::operator++() {
@@ -212,16 +515,17 @@ namespace core {
     }
 
     std::shared_ptr<const Song> PlaybackQueue::previous() {
-        if (_queue.empty() || (_current == 0 && !_loop))
+        if (empty() || (_current == 0 && !_loop))
             return nullptr;
 
         if (_current == 0 && _loop) {
-            _current = _queue.size() - 1;
+            _current = size() - 1;
         } else {
             _current--;
         }
 
-        return _queue[getCurrentIndex()];
+        ++_revision;
+        return at(_current);
     }
 
     std::shared_ptr<const Song> PlaybackQueue::operator--() {
@@ -232,11 +536,11 @@ namespace core {
                                                         size_t after) const {
         std::vector<std::shared_ptr<const Song>> view;
 
-        if (_queue.empty())
+        if (empty())
             return view;
 
         size_t start = std::max(static_cast<int>(_current - before), 0);
-        size_t end = std::min(_current + after, _queue.size() - 1);
+        size_t end = std::min(_current + after, size() - 1);
 
         for (size_t i = start; i <= end; ++i)
             view.push_back(at(i));
@@ -248,10 +552,10 @@ namespace core {
                                                            size_t count) const {
         std::vector<std::shared_ptr<const Song>> segment;
 
-        if (_queue.empty() || start >= _queue.size())
+        if (empty() || start >= size())
             return segment;
 
-        size_t end = std::min(start + count, _queue.size());
+        size_t end = std::min(start + count, size());
 
         for (size_t i = start; i < end; ++i)
             segment.push_back(at(i));
@@ -260,22 +564,53 @@ namespace core {
     }
 
     void PlaybackQueue::clear() {
-        _queue.clear();
+        _ordered.forEach([](QueueEntry* entry) { delete entry; });
+        _ordered.clear();
+        _shuffled.clear();
+        _entries_by_song.clear();
+        _entries_by_id.clear();
+        _sampler.clear();
+        _slot_entries.clear();
         _current = 0;
-        _indices_aleatory.clear();
+        _history = 0;
+        ++_revision;
     }
 
     size_t PlaybackQueue::size() const {
-        return _queue.size();
+        return _ordered.size();
     }
 
     bool PlaybackQueue::empty() const {
-        return _queue.empty();
+        return _ordered.empty();
     }
 
     void PlaybackQueue::setAleatory(bool aleatory) {
-        _aleatory = aleatory;
-        if (_aleatory) shuffle();
+        if (aleatory == _aleatory)
+            return;
+
+        ++_revision;
+        if (aleatory) {
+            // O(1): o que já tocou vira histórico, o resto é sorteado depois
+            _aleatory = true;
+            _history = empty() ? 0 : _current + 1;
+            if (_shuffle_mode == ShuffleMode::SMART) {
+                loadPlayStats();
+                buildSampler();
+            }
+        } else {
+            QueueEntry* current = entryAt(_current);
+            _shuffled.forEach([this](QueueEntry* entry) {
+                _ordered.setMarked(entry->ordered, false);
+                entry->shuffled = nullptr;
+            });
+            _shuffled.clear();
+            _sampler.clear();
+            _slot_entries.clear();
+            _history = 0;
+            _aleatory = false;
+            if (current)
+                _current = _ordered.indexOf(current->ordered);
+        }
     }
 
     bool PlaybackQueue::toggleAleatory() {
@@ -283,11 +618,39 @@ namespace core {
         return _aleatory;
     }
 
+    void PlaybackQueue::setSeed(uint64_t seed) {
+        _rng.seed(seed);
+    }
+
+    void PlaybackQueue::setShuffleMode(ShuffleMode mode) {
+        if (mode == _shuffle_mode)
+            return;
+
+        ++_revision;
+        if (_aleatory)
+            undrawUpcoming();
+
+        _shuffle_mode = mode;
+        _sampler.clear();
+        _slot_entries.clear();
+
+        if (_aleatory && _shuffle_mode == ShuffleMode::SMART) {
+            loadPlayStats();
+            buildSampler();
+        }
+    }
+
+    ShuffleMode PlaybackQueue::getShuffleMode() const {
+        return _shuffle_mode;
+    }
+
     bool PlaybackQueue::isAleatory() const {
         return _aleatory;
     }
 
     void PlaybackQueue::setLoop(bool loop) {
+        if (loop != _loop)
+            ++_revision;
         _loop = loop;
     }
 
@@ -301,16 +664,18 @@ namespace core {
     }
 
     void PlaybackQueue::shuffle() {
-        if (_queue.empty())
-             return;
+        if (!_aleatory) {
+            setAleatory(true);
+            return;
+        }
 
-        auto rng = std::default_random_engine{std::random_device{}()};
-        std::shuffle(_indices_aleatory.begin(), _indices_aleatory.end(), rng);
+        undrawUpcoming();
+        ++_revision;
     }
 
     std::string PlaybackQueue::toString() const {
         std::string result = "PlaybackQueue ("
-            + std::to_string(_queue.size()) + " songs) in "
+            + std::to_string(size()) + " songs) in "
             + (_aleatory ? "aleatory" : "sequential") + " mode, "
             + (_loop ? "looping" : "not looping") + ".\n";
 
@@ -319,20 +684,98 @@ namespace core {
 
     std::string PlaybackQueue::toStringDetailed() const {
         std::string result = "PlaybackQueue:\n";
-        result += "Total Songs: " + std::to_string(_queue.size()) + "\n";
+        result += "Total Songs: " + std::to_string(size()) + "\n";
         result += "Current Index: " + std::to_string(_current) + "\n";
         result += "Mode: " + std::string(_aleatory ? "Aleatory" : "Sequential") + "\n";
         result += "Looping: " + std::string(_loop ? "Enabled" : "Disabled") + "\n";
         result += "Songs:\n";
         result += "[";
 
-        for (size_t i = 0; i < _queue.size(); ++i) {
-            result += " (" + std::to_string(i) + ", " + _queue[i]->getTitle() + ")";
-            if (i < _queue.size() - 1) result += ",";
+        size_t i = 0;
+        _ordered.forEach([&](QueueEntry* entry) {
+            auto song = songOf(entry);
+            result += " (" + std::to_string(i) + ", " + (song ? song->getTitle() : "?") + ")";
+            if (i < size() - 1) result += ",";
             result += " ";
-        }
+            ++i;
+        });
         result += "]\n";
 
         return result;
     }
+
+    uint64_t PlaybackQueue::revision() const {
+        return _revision;
+    }
+
+    QueueSnapshot PlaybackQueue::snapshot() const {
+        QueueSnapshot snapshot;
+        std::unordered_map<const QueueEntry*, uint32_t> positions;
+
+        _ordered.forEach([&](QueueEntry* entry) {
+            positions[entry] = static_cast<uint32_t>(snapshot.song_ids.size());
+            snapshot.song_ids.push_back(entry->song_id);
+        });
+        _shuffled.forEach([&](QueueEntry* entry) {
+            snapshot.drawn.push_back(positions[entry]);
+        });
+
+        snapshot.current = _current;
+        snapshot.history = _history;
+        snapshot.aleatory = _aleatory;
+        snapshot.loop = _loop;
+        snapshot.shuffle_mode = _shuffle_mode;
+
+        // sem ID não há como carregar a música de volta
+        snapshot.retain([](unsigned id) { return id != 0; });
+        return snapshot;
+    }
+
+    void PlaybackQueue::restore(const QueueSnapshot& snapshot, SongLoader loader) {
+        size_t count = snapshot.song_ids.size();
+        if (count > _max_size)
+            throw std::length_error("PlaybackQueue reached its maximum size");
+
+        bool consistent = snapshot.history <= count
+                          && (count == 0 ? snapshot.current == 0 : snapshot.current < count);
+        std::vector<bool> drawn(count, false);
+        for (uint32_t index : snapshot.drawn) {
+            if (!consistent || index >= count || index < snapshot.history || drawn[index]) {
+                consistent = false;
+                break;
+            }
+            drawn[index] = true;
+        }
+        if (!consistent)
+            throw std::invalid_argument("Snapshot da fila inconsistente");
+
+        clear();
+        _song_loader = std::move(loader);
+
+        std::vector<QueueEntry*> entries;
+        entries.reserve(count);
+        for (unsigned id : snapshot.song_ids)
+            entries.push_back(pushEntry(nullptr, id));
+
+        _aleatory = snapshot.aleatory;
+        _loop = snapshot.loop;
+        _shuffle_mode = snapshot.shuffle_mode;
+        _history = _aleatory ? snapshot.history : 0;
+        _current = snapshot.current;
+
+        if (_aleatory) {
+            for (uint32_t index : snapshot.drawn) {
+                QueueEntry* entry = entries[index];
+                _ordered.setMarked(entry->ordered, true);
+                entry->shuffled = _shuffled.pushBack(entry);
+            }
+
+            if (_shuffle_mode == ShuffleMode::SMART) {
+                loadPlayStats();
+                buildSampler();
+            }
+        }
+
+        ++_revision;
+    }
 }
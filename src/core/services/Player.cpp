@@ -1,6 +1,7 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include "core/services/Player.hpp"
 #include "miniaudio.h"
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <memory>
@@ -12,38 +13,123 @@
 namespace core {
 
     void Player::onSoundEnd(void* pUserData, ma_sound* pSound) {
+        // thread de áudio: só anota o deck; o avanço fica para poll()
         Player* player = static_cast<Player*>(pUserData);
-        if (player && !player->_isLooping) {
-            player->_shouldAdvanceToNext.store(true, std::memory_order_release);
-
-            std::thread([player]() {
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                player->checkAndAdvanceIfNeeded();
-            }).detach();
+        if (player) {
+            player->_endedSound.store(pSound, std::memory_order_release);
         }
     }
 
+    static const ma_uint64 VIRTUAL_CLOCK_CHUNK_FRAMES = 4096;
+    static const ma_uint32 VIRTUAL_CLOCK_SAMPLE_RATE = 48000;
+    static const ma_uint32 VIRTUAL_CLOCK_CHANNELS = 2;
+
+    /**
+     * @brief Aloca um deck vazio; o ma_sound precisa de endereço fixo
+     * enquanto estiver ligado ao grafo do engine
+     */
+    static std::unique_ptr<ma_sound> makeDeck() {
+        std::unique_ptr<ma_sound> deck(new ma_sound);
+        memset(deck.get(), 0, sizeof(ma_sound));
+        return deck;
+    }
+
+    uint64_t PlayerStatus::totalFrames() const {
+        if (length_frames > 0)
+            return length_frames;
+        return static_cast<uint64_t>(duration) * sample_rate;
+    }
+
+    uint64_t PlayerStatus::framesAt(uint64_t now) const {
+        uint64_t frames = cursor_frames;
+        if (state == PlayerState::PLAYING && now > engine_time)
+            frames += now - engine_time;
+
+        uint64_t total = totalFrames();
+        if (total == 0)
+            return frames;
+        return looping ? frames % total : std::min(frames, total);
+    }
+
+    unsigned PlayerStatus::elapsedAt(uint64_t now) const {
+        if (!has_song || sample_rate == 0)
+            return 0;
+        return static_cast<unsigned>(framesAt(now) / sample_rate);
+    }
+
+    float PlayerStatus::progressAt(uint64_t now) const {
+        uint64_t total = totalFrames();
+        if (!has_song || total == 0)
+            return 0.0f;
+        return std::min(1.0f, static_cast<float>(framesAt(now)) / static_cast<float>(total));
+    }
+
     Player::Player()
-        : _currentQueueIndex(-1),
+        : Player(AudioBackend::DEVICE) {}
+
+    Player::Player(AudioBackend backend, double time_scale)
+        : _currentContext(QUEUE_NAME_DEFAULT),
           _currentSongIndex(-1),
           _playerState(PlayerState::STOPPED),
           _isLooping(false),
           _volume(1.0f),
           _previousVolume(1.0f),
+          _activeDeck(0),
           _audioInitialized(false),
-          _shouldAdvanceToNext(false) {
-        ma_result result = ma_engine_init(NULL, &_audioEngine);
+          _crossfadeMs(0),
+          _replayGainEnabled(true),
+          _crossfadePending(false),
+          _endedSound(nullptr),
+          _resumeSongId(0),
+          _resumePosition(0),
+          _playbackStartedAt(0),
+          _backend(backend),
+          _timeScale(time_scale),
+          _clockRunning(false) {
+        if (time_scale < 0.0) {
+            throw std::invalid_argument("Escala de tempo inválida");
+        }
+
+        ma_result result;
+        if (_backend == AudioBackend::NULL_DEVICE) {
+            ma_engine_config config = ma_engine_config_init();
+            config.noDevice = MA_TRUE;
+            config.channels = VIRTUAL_CLOCK_CHANNELS;
+            config.sampleRate = VIRTUAL_CLOCK_SAMPLE_RATE;
+            result = ma_engine_init(&config, &_audioEngine);
+        } else {
+            result = ma_engine_init(NULL, &_audioEngine);
+        }
+
         if (result != MA_SUCCESS) {
             throw std::runtime_error("Falha ao inicializar Audio Engine: "
                                      + std::to_string(result));
         }
 
+        result = ma_sound_group_init(&_audioEngine, 0, NULL, &_mixBus);
+        if (result != MA_SUCCESS) {
+            ma_engine_uninit(&_audioEngine);
+            throw std::runtime_error("Falha ao inicializar barramento de mixagem: "
+                                     + std::to_string(result));
+        }
+
         _audioInitialized = true;
-        memset(&_currentSound, 0, sizeof(_currentSound));
+        _decks[0] = makeDeck();
+        _decks[1] = makeDeck();
 
-        std::cout << "Audio engine inicializado" << std::endl;
+        if (_backend == AudioBackend::NULL_DEVICE) {
+            _clockBuffer.resize(VIRTUAL_CLOCK_CHUNK_FRAMES * VIRTUAL_CLOCK_CHANNELS);
+            _clockRunning.store(true);
+            _clockThread = std::thread(&Player::runVirtualClock, this);
+        }
+
+        std::cout << "Audio engine inicializado"
+                  << (_backend == AudioBackend::NULL_DEVICE ? " (sem dispositivo)" : "")
+                  << std::endl;
 
         _queue = std::make_shared<core::PlaybackQueue>();
+        _contexts[_currentContext].queue = _queue;
+        publishStatus();
     }
 
     Player::Player(const core::PlaybackQueue& tracks)
@@ -52,18 +138,270 @@ namespace core {
     }
 
     Player::~Player() {
+        _clockRunning.store(false);
+        if (_clockThread.joinable()) {
+            _clockThread.join();
+        }
+
+        finishPlayback();
         cleanupCurrentSound();
+        for (auto& [name, context] : _contexts) {
+            if (context.sound) {
+                if (context.song && context.startedAt != 0)
+                    recordPlayback(*context.song, context.sound.get(), context.startedAt);
+                cleanupSound(context.sound.get());
+            }
+        }
         if (_audioInitialized) {
+            ma_sound_group_uninit(&_mixBus);
             ma_engine_uninit(&_audioEngine);
         }
     }
 
+    void Player::runVirtualClock() {
+        const auto tick = std::chrono::milliseconds(10);
+        auto last = std::chrono::steady_clock::now();
+        double pending = 0.0;
+
+        while (_clockRunning.load()) {
+            std::this_thread::sleep_for(tick);
+
+            // tempo real decorrido (não o tick nominal) para não acumular atraso
+            auto now = std::chrono::steady_clock::now();
+            pending += std::chrono::duration<double>(now - last).count()
+                       * VIRTUAL_CLOCK_SAMPLE_RATE * _timeScale.load();
+            last = now;
+
+            ma_uint64 frames = static_cast<ma_uint64>(pending);
+            pending -= static_cast<double>(frames);
+            pumpFrames(frames);
+        }
+    }
+
+    void Player::pumpFrames(ma_uint64 frames) {
+        std::lock_guard<std::mutex> lock(_clockMutex);
+
+        while (frames > 0) {
+            ma_uint64 chunk = std::min(frames, VIRTUAL_CLOCK_CHUNK_FRAMES);
+            ma_uint64 framesRead = 0;
+            ma_engine_read_pcm_frames(&_audioEngine, _clockBuffer.data(), chunk, &framesRead);
+            frames -= chunk;
+        }
+    }
+
+    AudioBackend Player::getBackend() const {
+        return _backend;
+    }
+
+    void Player::setTimeScale(double scale) {
+        if (_backend != AudioBackend::NULL_DEVICE) {
+            throw std::logic_error("Escala de tempo exige o backend sem dispositivo");
+        }
+        if (scale < 0.0) {
+            throw std::invalid_argument("Escala de tempo inválida");
+        }
+        _timeScale.store(scale);
+    }
+
+    double Player::getTimeScale() const {
+        return _backend == AudioBackend::NULL_DEVICE ? _timeScale.load() : 1.0;
+    }
+
+    void Player::advanceTime(unsigned milliseconds) {
+        if (_backend != AudioBackend::NULL_DEVICE) {
+            throw std::logic_error("Avanço manual exige o backend sem dispositivo");
+        }
+        pumpFrames(static_cast<ma_uint64>(milliseconds) * VIRTUAL_CLOCK_SAMPLE_RATE / 1000);
+    }
+
+    std::shared_ptr<const PlayerStatus> Player::getStatus() const {
+        return std::atomic_load(&_status);
+    }
+
+    void Player::refreshStatus() {
+        captureTrackInfo();
+        publishStatus();
+    }
+
+    void Player::poll() {
+        checkAndAdvanceIfNeeded();
+    }
+
+    void Player::captureTrackInfo() {
+        TrackInfo info;
+        if (_currentSong) {
+            if (auto artist = _currentSong->getArtist())
+                info.artist = artist->getName();
+            if (auto album = _currentSong->getAlbum())
+                info.album = album->getTitle();
+        }
+        if (_queue) {
+            if (auto next = _queue->getNextSong()) {
+                info.next_title = next->getTitle();
+                if (auto artist = next->getArtist())
+                    info.next_artist = artist->getName();
+            }
+        }
+        _trackInfo = std::move(info);
+    }
+
+    void Player::publishStatus() {
+        auto status = std::make_shared<PlayerStatus>();
+
+        auto previous = std::atomic_load(&_status);
+        status->sequence = previous ? previous->sequence + 1 : 1;
+        status->state = _playerState;
+        status->volume = _volume;
+        status->muted = _volume == 0.0f;
+        status->looping = _isLooping;
+        status->crossfade_ms = _crossfadeMs;
+        status->queue_name = _currentContext;
+
+        if (_audioInitialized) {
+            status->sample_rate = ma_engine_get_sample_rate(&_audioEngine);
+            status->engine_time = ma_engine_get_time(&_audioEngine);
+        }
+
+        if (_currentSong) {
+            status->has_song = true;
+            status->song_id = _currentSong->getId();
+            status->title = _currentSong->getTitle();
+            status->duration = static_cast<unsigned>(std::max(0, _currentSong->getDuration()));
+            status->artist = _trackInfo.artist;
+            status->album = _trackInfo.album;
+
+            ma_sound* sound = currentSound();
+            if (sound->pDataSource != nullptr) {
+                ma_uint64 frames = 0;
+                if (ma_sound_get_cursor_in_pcm_frames(sound, &frames) == MA_SUCCESS)
+                    status->cursor_frames = frames;
+                if (ma_sound_get_length_in_pcm_frames(sound, &frames) == MA_SUCCESS)
+                    status->length_frames = frames;
+            }
+        }
+
+        if (_queue) {
+            status->queue_size = _queue->size();
+        }
+        status->next_title = _trackInfo.next_title;
+        status->next_artist = _trackInfo.next_artist;
+
+        std::atomic_store(&_status, std::shared_ptr<const PlayerStatus>(std::move(status)));
+    }
+
     std::shared_ptr<PlaybackQueue> Player::getCurrentQueue() const {
-        if (_currentQueueIndex >= 0
-            && static_cast<size_t>(_currentQueueIndex) < _queues.size()) {
-            return _queues[_currentQueueIndex];
+        return _queue;
+    }
+
+    std::shared_ptr<PlaybackQueue> Player::createQueue(const std::string& name) {
+        if (name.empty()) {
+            throw std::invalid_argument("Nome de fila vazio");
         }
-        return nullptr;
+        if (_contexts.count(name)) {
+            throw std::invalid_argument("Fila já existe: " + name);
+        }
+
+        auto queue = std::make_shared<core::PlaybackQueue>();
+        _contexts[name].queue = queue;
+        return queue;
+    }
+
+    void Player::parkCurrentContext() {
+        QueueContext& context = _contexts[_currentContext];
+        context.queue = _queue;
+        context.song = _currentSong;
+        context.songIndex = _currentSongIndex;
+        context.startedAt = 0;
+
+        cancelCrossfade();
+
+        ma_sound* sound = currentSound();
+        if (sound->pDataSource != nullptr) {
+            // som estacionado não avisa fim: o deck atual passa a ser outro
+            ma_sound_set_end_callback(sound, NULL, NULL);
+            ma_sound_stop(sound);
+            context.sound = std::move(_decks[_activeDeck]);
+            _decks[_activeDeck] = makeDeck();
+            context.startedAt = _playbackStartedAt;
+        }
+        _playbackStartedAt = 0;
+
+        // descarta um fim anotado antes do callback ser desligado
+        _endedSound.store(nullptr, std::memory_order_release);
+    }
+
+    void Player::switchQueue(const std::string& name) {
+        auto target = _contexts.find(name);
+        if (target == _contexts.end()) {
+            throw std::invalid_argument("Fila inexistente: " + name);
+        }
+        if (name == _currentContext) {
+            return;
+        }
+
+        bool wasPlaying = _playerState == PlayerState::PLAYING;
+        parkCurrentContext();
+
+        QueueContext& context = target->second;
+        _currentContext = name;
+        _queue = context.queue;
+        _currentSong = context.song;
+        _currentSongIndex = context.songIndex;
+        captureTrackInfo();
+
+        if (context.sound) {
+            // o deck atual está vazio depois de parkCurrentContext()
+            _decks[_activeDeck] = std::move(context.sound);
+            _playbackStartedAt = context.startedAt;
+            context.startedAt = 0;
+            ma_sound_set_end_callback(currentSound(), onSoundEnd, this);
+            ma_sound_set_looping(currentSound(), _isLooping ? MA_TRUE : MA_FALSE);
+
+            _playerState = PlayerState::PAUSED;
+            if (!wasPlaying || !startCurrentSound()) {
+                publishStatus();
+            }
+            return;
+        }
+
+        _playerState = PlayerState::STOPPED;
+        if (wasPlaying && !_queue->empty()) {
+            play();
+        }
+        if (_playerState != PlayerState::PLAYING) {
+            publishStatus();
+        }
+    }
+
+    void Player::dropQueue(const std::string& name) {
+        auto target = _contexts.find(name);
+        if (target == _contexts.end()) {
+            throw std::invalid_argument("Fila inexistente: " + name);
+        }
+        if (name == _currentContext) {
+            throw std::invalid_argument("A fila ativa não pode ser removida");
+        }
+
+        QueueContext& context = target->second;
+        if (context.sound) {
+            if (context.song && context.startedAt != 0)
+                recordPlayback(*context.song, context.sound.get(), context.startedAt);
+            cleanupSound(context.sound.get());
+        }
+        _contexts.erase(target);
+    }
+
+    std::vector<std::string> Player::getQueueNames() const {
+        std::vector<std::string> names;
+        names.reserve(_contexts.size());
+        for (const auto& entry : _contexts) {
+            names.push_back(entry.first);
+        }
+        return names;
+    }
+
+    const std::string& Player::getCurrentQueueName() const {
+        return _currentContext;
     }
 
     ma_uint64 Player::getEngineTime() const {
@@ -73,19 +411,185 @@ namespace core {
         return ma_engine_get_time(&_audioEngine);
     }
 
-    void Player::cleanupCurrentSound() {
-        if (_currentSound.pDataSource == nullptr) {
+    ma_sound* Player::currentSound() const {
+        return _decks[_activeDeck].get();
+    }
+
+    ma_sound* Player::standbySound() const {
+        return _decks[1 - _activeDeck].get();
+    }
+
+    ma_uint32 Player::soundSampleRate(ma_sound* sound) const {
+        ma_uint32 sampleRate = 0;
+        if (ma_sound_get_data_format(sound, NULL, NULL, &sampleRate, NULL, 0) != MA_SUCCESS
+            || sampleRate == 0) {
+            sampleRate = ma_engine_get_sample_rate(&_audioEngine);
+        }
+        return sampleRate;
+    }
+
+    void Player::cleanupSound(ma_sound* sound) {
+        if (sound->pDataSource == nullptr) {
             return;
         }
 
-        if (ma_sound_is_playing(&_currentSound)) {
-            ma_sound_stop(&_currentSound);
+        if (ma_sound_is_playing(sound)) {
+            ma_sound_stop(sound);
         }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
-        ma_sound_uninit(&_currentSound);
-        memset(&_currentSound, 0, sizeof(_currentSound));
+        ma_sound_uninit(sound);
+        memset(sound, 0, sizeof(*sound));
+
+        // o deck será reaproveitado: um fim anotado não vale para o próximo som
+        ma_sound* ended = sound;
+        _endedSound.compare_exchange_strong(ended, nullptr);
+    }
+
+    void Player::cleanupCurrentSound() {
+        cancelCrossfade();
+        cleanupSound(currentSound());
+    }
+
+    float Player::trackGain(const core::Song& song) const {
+        if (_replayGainEnabled && song.hasReplayGain()) {
+            return song.getGainFactor();
+        }
+        return 1.0f;
+    }
+
+    bool Player::loadSound(ma_sound* sound, const core::Song& song) {
+        std::string filePath = song.getAudioFilePath();
+        if (filePath.empty()) {
+            throw std::runtime_error("Caminho vazio");
+        }
+
+        ma_uint32 flags = MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC;
+
+        ma_result result = ma_sound_init_from_file(
+            &_audioEngine, filePath.c_str(), flags, &_mixBus, NULL, sound);
+
+        if (result != MA_SUCCESS) {
+            std::cerr << "Erro ao carregar: " << result << std::endl;
+            return false;
+        }
+
+        ma_sound_set_end_callback(sound, onSoundEnd, this);
+
+        // volume master fica no barramento; o deck carrega só o ganho da faixa
+        ma_sound_set_volume(sound, trackGain(song));
+        ma_sound_set_looping(sound, _isLooping ? MA_TRUE : MA_FALSE);
+
+        return true;
+    }
+
+    bool Player::startCurrentSound() {
+        ma_result result = ma_sound_start(currentSound());
+        if (result != MA_SUCCESS) {
+            std::cerr << "Erro ao iniciar som: " << result << std::endl;
+            return false;
+        }
+
+        _playerState = PlayerState::PLAYING;
+        scheduleCrossfade();
+        publishStatus();
+        return true;
+    }
+
+    void Player::scheduleCrossfade() {
+        cancelCrossfade();
+
+        if (_crossfadeMs == 0 || _isLooping || !_queue || !_currentSong) {
+            return;
+        }
+
+        ma_sound* current = currentSound();
+        if (current->pDataSource == nullptr) {
+            return;
+        }
+
+        auto nextSong = _queue->getNextSong();
+        if (!nextSong) {
+            return;
+        }
+
+        float cursor = 0.0f;
+        float length = 0.0f;
+        ma_sound_get_cursor_in_seconds(current, &cursor);
+        if (ma_sound_get_length_in_seconds(current, &length) != MA_SUCCESS
+            || length <= 0.0f) {
+            // decodificação assíncrona ainda sem tamanho: usa a duração das tags
+            length = static_cast<float>(_currentSong->getDuration());
+        }
+
+        ma_uint64 fade = _crossfadeMs;
+        if (nextSong->getDuration() > 0) {
+            fade = std::min<ma_uint64>(fade, nextSong->getDuration() * 500ull);
+        }
+
+        ma_uint64 remaining =
+            static_cast<ma_uint64>(std::max(0.0f, length - cursor) * 1000.0f);
+        if (remaining <= fade) {
+            return;
+        }
+
+        ma_sound* incoming = standbySound();
+        if (!loadSound(incoming, *nextSong)) {
+            return;
+        }
+
+        ma_uint64 startAt =
+            ma_engine_get_time_in_milliseconds(&_audioEngine) + remaining - fade;
+
+        ma_sound_set_fade_start_in_milliseconds(incoming, 0.0f, 1.0f, fade, startAt);
+        ma_sound_set_start_time_in_milliseconds(incoming, startAt);
+        ma_sound_start(incoming);
+
+        ma_sound_set_fade_start_in_milliseconds(current, -1.0f, 0.0f, fade, startAt);
+
+        _pendingSong = nextSong;
+        _crossfadePending = true;
+    }
+
+    void Player::cancelCrossfade() {
+        if (!_crossfadePending) {
+            return;
+        }
+
+        _crossfadePending = false;
+        _pendingSong.reset();
+        cleanupSound(standbySound());
+
+        ma_sound* current = currentSound();
+        if (current->pDataSource != nullptr) {
+            ma_sound_set_fade_in_milliseconds(current, -1.0f, 1.0f, 0);
+        }
+    }
+
+    bool Player::promoteCrossfade() {
+        if (!_crossfadePending) {
+            return false;
+        }
+
+        finishPlayback();
+
+        ma_sound* outgoing = currentSound();
+        _activeDeck = 1 - _activeDeck;
+        _crossfadePending = false;
+
+        _queue->next();
+        _currentSong = _pendingSong;
+        _pendingSong.reset();
+        captureTrackInfo();
+        beginPlayback();
+
+        cleanupSound(outgoing);
+
+        _playerState = PlayerState::PLAYING;
+        scheduleCrossfade();
+        publishStatus();
+        return true;
     }
 
     bool Player::loadCurrentSong() {
@@ -102,48 +606,53 @@ namespace core {
             throw std::runtime_error("Índice inválido");
         }
 
+        finishPlayback();
         cleanupCurrentSound();
 
         _currentSong = _queue->getCurrentSong();
         if (!_currentSong) {
             throw std::runtime_error("Música nula");
         }
+        captureTrackInfo();
 
-        std::string filePath = _currentSong->getAudioFilePath();
-        if (filePath.empty()) {
-            throw std::runtime_error("Caminho vazio");
-        }
-
-        ma_uint32 flags = MA_SOUND_FLAG_DECODE | MA_SOUND_FLAG_ASYNC;
-
-        ma_result result = ma_sound_init_from_file(
-            &_audioEngine, filePath.c_str(), flags, NULL, NULL, &_currentSound);
-
-        if (result != MA_SUCCESS) {
-            std::cerr << "Erro ao carregar: " << result << std::endl;
+        if (!loadSound(currentSound(), *_currentSong)) {
             return false;
         }
 
-        ma_sound_set_end_callback(&_currentSound, onSoundEnd, this);
-
-        ma_sound_set_volume(&_currentSound, _volume);
-        ma_sound_set_looping(&_currentSound, _isLooping ? MA_TRUE : MA_FALSE);
-        ma_sound_seek_to_pcm_frame(&_currentSound, 0);
+        // a posição salva só vale para a música em que foi salva
+        if (_resumePosition > 0 && _resumeSongId == _currentSong->getId()) {
+            ma_uint64 startFrame = static_cast<ma_uint64>(_resumePosition)
+                                   * soundSampleRate(currentSound());
+            ma_sound_seek_to_pcm_frame(currentSound(), startFrame);
+        }
+        _resumeSongId = 0;
+        _resumePosition = 0;
 
         return true;
     }
 
+    void Player::setResumePosition(unsigned song_id, unsigned int seconds) {
+        _resumeSongId = song_id;
+        _resumePosition = seconds;
+    }
+
     void Player::addPlaybackQueue(const core::PlaybackQueue& tracks) {
         if (tracks.empty()) {
             throw std::invalid_argument("PlaybackQueue nao pode ser vazia");
         }
 
         *_queue += tracks;
+        captureTrackInfo();
+        publishStatus();
     }
 
     void Player::checkAndAdvanceIfNeeded() {
-        if (_shouldAdvanceToNext.load(std::memory_order_acquire)) {
-            _shouldAdvanceToNext.store(false, std::memory_order_release);
+        ma_sound* ended = _endedSound.exchange(nullptr, std::memory_order_acq_rel);
+        if (ended == nullptr || ended != currentSound() || _isLooping) {
+            return;
+        }
+
+        if (!promoteCrossfade()) {
             playNextSong();
         }
     }
@@ -158,10 +667,6 @@ namespace core {
             return;
         }
 
-        if (_currentQueueIndex == -1 && !_queues.empty()) {
-            _currentQueueIndex = 0;
-        }
-
         if (!_queue || _queue->empty()) {
             return;
         }
@@ -170,37 +675,35 @@ namespace core {
             _currentSongIndex = 0;
         }
 
-        if (loadCurrentSong()) {
-            ma_result result = ma_sound_start(&_currentSound);
-            if (result == MA_SUCCESS) {
-                _playerState = PlayerState::PLAYING;
-            }
+        if (loadCurrentSong() && startCurrentSound()) {
+            beginPlayback();
         }
     }
 
     void Player::pause() {
         if (_playerState == PlayerState::PLAYING
-            && ma_sound_is_playing(&_currentSound)) {
-            ma_sound_stop(&_currentSound);
+            && ma_sound_is_playing(currentSound())) {
+            cancelCrossfade();
+            ma_sound_stop(currentSound());
             _playerState = PlayerState::PAUSED;
+            publishStatus();
         }
     }
 
     void Player::resume() {
         if (_playerState == PlayerState::PAUSED
-            && _currentSound.pDataSource != nullptr) {
-            ma_sound_start(&_currentSound);
-            _playerState = PlayerState::PLAYING;
+            && currentSound()->pDataSource != nullptr) {
+            startCurrentSound();
         }
     }
 
     void Player::restart() {
-        if (_currentSound.pDataSource != nullptr) {
-            ma_sound_stop(&_currentSound);
-            ma_sound_seek_to_pcm_frame(&_currentSound, 0);
+        if (currentSound()->pDataSource != nullptr) {
+            cancelCrossfade();
+            ma_sound_stop(currentSound());
+            ma_sound_seek_to_pcm_frame(currentSound(), 0);
 
-            ma_sound_start(&_currentSound);
-            _playerState = PlayerState::PLAYING;
+            startCurrentSound();
         }
     }
 
@@ -214,17 +717,15 @@ namespace core {
 
         if (!nextSong) {
             _playerState = PlayerState::STOPPED;
+            finishPlayback();
             cleanupCurrentSound();
+            captureTrackInfo();
+            publishStatus();
             return;
         }
 
-        if (loadCurrentSong()) {
-            ma_result result = ma_sound_start(&_currentSound);
-            if (result == MA_SUCCESS) {
-                _playerState = PlayerState::PLAYING;
-            } else {
-                std::cerr << "Erro ao iniciar som: " << result << std::endl;
-            }
+        if (loadCurrentSong() && startCurrentSound()) {
+            beginPlayback();
         }
     }
 
@@ -242,21 +743,20 @@ namespace core {
         if (!prevSong)
             return;
 
-        if (loadCurrentSong()) {
-            ma_sound_start(&_currentSound);
-            _playerState = PlayerState::PLAYING;
+        if (loadCurrentSong() && startCurrentSound()) {
+            beginPlayback();
         }
     }
 
     void Player::seek(int seconds) {
-        if (!_currentSong || _currentSound.pDataSource == nullptr) {
+        if (!_currentSong || currentSound()->pDataSource == nullptr) {
             throw std::runtime_error("Música não carregada");
         }
 
         ma_uint64 currentFrame;
-        ma_sound_get_cursor_in_pcm_frames(&_currentSound, &currentFrame);
+        ma_sound_get_cursor_in_pcm_frames(currentSound(), &currentFrame);
 
-        ma_uint64 sampleRate = ma_engine_get_sample_rate(&_audioEngine);
+        ma_uint64 sampleRate = soundSampleRate(currentSound());
         ma_int64 framesToSeek =
             static_cast<ma_int64>(seconds) * static_cast<ma_int64>(sampleRate);
         ma_uint64 newFrame;
@@ -271,8 +771,13 @@ namespace core {
             newFrame = currentFrame + static_cast<ma_uint64>(framesToSeek);
         }
 
-        ma_sound_seek_to_pcm_frame(&_currentSound, newFrame);
+        ma_sound_seek_to_pcm_frame(currentSound(), newFrame);
+
+        if (_playerState == PlayerState::PLAYING) {
+            scheduleCrossfade();
+        }
 
+        publishStatus();
     }
     void Player::rewind(unsigned int seconds) {
         seek(-static_cast<int>(seconds));
@@ -284,16 +789,22 @@ namespace core {
 
     void Player::setLooping() {
         _isLooping = true;
-        if (_currentSound.pDataSource != nullptr) {
-            ma_sound_set_looping(&_currentSound, MA_TRUE);
+        cancelCrossfade();
+        if (currentSound()->pDataSource != nullptr) {
+            ma_sound_set_looping(currentSound(), MA_TRUE);
         }
+        publishStatus();
     }
 
     void Player::unsetLooping() {
         _isLooping = false;
-        if (_currentSound.pDataSource != nullptr) {
-            ma_sound_set_looping(&_currentSound, MA_FALSE);
+        if (currentSound()->pDataSource != nullptr) {
+            ma_sound_set_looping(currentSound(), MA_FALSE);
+            if (_playerState == PlayerState::PLAYING) {
+                scheduleCrossfade();
+            }
         }
+        publishStatus();
     }
 
     bool Player::isLooping() const {
@@ -302,9 +813,10 @@ namespace core {
 
     void Player::setVolume(float volume) {
         _volume = std::max(0.0f, std::min(volume, 1.0f));
-        if (_currentSound.pDataSource != nullptr) {
-            ma_sound_set_volume(&_currentSound, _volume);
+        if (_audioInitialized) {
+            ma_sound_group_set_volume(&_mixBus, _volume);
         }
+        publishStatus();
     }
 
     float Player::getVolume() const {
@@ -333,8 +845,8 @@ namespace core {
         const_cast<Player*>(this)->checkAndAdvanceIfNeeded();
 
         return _playerState == PlayerState::PLAYING
-               && _currentSound.pDataSource != nullptr
-               && ma_sound_is_playing(&_currentSound);
+               && currentSound()->pDataSource != nullptr
+               && ma_sound_is_playing(currentSound());
     }
 
     bool Player::isPaused() const {
@@ -342,38 +854,38 @@ namespace core {
     }
 
     unsigned int Player::getElapsedTime() const {
-        if (!_currentSong || _currentSound.pDataSource == nullptr) {
+        if (!_currentSong || currentSound()->pDataSource == nullptr) {
             return 0;
         }
 
         ma_uint64 currentFrame;
         ma_result result =
-            ma_sound_get_cursor_in_pcm_frames(&_currentSound, &currentFrame);
+            ma_sound_get_cursor_in_pcm_frames(currentSound(), &currentFrame);
 
         if (result != MA_SUCCESS) {
             return 0;
         }
 
-        ma_uint64 sampleRate = ma_engine_get_sample_rate(&_audioEngine);
+        ma_uint64 sampleRate = soundSampleRate(currentSound());
         return static_cast<unsigned int>(currentFrame / sampleRate);
     }
     float Player::getProgress() const {
         const_cast<Player*>(this)->checkAndAdvanceIfNeeded();
 
-        if (!_currentSong || _currentSound.pDataSource == nullptr) {
+        if (!_currentSong || currentSound()->pDataSource == nullptr) {
             return 0.0f;
         }
 
         ma_uint64 lengthInFrames;
         ma_result lengthResult =
-            ma_sound_get_length_in_pcm_frames(&_currentSound, &lengthInFrames);
+            ma_sound_get_length_in_pcm_frames(currentSound(), &lengthInFrames);
 
         if (lengthResult != MA_SUCCESS || lengthInFrames == 0) {
             return 0.0f;
         }
 
         unsigned int elapsed = getElapsedTime();
-        ma_uint64 sampleRate = ma_engine_get_sample_rate(&_audioEngine);
+        ma_uint64 sampleRate = soundSampleRate(currentSound());
         ma_uint64 elapsedFrames = elapsed * sampleRate;
 
         return std::min(1.0f,
@@ -394,12 +906,14 @@ namespace core {
 
     void Player::clearPlaylist() {
         pause();
+        finishPlayback();
         cleanupCurrentSound();
-        _queues.clear();
-        _currentQueueIndex = -1;
+        _queue->clear();
         _currentSongIndex = -1;
         _currentSong.reset();
         _playerState = PlayerState::STOPPED;
+        captureTrackInfo();
+        publishStatus();
     }
 
     bool Player::hasNext() const {
@@ -410,4 +924,62 @@ namespace core {
         return _queue->getPreviousSong() != nullptr;
     }
 
+    void Player::setCrossfade(unsigned milliseconds) {
+        _crossfadeMs = milliseconds;
+
+        if (_playerState == PlayerState::PLAYING) {
+            scheduleCrossfade();
+        } else {
+            cancelCrossfade();
+        }
+        publishStatus();
+    }
+
+    unsigned Player::getCrossfade() const {
+        return _crossfadeMs;
+    }
+
+    void Player::setReplayGain(bool enabled) {
+        _replayGainEnabled = enabled;
+
+        if (_currentSong && currentSound()->pDataSource != nullptr) {
+            ma_sound_set_volume(currentSound(), trackGain(*_currentSong));
+        }
+        if (_pendingSong && standbySound()->pDataSource != nullptr) {
+            ma_sound_set_volume(standbySound(), trackGain(*_pendingSong));
+        }
+    }
+
+    bool Player::isReplayGainEnabled() const {
+        return _replayGainEnabled;
+    }
+
+    void Player::setHistoryWriter(std::shared_ptr<HistoryWriter> writer,
+                                  std::shared_ptr<const User> user) {
+        _historyWriter = writer;
+        _historyUser = user;
+    }
+
+    void Player::beginPlayback() {
+        _playbackStartedAt = _currentSong ? std::time(nullptr) : 0;
+    }
+
+    void Player::finishPlayback() {
+        std::time_t startedAt = _playbackStartedAt;
+        _playbackStartedAt = 0;
+        if (startedAt != 0 && _currentSong)
+            recordPlayback(*_currentSong, currentSound(), startedAt);
+    }
+
+    void Player::recordPlayback(const core::Song& song, ma_sound* sound, std::time_t started_at) {
+        if (!_historyWriter || !_historyUser || sound->pDataSource == nullptr)
+            return;
+
+        // cursor ao parar, não a duração da faixa: pular conta só o que tocou
+        float cursor = 0.0f;
+        ma_sound_get_cursor_in_seconds(sound, &cursor);
+        _historyWriter->record(*_historyUser, song,
+                               static_cast<unsigned>(std::max(0.0f, cursor)), started_at);
+    }
+
 } // namespace core
@@ -0,0 +1,80 @@
+/**
+ * @file PlaylistRebalanceJob.cpp
+ * @brief Implementação da redistribuição das chaves de posição
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include "core/services/PlaylistRebalanceJob.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+namespace core {
+    PlaylistRebalanceJob::PlaylistRebalanceJob(std::shared_ptr<PlaylistRepository> repository,
+                                               size_t max_length)
+        : _repository(repository),
+          _max_length(max_length),
+          _stop_requested(false),
+          _running(false) {
+        if (!_repository)
+            throw std::invalid_argument("Repositório de playlists inválido");
+    }
+
+    PlaylistRebalanceJob::~PlaylistRebalanceJob() {
+        stop();
+    }
+
+    RebalanceReport PlaylistRebalanceJob::run() {
+        RebalanceReport report;
+
+        for (unsigned playlist_id : _repository->findUnbalanced(_max_length)) {
+            if (_stop_requested.load())
+                break;
+
+            try {
+                report.rows += _repository->rebalance(playlist_id);
+                ++report.playlists;
+            } catch (const SQLite::Exception &e) {
+                // a playlist foi gravada por outra conexão no meio da leitura;
+                // continua longa e volta na próxima execução
+                std::cerr << "Playlist " << playlist_id << " não redistribuída: "
+                          << e.what() << std::endl;
+            }
+        }
+
+        return report;
+    }
+
+    void PlaylistRebalanceJob::start() {
+        if (_running.load())
+            return;
+
+        if (_thread.joinable())
+            _thread.join();
+
+        _stop_requested.store(false);
+        _running.store(true);
+        _thread = std::thread([this]() {
+            try {
+                run();
+            } catch (const std::exception &e) {
+                std::cerr << "Erro ao redistribuir as playlists: " << e.what() << std::endl;
+            }
+            _running.store(false);
+        });
+    }
+
+    void PlaylistRebalanceJob::stop() {
+        _stop_requested.store(true);
+        if (_thread.joinable())
+            _thread.join();
+        _stop_requested.store(false);
+    }
+
+    bool PlaylistRebalanceJob::isRunning() const {
+        return _running.load();
+    }
+}
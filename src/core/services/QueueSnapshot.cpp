@@ -0,0 +1,208 @@
+/**
+ * @file QueueSnapshot.cpp
+ * @brief Implementação do snapshot da fila de reprodução
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#include "core/services/QueueSnapshot.hpp"
+#include "core/services/PlaybackQueue.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace core {
+    static const char SNAPSHOT_MAGIC[4] = {'F', 'K', 'Q', 'S'};
+    static const uint8_t SNAPSHOT_VERSION = 1;
+
+    static const uint8_t FLAG_ALEATORY = 1;
+    static const uint8_t FLAG_LOOP = 2;
+
+    static uint32_t fnv1a(const std::string &data, size_t length) {
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<uint8_t>(data[i]);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    static void putVarint(std::string &out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    namespace {
+        struct Reader {
+            const std::string &data;
+            size_t end;
+            size_t pos = 0;
+
+            uint8_t byte() {
+                if (pos >= end)
+                    throw std::runtime_error("Snapshot da fila truncado");
+                return static_cast<uint8_t>(data[pos++]);
+            }
+
+            uint64_t varint() {
+                uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7) {
+                    uint8_t b = byte();
+                    value |= static_cast<uint64_t>(b & 0x7f) << shift;
+                    if (!(b & 0x80))
+                        return value;
+                }
+                throw std::runtime_error("Snapshot da fila corrompido");
+            }
+
+            /**
+             * @brief Lê um tamanho de lista, limitado pelos bytes restantes
+             */
+            size_t count() {
+                uint64_t value = varint();
+                if (value > end - pos)
+                    throw std::runtime_error("Snapshot da fila corrompido");
+                return static_cast<size_t>(value);
+            }
+        };
+    }
+
+    void QueueSnapshot::retain(const std::function<bool(unsigned)> &keep) {
+        const size_t removed = static_cast<size_t>(-1);
+        std::vector<size_t> remap(song_ids.size(), removed);
+        std::vector<bool> isDrawn(song_ids.size(), false);
+        for (uint32_t index : drawn)
+            isDrawn[index] = true;
+
+        // posição atual na ordem ativa: histórico, sorteadas, não sorteadas
+        auto activeAt = [&](uint64_t position) -> size_t {
+            if (position < history)
+                return static_cast<size_t>(position);
+            if (position < history + drawn.size())
+                return drawn[position - history];
+
+            uint64_t skip = position - history - drawn.size();
+            for (size_t i = history; i < song_ids.size(); ++i) {
+                if (!isDrawn[i] && skip-- == 0)
+                    return i;
+            }
+            return song_ids.size();
+        };
+
+        std::vector<bool> kept(song_ids.size(), false);
+        std::vector<unsigned> ids;
+        size_t keptHistory = 0;
+        for (size_t i = 0; i < song_ids.size(); ++i) {
+            if (!keep(song_ids[i]))
+                continue;
+
+            kept[i] = true;
+            remap[i] = ids.size();
+            ids.push_back(song_ids[i]);
+            if (i < history)
+                keptHistory++;
+        }
+
+        // quantas mantidas vêm antes da atual na ordem ativa
+        uint64_t keptCurrent = 0;
+        for (uint64_t position = 0; position < current; ++position) {
+            size_t index = activeAt(position);
+            if (index < kept.size() && kept[index])
+                keptCurrent++;
+        }
+
+        std::vector<uint32_t> keptDrawn;
+        for (uint32_t index : drawn) {
+            if (kept[index])
+                keptDrawn.push_back(static_cast<uint32_t>(remap[index]));
+        }
+
+        song_ids = std::move(ids);
+        drawn = std::move(keptDrawn);
+        history = keptHistory;
+        current = song_ids.empty() ? 0 : std::min<uint64_t>(keptCurrent, song_ids.size() - 1);
+    }
+
+    std::string QueueSnapshot::encode() const {
+        std::string out(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        out.reserve(16 + song_ids.size() * 3 + drawn.size() * 3);
+        out.push_back(static_cast<char>(SNAPSHOT_VERSION));
+        out.push_back(static_cast<char>((aleatory ? FLAG_ALEATORY : 0) | (loop ? FLAG_LOOP : 0)));
+        out.push_back(static_cast<char>(shuffle_mode));
+
+        putVarint(out, current);
+        putVarint(out, history);
+        putVarint(out, position);
+
+        putVarint(out, song_ids.size());
+        for (unsigned id : song_ids)
+            putVarint(out, id);
+
+        putVarint(out, drawn.size());
+        for (uint32_t index : drawn)
+            putVarint(out, index);
+
+        uint32_t checksum = fnv1a(out, out.size());
+        for (int i = 0; i < 4; ++i)
+            out.push_back(static_cast<char>((checksum >> (8 * i)) & 0xff));
+
+        return out;
+    }
+
+    QueueSnapshot QueueSnapshot::decode(const std::string &data) {
+        if (data.size() < sizeof(SNAPSHOT_MAGIC) + 4
+            || data.compare(0, sizeof(SNAPSHOT_MAGIC), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+            throw std::runtime_error("Snapshot da fila inválido");
+
+        size_t end = data.size() - 4;
+        uint32_t checksum = 0;
+        for (int i = 0; i < 4; ++i)
+            checksum |= static_cast<uint32_t>(static_cast<uint8_t>(data[end + i])) << (8 * i);
+        if (checksum != fnv1a(data, end))
+            throw std::runtime_error("Snapshot da fila corrompido");
+
+        Reader in{data, end, sizeof(SNAPSHOT_MAGIC)};
+        if (in.byte() != SNAPSHOT_VERSION)
+            throw std::runtime_error("Versão do snapshot da fila não suportada");
+
+        QueueSnapshot snapshot;
+        uint8_t flags = in.byte();
+        snapshot.aleatory = flags & FLAG_ALEATORY;
+        snapshot.loop = flags & FLAG_LOOP;
+        uint8_t mode = in.byte();
+        if (mode > static_cast<uint8_t>(ShuffleMode::SMART))
+            throw std::runtime_error("Snapshot da fila corrompido");
+        snapshot.shuffle_mode = static_cast<ShuffleMode>(mode);
+
+        snapshot.current = in.varint();
+        snapshot.history = in.varint();
+        snapshot.position = static_cast<uint32_t>(in.varint());
+
+        snapshot.song_ids.resize(in.count());
+        for (auto &id : snapshot.song_ids)
+            id = static_cast<unsigned>(in.varint());
+
+        snapshot.drawn.resize(in.count());
+        for (auto &index : snapshot.drawn)
+            index = static_cast<uint32_t>(in.varint());
+
+        // as posições precisam caber na lista de músicas
+        size_t songs = snapshot.song_ids.size();
+        std::vector<bool> seen(songs, false);
+        for (uint32_t index : snapshot.drawn) {
+            if (index >= songs || index < snapshot.history || seen[index])
+                throw std::runtime_error("Snapshot da fila corrompido");
+            seen[index] = true;
+        }
+        if (snapshot.history > songs || (songs > 0 && snapshot.current >= songs)
+            || (songs == 0 && snapshot.current != 0))
+            throw std::runtime_error("Snapshot da fila corrompido");
+
+        return snapshot;
+    }
+}
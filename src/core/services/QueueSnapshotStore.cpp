@@ -0,0 +1,113 @@
+/**
+ * @file QueueSnapshotStore.cpp
+ * @brief Implementação da persistência da fila de reprodução
+ *
+ * @ingroup services
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#include "core/services/QueueSnapshotStore.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace core {
+    QueueSnapshotStore::QueueSnapshotStore(std::string path,
+                                           std::chrono::milliseconds debounce)
+        : _path(std::move(path)),
+          _debounce(debounce),
+          _saved_revision(0),
+          _has_saved(false) {}
+
+    bool QueueSnapshotStore::save(const PlaybackQueue& queue, uint32_t position) {
+        QueueSnapshot snapshot = queue.snapshot();
+        snapshot.position = position;
+        std::string data = snapshot.encode();
+
+        std::string temporary = _path + ".tmp";
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file)
+                return false;
+            file.write(data.data(), static_cast<std::streamsize>(data.size()));
+            if (!file)
+                return false;
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, _path, error);
+        if (error)
+            return false;
+
+        _saved_revision = queue.revision();
+        _has_saved = true;
+        _last_save = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    bool QueueSnapshotStore::isDirty(const PlaybackQueue& queue) const {
+        return !_has_saved || queue.revision() != _saved_revision;
+    }
+
+    bool QueueSnapshotStore::saveIfChanged(const PlaybackQueue& queue, uint32_t position) {
+        if (!isDirty(queue))
+            return false;
+
+        if (_has_saved && std::chrono::steady_clock::now() - _last_save < _debounce)
+            return false;
+
+        return save(queue, position);
+    }
+
+    bool QueueSnapshotStore::load(QueueSnapshot& snapshot) const {
+        std::ifstream file(_path, std::ios::binary);
+        if (!file)
+            return false;
+
+        std::string data((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+
+        try {
+            snapshot = QueueSnapshot::decode(data);
+        } catch (const std::exception& e) {
+            std::cerr << "Ignorando fila salva em '" << _path << "': " << e.what()
+                      << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool QueueSnapshotStore::restore(PlaybackQueue& queue,
+                                     std::shared_ptr<SongRepository> songs,
+                                     uint32_t& position) {
+        QueueSnapshot snapshot;
+        if (!load(snapshot))
+            return false;
+
+        auto existing = songs->findAllIds();
+        snapshot.retain([&existing](unsigned id) { return existing.count(id) > 0; });
+
+        try {
+            queue.restore(snapshot, [songs](unsigned id) { return songs->findById(id); });
+        } catch (const std::exception& e) {
+            std::cerr << "Ignorando fila salva em '" << _path << "': " << e.what()
+                      << std::endl;
+            return false;
+        }
+
+        position = snapshot.position;
+        _saved_revision = queue.revision();
+        _has_saved = true;
+        _last_save = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    const std::string& QueueSnapshotStore::path() const {
+        return _path;
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * @file Collation.cpp
+ * @brief Implementação das chaves de ordenação
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-01
+ */
+
+#include "core/util/Collation.hpp"
+
+namespace core {
+
+    namespace {
+        // letra base de U+00C0 a U+00FF; '*' = mais de uma letra, '-' = mantém
+        const char LATIN1[] =
+            "aaaaaa*ceeeeiiii"  // U+00C0
+            "dnooooo-ouuuuy**"  // U+00D0
+            "aaaaaa*ceeeeiiii"  // U+00E0
+            "dnooooo-ouuuuy*y"; // U+00F0
+
+        // letra base de U+0100 a U+017F
+        const char LATIN_EXTENDED_A[] =
+            "aaaaaaccccccccdd"  // U+0100
+            "ddeeeeeeeeeegggg"  // U+0110
+            "gggghhhhiiiiiiii"  // U+0120
+            "ii**jjkkklllllll"  // U+0130
+            "lllnnnnnnnnnoooo"  // U+0140
+            "oo**rrrrrrssssss"  // U+0150
+            "ssttttttuuuuuuuu"  // U+0160
+            "uuuuwwyyyzzzzzzs"; // U+0170
+
+        const char *expand(unsigned code) {
+            switch (code) {
+            case 0x00C6: case 0x00E6: return "ae";
+            case 0x00DE: case 0x00FE: return "th";
+            case 0x00DF: return "ss";
+            case 0x0132: case 0x0133: return "ij";
+            case 0x0152: case 0x0153: return "oe";
+            default: return nullptr;
+            }
+        }
+
+        // decodifica um caractere de 2 bytes; retorna 0 se não for um
+        unsigned decodeTwoBytes(const std::string &text, size_t i) {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            if ((lead & 0xE0) != 0xC0 || i + 1 >= text.size())
+                return 0;
+            unsigned char next = static_cast<unsigned char>(text[i + 1]);
+            if ((next & 0xC0) != 0x80)
+                return 0;
+            return ((lead & 0x1Fu) << 6) | (next & 0x3Fu);
+        }
+    }
+
+    std::string collationKey(const std::string &text) {
+        std::string key;
+        key.reserve(text.size());
+
+        for (size_t i = 0; i < text.size();) {
+            char c = text[i];
+            if (static_cast<unsigned char>(c) < 0x80) {
+                key += (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+                ++i;
+                continue;
+            }
+
+            unsigned code = decodeTwoBytes(text, i);
+            char base = '-';
+            if (code >= 0x00C0 && code <= 0x00FF)
+                base = LATIN1[code - 0x00C0];
+            else if (code >= 0x0100 && code <= 0x017F)
+                base = LATIN_EXTENDED_A[code - 0x0100];
+            else if (code >= 0x0300 && code <= 0x036F)
+                base = 0;  // marca combinante: acento de texto decomposto
+
+            if (base == '-') {
+                key += c;
+                ++i;
+                continue;
+            }
+
+            if (base == '*')
+                key += expand(code);
+            else if (base != 0)
+                key += base;
+            i += 2;
+        }
+
+        return key;
+    }
+
+    std::string collationPrefixEnd(const std::string &prefix) {
+        std::string end = prefix;
+        while (!end.empty() && static_cast<unsigned char>(end.back()) == 0xFF)
+            end.pop_back();
+        if (!end.empty())
+            end.back() = static_cast<char>(static_cast<unsigned char>(end.back()) + 1);
+        return end;
+    }
+}
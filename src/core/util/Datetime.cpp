@@ -1,46 +1,135 @@
 #include "core/util/Datetime.hpp"
 
 namespace core {
-    Datetime::Datetime() {
-        timePoint = std::chrono::system_clock::now();
+
+    namespace {
+        const std::int64_t SECONDS_PER_DAY = 86400;
+
+        // dias desde 1970-01-01 no calendário gregoriano proléptico
+        std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) {
+            year -= month <= 2;
+            std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+            unsigned yoe = static_cast<unsigned>(year - era * 400);
+            unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+            unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+            return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+        }
+
+        void civilFromDays(std::int64_t days, std::int64_t &year, unsigned &month, unsigned &day) {
+            days += 719468;
+            std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            unsigned doe = static_cast<unsigned>(days - era * 146097);
+            unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+            unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+            unsigned mp = (5 * doy + 2) / 153;
+            day = doy - (153 * mp + 2) / 5 + 1;
+            month = mp < 10 ? mp + 3 : mp - 9;
+            year = static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2);
+        }
+
+        std::int64_t floorDiv(std::int64_t value, std::int64_t divisor) {
+            std::int64_t q = value / divisor;
+            return (value % divisor != 0 && value < 0) ? q - 1 : q;
+        }
+
+        // lê até max_digits dígitos a partir de pos; devolve quantos leu
+        size_t readNumber(const std::string &text, size_t pos, size_t max_digits, unsigned &value) {
+            size_t read = 0;
+            value = 0;
+            while (pos + read < text.size() && read < max_digits
+                   && text[pos + read] >= '0' && text[pos + read] <= '9') {
+                value = value * 10 + static_cast<unsigned>(text[pos + read] - '0');
+                ++read;
+            }
+            return read;
+        }
+
+        void writeNumber(std::string &out, std::int64_t value, size_t width) {
+            char digits[20];
+            size_t n = 0;
+            do {
+                digits[n++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value > 0 && n < sizeof(digits));
+            for (size_t i = n; i < width; ++i)
+                out.push_back('0');
+            while (n > 0)
+                out.push_back(digits[--n]);
+        }
     }
 
+    Datetime::Datetime(std::int64_t seconds) : _seconds(seconds) {}
+
     Datetime::Datetime(const std::string& datetimeStr) {
-        int len = datetimeStr.length();
-        if(len < 8 || len > 10) {
-            timePoint = std::chrono::system_clock::now();
+        // campos numéricos separados por qualquer outro caractere
+        unsigned fields[6] = {0, 0, 0, 0, 0, 0};
+        size_t widths[6] = {0, 0, 0, 0, 0, 0};
+        size_t count = 0, pos = 0;
+        while (pos < datetimeStr.size() && count < 6) {
+            size_t read = readNumber(datetimeStr, pos, 4, fields[count]);
+            if (read == 0) {
+                ++pos;
+                continue;
+            }
+            widths[count++] = read;
+            pos += read;
+        }
+        if (count < 3)
             return;
+
+        unsigned day, month;
+        std::int64_t year;
+        if (widths[0] == 4) {
+            year = fields[0];
+            month = fields[1];
+            day = fields[2];
+        } else {
+            day = fields[0];
+            month = fields[1];
+            year = fields[2];
         }
+        if (month < 1 || month > 12 || day < 1 || day > 31 || fields[3] > 23
+            || fields[4] > 59 || fields[5] > 60)
+            return;
 
-        std::tm t = {};
-        int ano;
-        std::stringstream ss(datetimeStr);
-        ss >> t.tm_mday;
-        ss >> t.tm_mon;
-        ss >> ano;
-        ano -= 1900;
-        t.tm_year = ano;
+        _seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY
+                   + fields[3] * 3600 + fields[4] * 60 + fields[5];
+    }
+
+    Datetime Datetime::now() {
+        auto since = std::chrono::system_clock::now().time_since_epoch();
+        return Datetime(std::chrono::duration_cast<std::chrono::seconds>(since).count());
+    }
+
+    bool Datetime::isSet() const {
+        return _seconds != 0;
+    }
 
-        std::time_t tt = std::mktime(&t);
-        timePoint = std::chrono::system_clock::from_time_t(tt);
+    std::int64_t Datetime::getSeconds() const {
+        return _seconds;
     }
 
-    const std::chrono::system_clock::time_point& Datetime::getTimePoint() const {
-        return timePoint;
+    std::chrono::system_clock::time_point Datetime::getTimePoint() const {
+        return std::chrono::system_clock::time_point(std::chrono::seconds(_seconds));
     }
 
     const std::string Datetime::toString() const {
-        std::string format = "%Y/%m/%d";
-        std::time_t tt = std::chrono::system_clock::to_time_t(timePoint);
-        std::tm* localTm = std::localtime(&tt);
+        std::int64_t year;
+        unsigned month, day;
+        civilFromDays(floorDiv(_seconds, SECONDS_PER_DAY), year, month, day);
 
-        std::stringstream ss;
-        ss << std::put_time(localTm, format.c_str());
-        return ss.str();
+        std::string out;
+        out.reserve(10);
+        writeNumber(out, year, 4);
+        out.push_back('/');
+        writeNumber(out, month, 2);
+        out.push_back('/');
+        writeNumber(out, day, 2);
+        return out;
     }
 
     bool Datetime::operator==(const Datetime& other) const {
-        return this->toString() == other.toString();
+        return floorDiv(_seconds, SECONDS_PER_DAY) == floorDiv(other._seconds, SECONDS_PER_DAY);
     }
 
     bool Datetime::operator!=(const Datetime& other) const {
@@ -49,12 +138,12 @@ namespace core {
 
     bool Datetime::isBefore(const Datetime& other) const {
         if((*this) == other) return false;
-        return this->getTimePoint() < other.getTimePoint();
+        return _seconds < other._seconds;
 
     }
 
     bool Datetime::isAfter(const Datetime& other) const {
         if((*this) == other) return false;
-        return this->getTimePoint() > other.getTimePoint();
+        return _seconds > other._seconds;
     }
-}
\ No newline at end of file
+}
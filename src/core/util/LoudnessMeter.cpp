@@ -0,0 +1,229 @@
+/**
+ * @file LoudnessMeter.cpp
+ * @brief Implementação do medidor de loudness EBU R128
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#include "core/util/LoudnessMeter.hpp"
+#include "core/util/SimdKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace core {
+
+    namespace {
+        const double PI = 3.14159265358979323846;
+
+        const double ABSOLUTE_GATE_LUFS = -70.0;
+        const double RELATIVE_GATE_LU = -10.0;
+
+        const unsigned OVERSAMPLING = 4;
+        const unsigned TAPS_PER_PHASE = 12;
+
+        double energyToLoudness(double energy) {
+            return -0.691 + 10.0 * std::log10(energy);
+        }
+    }
+
+    LoudnessMeter::LoudnessMeter(unsigned sample_rate, unsigned channels)
+        : _sample_rate(sample_rate), _channels(channels) {
+        if (sample_rate == 0 || channels == 0)
+            throw std::invalid_argument("Formato de áudio inválido");
+
+        // Estágio 1: shelf de alta frequência (modelo da cabeça), BS.1770
+        double f0 = 1681.974450955533;
+        double G = 3.999843853973347;
+        double Q = 0.7071752369554196;
+        double K = std::tan(PI * f0 / sample_rate);
+        double Vh = std::pow(10.0, G / 20.0);
+        double Vb = std::pow(Vh, 0.4996667741545416);
+        double a0 = 1.0 + K / Q + K * K;
+        _stages[0] = {(Vh + Vb * K / Q + K * K) / a0,
+                      2.0 * (K * K - Vh) / a0,
+                      (Vh - Vb * K / Q + K * K) / a0,
+                      2.0 * (K * K - 1.0) / a0,
+                      (1.0 - K / Q + K * K) / a0};
+
+        // Estágio 2: passa-altas RLB
+        f0 = 38.13547087602444;
+        Q = 0.5003270373238773;
+        K = std::tan(PI * f0 / sample_rate);
+        a0 = 1.0 + K / Q + K * K;
+        _stages[1] = {1.0, -2.0, 1.0,
+                      2.0 * (K * K - 1.0) / a0,
+                      (1.0 - K / Q + K * K) / a0};
+
+        // Filtro de interpolação: sinc janelado (Hann) dividido em fases
+        const unsigned taps = OVERSAMPLING * TAPS_PER_PHASE;
+        std::vector<double> h(taps);
+        double center = (taps - 1) / 2.0;
+        for (unsigned n = 0; n < taps; ++n) {
+            double x = (n - center) / OVERSAMPLING;
+            double sinc = x == 0.0 ? 1.0 : std::sin(PI * x) / (PI * x);
+            double window = 0.5 - 0.5 * std::cos(2.0 * PI * n / (taps - 1));
+            h[n] = sinc * window;
+        }
+
+        _phases.assign(OVERSAMPLING, std::vector<float>(TAPS_PER_PHASE));
+        for (unsigned p = 0; p < OVERSAMPLING; ++p)
+            for (unsigned k = 0; k < TAPS_PER_PHASE; ++k)
+                _phases[p][k] = static_cast<float>(h[p + OVERSAMPLING * k]);
+
+        _subblock_frames = std::max<size_t>(1, sample_rate / 10);
+        reset();
+    }
+
+    void LoudnessMeter::reset() {
+        _state.assign(_channels, ChannelState());
+        for (unsigned c = 0; c < _channels; ++c) {
+            _state[c].history.assign(TAPS_PER_PHASE - 1, 0.0f);
+
+            // 5.1: LFE fora da medição, surrounds com +1.5 dB
+            if (_channels == 6) {
+                if (c == 3)
+                    _state[c].weight = 0.0f;
+                else if (c >= 4)
+                    _state[c].weight = 1.41f;
+            }
+        }
+
+        _subblock_filled = 0;
+        _subblock_energy = 0.0;
+        _recent_subblocks.clear();
+        _block_energies.clear();
+        _true_peak = 0.0f;
+    }
+
+    void LoudnessMeter::addFrames(const float *interleaved, size_t frames) {
+        while (frames > 0) {
+            size_t chunk = std::min(frames, _subblock_frames - _subblock_filled);
+
+            for (unsigned c = 0; c < _channels; ++c)
+                processChannel(c, interleaved, chunk);
+
+            _subblock_filled += chunk;
+            if (_subblock_filled == _subblock_frames)
+                closeSubblock();
+
+            interleaved += chunk * _channels;
+            frames -= chunk;
+        }
+    }
+
+    void LoudnessMeter::processChannel(unsigned channel, const float *interleaved, size_t frames) {
+        ChannelState &state = _state[channel];
+
+        _channel_buffer.resize(frames);
+        _filtered_buffer.resize(frames);
+        for (size_t i = 0; i < frames; ++i)
+            _channel_buffer[i] = interleaved[i * _channels + channel];
+
+        updateTruePeak(state, _channel_buffer.data(), frames);
+
+        if (state.weight == 0.0f)
+            return;
+
+        // o IIR é serial por natureza; a soma de energia é que vetoriza
+        for (size_t i = 0; i < frames; ++i) {
+            double x = _channel_buffer[i];
+            for (int s = 0; s < 2; ++s) {
+                const Biquad &bq = _stages[s];
+                double y = bq.b0 * x + state.z1[s];
+                state.z1[s] = bq.b1 * x - bq.a1 * y + state.z2[s];
+                state.z2[s] = bq.b2 * x - bq.a2 * y;
+                x = y;
+            }
+            _filtered_buffer[i] = static_cast<float>(x);
+        }
+
+        _subblock_energy += state.weight * simd::sumOfSquares(_filtered_buffer.data(), frames);
+    }
+
+    void LoudnessMeter::updateTruePeak(ChannelState &state, const float *samples, size_t frames) {
+        const size_t history = TAPS_PER_PHASE - 1;
+
+        // janela contígua: histórico da chamada anterior + amostras novas
+        std::vector<float> &window = state.history;
+        window.resize(history);
+        window.insert(window.end(), samples, samples + frames);
+
+        _oversampled_buffer.resize(frames);
+        for (unsigned p = 0; p < OVERSAMPLING; ++p) {
+            std::fill(_oversampled_buffer.begin(), _oversampled_buffer.end(), 0.0f);
+            for (unsigned k = 0; k < TAPS_PER_PHASE; ++k) {
+                simd::multiplyAdd(_phases[p][k],
+                                  window.data() + history - k,
+                                  _oversampled_buffer.data(),
+                                  frames);
+            }
+            _true_peak = std::max(_true_peak, simd::maxAbs(_oversampled_buffer.data(), frames));
+        }
+
+        _true_peak = std::max(_true_peak, simd::maxAbs(samples, frames));
+
+        window.erase(window.begin(), window.end() - history);
+    }
+
+    void LoudnessMeter::closeSubblock() {
+        _recent_subblocks.push_back(_subblock_energy);
+        if (_recent_subblocks.size() > 4)
+            _recent_subblocks.erase(_recent_subblocks.begin());
+
+        if (_recent_subblocks.size() == 4) {
+            double sum = 0.0;
+            for (double e : _recent_subblocks)
+                sum += e;
+            _block_energies.push_back(sum / (4.0 * _subblock_frames));
+        }
+
+        _subblock_filled = 0;
+        _subblock_energy = 0.0;
+    }
+
+    double LoudnessMeter::integratedLoudness() const {
+        double absoluteSum = 0.0;
+        size_t absoluteCount = 0;
+
+        for (double e : _block_energies) {
+            if (e > 0.0 && energyToLoudness(e) > ABSOLUTE_GATE_LUFS) {
+                absoluteSum += e;
+                ++absoluteCount;
+            }
+        }
+
+        if (absoluteCount == 0)
+            return ABSOLUTE_GATE_LUFS;
+
+        double relativeGate = energyToLoudness(absoluteSum / absoluteCount) + RELATIVE_GATE_LU;
+
+        double gatedSum = 0.0;
+        size_t gatedCount = 0;
+        for (double e : _block_energies) {
+            if (e <= 0.0)
+                continue;
+            double loudness = energyToLoudness(e);
+            if (loudness > ABSOLUTE_GATE_LUFS && loudness > relativeGate) {
+                gatedSum += e;
+                ++gatedCount;
+            }
+        }
+
+        if (gatedCount == 0)
+            return ABSOLUTE_GATE_LUFS;
+
+        return energyToLoudness(gatedSum / gatedCount);
+    }
+
+    float LoudnessMeter::truePeak() const {
+        return _true_peak;
+    }
+
+    double LoudnessMeter::replayGain() const {
+        return REPLAY_GAIN_REFERENCE_LUFS - integratedLoudness();
+    }
+}
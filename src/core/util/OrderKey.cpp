@@ -0,0 +1,92 @@
+/**
+ * @file OrderKey.cpp
+ * @brief Implementação das chaves de posição fracionárias
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-02
+ */
+
+#include "core/util/OrderKey.hpp"
+
+#include <stdexcept>
+
+namespace core {
+
+    namespace {
+        const int BASE = 26;
+
+        int digit(const std::string &key, size_t i) {
+            return i < key.size() ? key[i] - 'a' : 0;
+        }
+
+        // before < after, ambas sem 'a' no final; after vazia vale 1
+        std::string midpoint(const std::string &before, const std::string &after) {
+            if (!after.empty()) {
+                size_t common = 0;
+                while (common < after.size() && digit(before, common) == digit(after, common))
+                    ++common;
+                if (common > 0) {
+                    std::string rest = common < before.size() ? before.substr(common) : "";
+                    return after.substr(0, common) + midpoint(rest, after.substr(common));
+                }
+            }
+
+            int low = digit(before, 0);
+            int high = after.empty() ? BASE : digit(after, 0);
+            if (high - low > 1)
+                return std::string(1, static_cast<char>('a' + (low + high) / 2));
+
+            // dígitos vizinhos: o primeiro dígito de after já basta se ela for mais longa
+            if (after.size() > 1)
+                return after.substr(0, 1);
+
+            std::string rest = before.size() > 1 ? before.substr(1) : "";
+            return std::string(1, static_cast<char>('a' + low)) + midpoint(rest, "");
+        }
+
+        void spread(const std::string &before, const std::string &after, size_t count,
+                    std::vector<std::string> &keys) {
+            if (count == 0)
+                return;
+
+            std::string middle = midpoint(before, after);
+            size_t left = (count - 1) / 2;
+            spread(before, middle, left, keys);
+            keys.push_back(middle);
+            spread(middle, after, count - 1 - left, keys);
+        }
+
+        void checkBounds(const std::string &before, const std::string &after) {
+            if ((!before.empty() && !isOrderKey(before)) || (!after.empty() && !isOrderKey(after)))
+                throw std::invalid_argument("Chave de posição inválida");
+            if (!before.empty() && !after.empty() && before >= after)
+                throw std::invalid_argument("Chaves de posição fora de ordem");
+        }
+    }
+
+    bool isOrderKey(const std::string &key) {
+        if (key.empty() || key.back() == 'a')
+            return false;
+        for (char c : key) {
+            if (c < 'a' || c > 'z')
+                return false;
+        }
+        return true;
+    }
+
+    std::string orderKeyBetween(const std::string &before, const std::string &after) {
+        checkBounds(before, after);
+        return midpoint(before, after);
+    }
+
+    std::vector<std::string> orderKeysBetween(const std::string &before,
+                                              const std::string &after, size_t count) {
+        checkBounds(before, after);
+
+        std::vector<std::string> keys;
+        keys.reserve(count);
+        spread(before, after, count, keys);
+        return keys;
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * @file SimdKernels.cpp
+ * @brief Implementação dos kernels vetorizados de análise de áudio
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-20
+ */
+
+#include "core/util/SimdKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define FRANKENSTEIN_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FRANKENSTEIN_SIMD_SSE2 1
+#endif
+
+namespace core {
+    namespace simd {
+
+        // acumulação parcial em float por bloco, somada em double, para não
+        // perder precisão em faixas longas
+        static const size_t ACCUMULATION_BLOCK = 4096;
+
+        namespace scalar {
+            double sumOfSquares(const float *data, size_t count) {
+                double total = 0.0;
+                for (size_t i = 0; i < count; ++i)
+                    total += static_cast<double>(data[i]) * data[i];
+                return total;
+            }
+
+            float maxAbs(const float *data, size_t count) {
+                float peak = 0.0f;
+                for (size_t i = 0; i < count; ++i)
+                    peak = std::max(peak, std::fabs(data[i]));
+                return peak;
+            }
+
+            void multiplyAdd(float gain, const float *in, float *out, size_t count) {
+                for (size_t i = 0; i < count; ++i)
+                    out[i] += gain * in[i];
+            }
+        }
+
+#if defined(FRANKENSTEIN_SIMD_AVX)
+
+        const char *instructionSet() {
+            return "AVX";
+        }
+
+        static float horizontalSum(__m256 v) {
+            __m128 low = _mm256_castps256_ps128(v);
+            __m128 high = _mm256_extractf128_ps(v, 1);
+            low = _mm_add_ps(low, high);
+            __m128 shuf = _mm_movehdup_ps(low);
+            __m128 sums = _mm_add_ps(low, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ss(sums, shuf);
+            return _mm_cvtss_f32(sums);
+        }
+
+        double sumOfSquares(const float *data, size_t count) {
+            double total = 0.0;
+            size_t i = 0;
+
+            while (count - i >= 8) {
+                size_t end = std::min(count - (count - i) % 8, i + ACCUMULATION_BLOCK);
+                __m256 acc = _mm256_setzero_ps();
+                for (; i < end; i += 8) {
+                    __m256 v = _mm256_loadu_ps(data + i);
+                    acc = _mm256_add_ps(acc, _mm256_mul_ps(v, v));
+                }
+                total += horizontalSum(acc);
+            }
+
+            return total + scalar::sumOfSquares(data + i, count - i);
+        }
+
+        float maxAbs(const float *data, size_t count) {
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            __m256 peak = _mm256_setzero_ps();
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                __m256 v = _mm256_and_ps(_mm256_loadu_ps(data + i), signMask);
+                peak = _mm256_max_ps(peak, v);
+            }
+
+            alignas(32) float lanes[8];
+            _mm256_store_ps(lanes, peak);
+            float result = *std::max_element(lanes, lanes + 8);
+
+            return std::max(result, scalar::maxAbs(data + i, count - i));
+        }
+
+        void multiplyAdd(float gain, const float *in, float *out, size_t count) {
+            const __m256 g = _mm256_set1_ps(gain);
+            size_t i = 0;
+
+            for (; i + 8 <= count; i += 8) {
+                __m256 acc = _mm256_loadu_ps(out + i);
+                acc = _mm256_add_ps(acc, _mm256_mul_ps(g, _mm256_loadu_ps(in + i)));
+                _mm256_storeu_ps(out + i, acc);
+            }
+
+            scalar::multiplyAdd(gain, in + i, out + i, count - i);
+        }
+
+#elif defined(FRANKENSTEIN_SIMD_SSE2)
+
+        const char *instructionSet() {
+            return "SSE2";
+        }
+
+        static float horizontalSum(__m128 v) {
+            __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            __m128 sums = _mm_add_ps(v, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ss(sums, shuf);
+            return _mm_cvtss_f32(sums);
+        }
+
+        double sumOfSquares(const float *data, size_t count) {
+            double total = 0.0;
+            size_t i = 0;
+
+            while (count - i >= 4) {
+                size_t end = std::min(count - (count - i) % 4, i + ACCUMULATION_BLOCK);
+                __m128 acc = _mm_setzero_ps();
+                for (; i < end; i += 4) {
+                    __m128 v = _mm_loadu_ps(data + i);
+                    acc = _mm_add_ps(acc, _mm_mul_ps(v, v));
+                }
+                total += horizontalSum(acc);
+            }
+
+            return total + scalar::sumOfSquares(data + i, count - i);
+        }
+
+        float maxAbs(const float *data, size_t count) {
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            __m128 peak = _mm_setzero_ps();
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 v = _mm_and_ps(_mm_loadu_ps(data + i), signMask);
+                peak = _mm_max_ps(peak, v);
+            }
+
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, peak);
+            float result = *std::max_element(lanes, lanes + 4);
+
+            return std::max(result, scalar::maxAbs(data + i, count - i));
+        }
+
+        void multiplyAdd(float gain, const float *in, float *out, size_t count) {
+            const __m128 g = _mm_set1_ps(gain);
+            size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) {
+                __m128 acc = _mm_loadu_ps(out + i);
+                acc = _mm_add_ps(acc, _mm_mul_ps(g, _mm_loadu_ps(in + i)));
+                _mm_storeu_ps(out + i, acc);
+            }
+
+            scalar::multiplyAdd(gain, in + i, out + i, count - i);
+        }
+
+#else
+
+        const char *instructionSet() {
+            return "scalar";
+        }
+
+        double sumOfSquares(const float *data, size_t count) {
+            return scalar::sumOfSquares(data, count);
+        }
+
+        float maxAbs(const float *data, size_t count) {
+            return scalar::maxAbs(data, count);
+        }
+
+        void multiplyAdd(float gain, const float *in, float *out, size_t count) {
+            scalar::multiplyAdd(gain, in, out, count);
+        }
+
+#endif
+    }
+}
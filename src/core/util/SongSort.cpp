@@ -0,0 +1,113 @@
+/**
+ * @file SongSort.cpp
+ * @brief Implementação da ordenação de músicas por chaves
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-12-01
+ */
+
+#include "core/util/SongSort.hpp"
+
+#include "core/entities/Song.hpp"
+#include "core/util/Collation.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace core {
+
+    namespace {
+        // ordena pedaços em paralelo e junta os vizinhos dois a dois
+        template <typename Less>
+        void sortWith(std::vector<SongSortKey> &keys, Less less, unsigned workers) {
+            if (workers == 0)
+                workers = std::max(1u, std::thread::hardware_concurrency());
+
+            if (workers == 1 || keys.size() < SONG_SORT_PARALLEL_MIN_DEFAULT) {
+                std::sort(keys.begin(), keys.end(), less);
+                return;
+            }
+
+            std::vector<size_t> bounds;
+            for (unsigned i = 0; i <= workers; ++i)
+                bounds.push_back(keys.size() * i / workers);
+
+            std::vector<std::thread> threads;
+            for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+                threads.emplace_back([&keys, &less, begin = bounds[i], end = bounds[i + 1]]() {
+                    std::sort(keys.begin() + begin, keys.begin() + end, less);
+                });
+            }
+            for (auto &thread : threads)
+                thread.join();
+
+            while (bounds.size() > 2) {
+                std::vector<size_t> merged;
+                threads.clear();
+                for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+                    threads.emplace_back([&keys, &less, begin = bounds[i], middle = bounds[i + 1],
+                                          end = bounds[i + 2]]() {
+                        std::inplace_merge(keys.begin() + begin, keys.begin() + middle,
+                                           keys.begin() + end, less);
+                    });
+                    merged.push_back(bounds[i]);
+                }
+                // pedaço ímpar passa para a próxima rodada sem mudar
+                if (bounds.size() % 2 == 0)
+                    merged.push_back(bounds[bounds.size() - 2]);
+                merged.push_back(bounds.back());
+
+                for (auto &thread : threads)
+                    thread.join();
+                bounds.swap(merged);
+            }
+        }
+    }
+
+    SongSortKey SongSortKey::of(const Song &song, uint32_t index) {
+        SongSortKey key;
+        key.group = (static_cast<uint64_t>(song.getArtistId()) << 32) | song.getAlbumId();
+        key.track = song.getTrackNumber();
+        key.year = song.getYear();
+        key.index = index;
+        key.title = collationKey(song.getTitle());
+        return key;
+    }
+
+    std::vector<SongSortKey> makeSortKeys(const std::vector<std::shared_ptr<Song>> &songs) {
+        std::vector<SongSortKey> keys;
+        keys.reserve(songs.size());
+        for (size_t i = 0; i < songs.size(); ++i) {
+            if (songs[i])
+                keys.push_back(SongSortKey::of(*songs[i], static_cast<uint32_t>(i)));
+        }
+        return keys;
+    }
+
+    void sortKeys(std::vector<SongSortKey> &keys, SongOrder order, unsigned workers) {
+        switch (order) {
+        case SongOrder::TITLE:
+            sortWith(keys, SongTitleLess(), workers);
+            break;
+        case SongOrder::ARTIST_ALBUM_TRACK:
+            sortWith(keys, SongArtistAlbumTrackLess(), workers);
+            break;
+        case SongOrder::YEAR:
+            sortWith(keys, SongYearLess(), workers);
+            break;
+        }
+    }
+
+    void sortSongs(std::vector<std::shared_ptr<Song>> &songs, SongOrder order, unsigned workers) {
+        std::vector<SongSortKey> keys = makeSortKeys(songs);
+        sortKeys(keys, order, workers);
+
+        std::vector<std::shared_ptr<Song>> sorted;
+        sorted.reserve(songs.size());
+        for (const auto &key : keys)
+            sorted.push_back(std::move(songs[key.index]));
+        sorted.resize(songs.size());
+        songs.swap(sorted);
+    }
+}
@@ -0,0 +1,126 @@
+/**
+ * @file Waveform.cpp
+ * @brief Implementação do resumo de forma de onda
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-22
+ */
+
+#include "core/util/Waveform.hpp"
+#include "core/util/SimdKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace core {
+
+    namespace {
+        uint8_t quantize(double value) {
+            double clamped = std::min(1.0, std::max(0.0, value));
+            return static_cast<uint8_t>(clamped * 255.0 + 0.5);
+        }
+    }
+
+    size_t WaveformSummary::buckets() const {
+        return peaks.size();
+    }
+
+    bool WaveformSummary::empty() const {
+        return peaks.empty();
+    }
+
+    std::vector<float> WaveformSummary::resample(size_t columns) const {
+        std::vector<float> result(columns, 0.0f);
+        if (peaks.empty() || columns == 0)
+            return result;
+
+        for (size_t c = 0; c < columns; ++c) {
+            size_t begin = c * peaks.size() / columns;
+            size_t end = std::max(begin + 1, (c + 1) * peaks.size() / columns);
+            uint8_t peak = *std::max_element(peaks.begin() + begin,
+                                             peaks.begin() + std::min(end, peaks.size()));
+            result[c] = peak / 255.0f;
+        }
+
+        return result;
+    }
+
+    WaveformBuilder::WaveformBuilder(unsigned sample_rate, unsigned channels)
+        : _channels(channels),
+          _window_frames(std::max(1u, sample_rate / 100)),
+          _current_peak(0.0f),
+          _current_energy(0.0),
+          _current_frames(0) {
+        if (sample_rate == 0 || channels == 0)
+            throw std::invalid_argument("Formato de áudio inválido");
+    }
+
+    void WaveformBuilder::addFrames(const float *interleaved, size_t frames) {
+        while (frames > 0) {
+            size_t chunk = std::min(frames, _window_frames - _current_frames);
+            size_t samples = chunk * _channels;
+
+            // pico e energia sobre todos os canais da janela de uma vez
+            _current_peak = std::max(_current_peak, simd::maxAbs(interleaved, samples));
+            _current_energy += simd::sumOfSquares(interleaved, samples) / _channels;
+            _current_frames += chunk;
+
+            if (_current_frames == _window_frames)
+                closeWindow();
+
+            interleaved += samples;
+            frames -= chunk;
+        }
+    }
+
+    void WaveformBuilder::closeWindow() {
+        _window_peaks.push_back(_current_peak);
+        _window_energy.push_back(_current_energy);
+
+        _current_peak = 0.0f;
+        _current_energy = 0.0;
+        _current_frames = 0;
+    }
+
+    WaveformSummary WaveformBuilder::build(size_t buckets) const {
+        std::vector<float> windowPeaks = _window_peaks;
+        std::vector<double> windowEnergy = _window_energy;
+        std::vector<size_t> windowFrames(windowPeaks.size(), _window_frames);
+
+        if (_current_frames > 0) {
+            windowPeaks.push_back(_current_peak);
+            windowEnergy.push_back(_current_energy);
+            windowFrames.push_back(_current_frames);
+        }
+
+        WaveformSummary summary;
+        size_t windows = windowPeaks.size();
+        buckets = std::min(buckets, windows);
+        if (buckets == 0)
+            return summary;
+
+        summary.peaks.resize(buckets);
+        summary.rms.resize(buckets);
+
+        for (size_t b = 0; b < buckets; ++b) {
+            size_t begin = b * windows / buckets;
+            size_t end = (b + 1) * windows / buckets;
+
+            float peak = 0.0f;
+            double energy = 0.0;
+            size_t frames = 0;
+            for (size_t w = begin; w < end; ++w) {
+                peak = std::max(peak, windowPeaks[w]);
+                energy += windowEnergy[w];
+                frames += windowFrames[w];
+            }
+
+            summary.peaks[b] = quantize(peak);
+            summary.rms[b] = quantize(frames > 0 ? std::sqrt(energy / frames) : 0.0);
+        }
+
+        return summary;
+    }
+}
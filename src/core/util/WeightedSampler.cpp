@@ -0,0 +1,108 @@
+/**
+ * @file WeightedSampler.cpp
+ * @brief Implementação do sorteio ponderado
+ *
+ * @ingroup util
+ * @author Eloy Maciel
+ * @date 2025-11-25
+ */
+
+#include "core/util/WeightedSampler.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace core {
+
+    void WeightedSampler::addToTree(size_t slot, double delta) {
+        for (size_t i = slot + 1; i < _tree.size(); i += i & (~i + 1))
+            _tree[i] += delta;
+    }
+
+    void WeightedSampler::rebuild() {
+        // construção em O(n): cada nó repassa sua soma ao pai
+        _tree.assign(_weights.capacity() + 1, 0.0);
+        for (size_t i = 1; i < _tree.size(); ++i) {
+            if (i <= _weights.size())
+                _tree[i] += _weights[i - 1];
+            size_t parent = i + (i & (~i + 1));
+            if (parent < _tree.size())
+                _tree[parent] += _tree[i];
+        }
+    }
+
+    size_t WeightedSampler::size() const {
+        return _weights.size();
+    }
+
+    size_t WeightedSampler::add(double weight) {
+        size_t slot = _weights.size();
+        bool grown = _weights.size() == _weights.capacity();
+
+        _weights.push_back(std::max(0.0, weight));
+        if (grown || _tree.size() <= _weights.size())
+            rebuild();
+        else
+            addToTree(slot, _weights[slot]);
+
+        return slot;
+    }
+
+    void WeightedSampler::set(size_t slot, double weight) {
+        if (slot >= _weights.size())
+            throw std::out_of_range("Posição fora do sorteio");
+
+        weight = std::max(0.0, weight);
+        addToTree(slot, weight - _weights[slot]);
+        _weights[slot] = weight;
+    }
+
+    double WeightedSampler::weight(size_t slot) const {
+        if (slot >= _weights.size())
+            throw std::out_of_range("Posição fora do sorteio");
+        return _weights[slot];
+    }
+
+    double WeightedSampler::total() const {
+        double sum = 0.0;
+        for (size_t i = _weights.size(); i > 0; i -= i & (~i + 1))
+            sum += _tree[i];
+        return sum;
+    }
+
+    size_t WeightedSampler::sample(double unit) const {
+        double sum = total();
+        if (_weights.empty() || sum <= 0.0)
+            throw std::logic_error("Nenhum peso para sortear");
+
+        // desce pela árvore procurando a primeira soma parcial > alvo
+        double target = std::min(std::max(unit, 0.0), 1.0) * sum;
+        size_t position = 0;
+        size_t step = 1;
+        while (step * 2 < _tree.size())
+            step *= 2;
+
+        for (; step > 0; step /= 2) {
+            size_t next = position + step;
+            if (next < _tree.size() && next <= _weights.size() && _tree[next] <= target) {
+                position = next;
+                target -= _tree[next];
+            }
+        }
+
+        // arredondamentos podem parar em uma posição de peso zero
+        size_t slot = std::min(position, _weights.size() - 1);
+        while (slot > 0 && _weights[slot] <= 0.0)
+            --slot;
+        while (_weights[slot] <= 0.0) {
+            if (++slot == _weights.size())
+                throw std::logic_error("Nenhum peso para sortear");
+        }
+        return slot;
+    }
+
+    void WeightedSampler::clear() {
+        _weights.clear();
+        _tree.clear();
+    }
+}
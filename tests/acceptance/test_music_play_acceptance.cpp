@@ -1,8 +1,10 @@
 #include <doctest/doctest.h>
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "core/entities/Album.hpp"
@@ -284,4 +286,121 @@ TEST_SUITE("HISTÓRIA DE USUÁRIO: Reprodução de Música") {
             CHECK_EQ(player.isPlaying(), false);
         }
     }
+
+    TEST_CASE_FIXTURE(PlayerFixture, "CT-AC-04: Reproduzir sem dispositivo de áudio") {
+        core::PlaybackQueue queue;
+        queue += *album;
+
+        SUBCASE("Relógio virtual parado avança só manualmente") {
+            core::Player player(core::AudioBackend::NULL_DEVICE, 0.0);
+            player.addPlaybackQueue(queue);
+            CHECK(player.getBackend() == core::AudioBackend::NULL_DEVICE);
+
+            player.play();
+            CHECK_EQ(player.isPlaying(), true);
+
+            // aguarda a decodificação assíncrona do arquivo
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            CHECK_EQ(player.getElapsedTime(), 0);
+
+            player.advanceTime(short_song_mock.duracao * 1000 + 500);
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+            std::shared_ptr<const core::Song> cur_song =
+                player.getPlaybackQueue()->getCurrentSong();
+            CHECK(cur_song != nullptr);
+            CHECK_EQ(*cur_song, *medium_song);
+        }
+
+        SUBCASE("Relógio virtual acelerado") {
+            core::Player player(core::AudioBackend::NULL_DEVICE, 20.0);
+            player.addPlaybackQueue(queue);
+
+            player.play();
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+            std::shared_ptr<const core::Song> cur_song =
+                player.getPlaybackQueue()->getCurrentSong();
+            CHECK(cur_song != nullptr);
+            CHECK_EQ(*cur_song, *medium_song);
+
+            player.setTimeScale(0.0);
+            CHECK(player.getTimeScale() == doctest::Approx(0.0));
+            CHECK_THROWS_AS(player.setTimeScale(-1.0), std::invalid_argument);
+        }
+    }
+    TEST_CASE_FIXTURE(PlayerFixture, "CT-AC-05: Alternar entre filas nomeadas") {
+        core::Player player(core::AudioBackend::NULL_DEVICE, 0.0);
+        player.getPlaybackQueue()->add(*album);
+        CHECK(player.getCurrentQueueName() == QUEUE_NAME_DEFAULT);
+
+        auto party = player.createQueue("festa");
+        party->add(*medium_song);
+        CHECK_THROWS_AS(player.createQueue("festa"), std::invalid_argument);
+        CHECK(player.getQueueNames().size() == 2);
+
+        player.play();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        player.advanceTime(1000);
+        unsigned elapsed = player.getElapsedTime();
+
+        SUBCASE("Troca mantém a posição de cada fila") {
+            player.switchQueue("festa");
+            CHECK(player.getCurrentQueueName() == "festa");
+            CHECK_EQ(player.isPlaying(), true);
+            CHECK_EQ(*player.getPlaybackQueue()->getCurrentSong(), *medium_song);
+
+            player.pause();
+            player.switchQueue(QUEUE_NAME_DEFAULT);
+            CHECK_EQ(player.isPaused(), true);
+            CHECK_EQ(*player.getPlaybackQueue()->getCurrentSong(), *short_song);
+            CHECK_EQ(player.getElapsedTime(), elapsed);
+        }
+
+        SUBCASE("Fila ativa não pode ser removida") {
+            CHECK_THROWS_AS(player.dropQueue(QUEUE_NAME_DEFAULT), std::invalid_argument);
+            CHECK_THROWS_AS(player.switchQueue("inexistente"), std::invalid_argument);
+
+            player.switchQueue("festa");
+            CHECK_NOTHROW(player.dropQueue(QUEUE_NAME_DEFAULT));
+            CHECK(player.getQueueNames() == (std::vector<std::string>{"festa"}));
+        }
+
+        SUBCASE("Limpar afeta só a fila ativa") {
+            player.clearPlaylist();
+            CHECK(player.getPlaybackQueue()->empty());
+            CHECK(party->size() == 1);
+        }
+    }
+
+    TEST_CASE_FIXTURE(PlayerFixture, "CT-AC-06: Consultar o estado publicado do player") {
+        core::Player player(core::AudioBackend::NULL_DEVICE, 0.0);
+        player.getPlaybackQueue()->add(*album);
+        player.refreshStatus();
+
+        auto status = player.getStatus();
+        REQUIRE(status != nullptr);
+        CHECK(status->state == core::PlayerState::STOPPED);
+        CHECK(status->queue_size == 2);
+
+        player.play();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        status = player.getStatus();
+        CHECK(status->state == core::PlayerState::PLAYING);
+        CHECK(status->title == short_song->getTitle());
+        CHECK(status->next_title == medium_song->getTitle());
+
+        // a posição avança sem nova publicação
+        player.advanceTime(2000);
+        CHECK(player.getStatus()->sequence == status->sequence);
+        CHECK(status->elapsedAt(player.getEngineTime()) == player.getElapsedTime());
+
+        player.setVolume(0.5f);
+        CHECK(player.getStatus()->sequence > status->sequence);
+        CHECK(player.getStatus()->volume == doctest::Approx(0.5f));
+
+        player.pause();
+        CHECK(player.getStatus()->state == core::PlayerState::PAUSED);
+    }
 }
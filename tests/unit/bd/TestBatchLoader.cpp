@@ -0,0 +1,180 @@
+#include <doctest/doctest.h>
+
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/BatchLoader.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - core::BatchLoader") {
+    struct CountingFetch {
+        std::vector<std::vector<unsigned>> calls;
+
+        core::BatchLoader<unsigned, std::string>::Fetch fetch() {
+            return [this](const std::vector<unsigned> &keys) {
+                calls.push_back(keys);
+                std::unordered_map<unsigned, std::string> found;
+                for (unsigned key : keys)
+                    if (key % 10 != 0)  // múltiplos de 10 "não existem"
+                        found[key] = "v" + std::to_string(key);
+                return found;
+            };
+        }
+    };
+
+    TEST_CASE("BatchLoader: o primeiro acesso resolve todas as chaves pendentes") {
+        CountingFetch counter;
+        core::BatchLoader<unsigned, std::string> loader(counter.fetch());
+
+        loader.enqueue(1);
+        loader.enqueue(2);
+        loader.enqueue(2);
+        loader.enqueue(3);
+        CHECK(loader.pending() == 3);
+
+        CHECK(loader.load(2) == "v2");
+        REQUIRE(counter.calls.size() == 1);
+        CHECK(counter.calls[0].size() == 3);
+
+        CHECK(loader.load(1) == "v1");
+        CHECK(loader.load(3) == "v3");
+        CHECK(loader.batches() == 1);
+    }
+
+    TEST_CASE("BatchLoader: chaves ausentes não repetem a consulta") {
+        CountingFetch counter;
+        core::BatchLoader<unsigned, std::string> loader(counter.fetch());
+
+        CHECK(loader.load(10).empty());
+        CHECK(loader.load(10).empty());
+        CHECK(loader.batches() == 1);
+    }
+
+    TEST_CASE("BatchLoader: resolve só o lote da chave pedida e chaves novas recarregam") {
+        CountingFetch counter;
+        core::BatchLoader<unsigned, std::string> loader(counter.fetch(), 2);
+
+        for (unsigned key = 1; key <= 5; ++key)
+            loader.enqueue(key);
+        CHECK(loader.load(5) == "v5");
+        CHECK(loader.batches() == 1);
+        CHECK(loader.pending() == 4);
+
+        CHECK(loader.load(1) == "v1");
+        REQUIRE(counter.calls.size() == 2);
+        CHECK(counter.calls[1] == (std::vector<unsigned>{1, 2}));
+        CHECK(loader.load(2) == "v2");
+        CHECK(loader.batches() == 2);
+        CHECK(loader.pending() == 2);
+
+        // entidade mapeada de novo: o próximo acesso busca dados frescos
+        loader.enqueue(2);
+        CHECK(loader.load(2) == "v2");
+        CHECK(loader.batches() == 3);
+
+        using Loader = core::BatchLoader<unsigned, std::string>;
+        CHECK_THROWS_AS(Loader(counter.fetch(), 0), std::invalid_argument);
+    }
+
+    TEST_CASE("BatchLoader: pendentes têm limite e a busca roda fora da trava") {
+        CountingFetch counter;
+        core::BatchLoader<unsigned, std::string> capped(counter.fetch(), 500, 4096, 3);
+        for (unsigned key = 1; key <= 10; ++key)
+            capped.enqueue(key);
+        CHECK(capped.pending() == 3);
+        CHECK(capped.load(9) == "v9");
+        CHECK(counter.calls.back() == (std::vector<unsigned>{8, 9, 10}));
+
+        std::promise<void> entered, release;
+        auto released = release.get_future().share();
+        core::BatchLoader<unsigned, std::string> loader(
+            [&entered, released](const std::vector<unsigned> &keys) {
+                std::unordered_map<unsigned, std::string> found;
+                for (unsigned key : keys) {
+                    if (key == 1) {
+                        entered.set_value();
+                        released.wait();
+                    }
+                    found[key] = "v" + std::to_string(key);
+                }
+                return found;
+            });
+
+        auto slow = std::async(std::launch::async, [&loader]() { return loader.load(1); });
+        entered.get_future().wait();
+        CHECK(loader.load(2) == "v2");
+        release.set_value();
+        CHECK(slow.get() == "v1");
+        CHECK(loader.batches() == 2);
+    }
+
+    TEST_CASE("BatchLoader: relações das entidades carregadas em lote") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        db->exec("INSERT INTO artists (id, name, user_id) VALUES (1, 'Primeiro', 1), (2, 'Segundo', 1);");
+        db->exec("INSERT INTO albums (id, title, user_id) VALUES (1, 'Disco', 1);");
+        for (int i = 1; i <= 6; ++i) {
+            db->exec("INSERT INTO songs (id, title, duration, artist_id, album_id, user_id) VALUES ("
+                     + std::to_string(i) + ", 'Faixa " + std::to_string(i) + "', 60, "
+                     + std::to_string(1 + i % 2) + ", " + (i <= 3 ? "1" : "NULL") + ", 1);");
+        }
+        db->exec("INSERT INTO playlists (id, title, user_id) VALUES (1, 'Lista', 1);");
+        db->exec("INSERT INTO playlist_songs (playlist_id, song_id, position)"
+                 " VALUES (1, 5, 0), (1, 2, 1);");
+
+        core::User user("ouvinte");
+        user.setId(1);
+
+        core::SongRepository songs(db);
+        auto all = songs.findByUser(user);
+        REQUIRE(all.size() == 6);
+
+        for (const auto &song : all) {
+            auto artist = song->getArtist();
+            REQUIRE(artist != nullptr);
+            CHECK(artist->getId() == song->getArtistId());
+            CHECK(artist->getName() == (song->getArtistId() == 1 ? "Primeiro" : "Segundo"));
+        }
+        // mesma chave, mesmo objeto
+        CHECK(all[0]->getArtist() == all[2]->getArtist());
+
+        for (const auto &song : all) {
+            if (song->getAlbumId() == 0) {
+                CHECK(song->getAlbum() == nullptr);
+            } else {
+                REQUIRE(song->getAlbum() != nullptr);
+                CHECK(song->getAlbum()->getTitle() == "Disco");
+            }
+        }
+
+        core::AlbumRepository albums(db);
+        auto album = albums.findById(1);
+        REQUIRE(album != nullptr);
+        CHECK(album->getSongs().size() == 3);
+
+        core::PlaylistRepository playlists(db);
+        auto playlist = playlists.findById(1);
+        REQUIRE(playlist != nullptr);
+        auto listed = playlist->getSongs();
+        REQUIRE(listed.size() == 2);
+        CHECK(listed[0]->getId() == 5);
+        CHECK(listed[1]->getId() == 2);
+    }
+}
@@ -0,0 +1,83 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "core/bd/AlbumRepository.hpp"
+#include "core/bd/ArtistRepository.hpp"
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/util/Collation.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - core::Collation") {
+    TEST_CASE("Collation: chave sem caixa e sem acentos") {
+        CHECK(core::collationKey("Ação") == "acao");
+        CHECK(core::collationKey("CORAÇÃO") == core::collationKey("coração"));
+        CHECK(core::collationKey("Straße") == "strasse");
+        CHECK(core::collationKey("Œuvre Ølstad") == "oeuvre olstad");
+        // texto decomposto: "e" + acento agudo combinante
+        CHECK(core::collationKey("Cafe\xCC\x81") == "cafe");
+        // fora dos blocos latinos: mantém os bytes
+        CHECK(core::collationKey("日本") == "日本");
+
+        CHECK(core::collationKey("Água") < core::collationKey("Zeca"));
+        CHECK(core::collationPrefixEnd("ab") == "ac");
+        CHECK(core::collationPrefixEnd("a\xFF") == "b");
+        CHECK(core::collationPrefixEnd("").empty());
+    }
+
+    TEST_CASE("Collation: chaves gravadas, busca por prefixo e ORDER BY") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+
+        auto user = std::make_shared<core::User>("ouvinte");
+        user->setId(1);
+
+        core::ArtistRepository artists(db);
+        core::Artist artist("Élis", "MPB");
+        artist.setUser(*user);
+        REQUIRE(artists.save(artist));
+
+        core::SongRepository songs(db);
+        std::vector<std::string> titles = {"Zeca", "Água de Beber", "abacate", "Canção", "CASA"};
+        for (const auto &title : titles) {
+            core::Song song(0, title, artist.getId(), 0);
+            song.setUser(*user);
+            song.setDuration(60);
+            REQUIRE(songs.save(song));
+        }
+
+        std::vector<std::string> ordered;
+        for (const auto &song : songs.findByUser(*user))
+            ordered.push_back(song->getTitle());
+        CHECK(ordered == (std::vector<std::string>{"abacate", "Água de Beber", "Canção", "CASA", "Zeca"}));
+
+        auto prefixed = songs.findByTitlePrefix("ca", *user);
+        REQUIRE(prefixed.size() == 2);
+        CHECK(prefixed[0]->getTitle() == "Canção");
+        CHECK(songs.findByTitleAndUser("cancao", *user).size() == 1);
+        CHECK(artists.findByNamePrefix("eli", *user).size() == 1);
+
+        // a collation registrada segue a mesma regra
+        SQLite::Statement query(*db, "SELECT title FROM songs ORDER BY title COLLATE FOLD;");
+        std::vector<std::string> collated;
+        while (query.executeStep())
+            collated.push_back(query.getColumn(0).getString());
+        CHECK(collated == ordered);
+
+        // e a função usada para preencher linhas sem chave
+        SQLite::Statement key(*db, "SELECT fold('Óculos'), fold(NULL) IS NULL;");
+        REQUIRE(key.executeStep());
+        CHECK(key.getColumn(0).getString() == "oculos");
+        CHECK(key.getColumn(1).getInt() == 1);
+    }
+}
@@ -0,0 +1,92 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/EntityCache.hpp"
+#include "core/bd/SongRepository.hpp"
+#include "core/entities/Album.hpp"
+#include "core/entities/Artist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - core::EntityCache") {
+    TEST_CASE("EntityCache: carrega uma vez e segura a entidade") {
+        core::EntityCache<core::Artist> cache;
+        int loads = 0;
+        auto load = [&loads](unsigned id) {
+            ++loads;
+            auto artist = std::make_shared<core::Artist>("Artista", "");
+            artist->setId(id);
+            return artist;
+        };
+
+        auto first = cache.get(3, load);
+        std::weak_ptr<core::Artist> weak = first;
+        first.reset();
+
+        // ninguém mais segura o artista, mas o cache sim
+        CHECK_FALSE(weak.expired());
+        CHECK(cache.get(3, load) == weak.lock());
+        CHECK(loads == 1);
+
+        // ausentes não são guardadas
+        CHECK(cache.get(4, [](unsigned) { return std::shared_ptr<core::Artist>(); }) == nullptr);
+        CHECK_FALSE(cache.contains(4));
+
+        cache.erase(3);
+        CHECK(weak.expired());
+        CHECK(cache.size() == 0);
+    }
+
+    TEST_CASE("EntityCache: relações das músicas vivem durante a sessão") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        db->exec("INSERT INTO artists (id, name, user_id) VALUES (1, 'Primeiro', 1);");
+        db->exec("INSERT INTO albums (id, title, user_id) VALUES (1, 'Disco', 1);");
+        db->exec("INSERT INTO songs (id, title, duration, track_number, artist_id, album_id, user_id)"
+                 " VALUES (1, 'B', 60, 2, 1, 1, 1), (2, 'A', 60, 1, 1, 1, 1);");
+
+        core::User user("ouvinte");
+        user.setId(1);
+
+        auto songs = std::make_shared<core::SongRepository>(db);
+        auto first = songs->findByUser(user);
+        REQUIRE(first.size() == 2);
+
+        auto artist = first[0]->getArtist();
+        REQUIRE(artist != nullptr);
+        std::weak_ptr<const core::Artist> weak = artist;
+        artist.reset();
+
+        // sem outro dono, a relação continua no cache da música
+        CHECK_FALSE(weak.expired());
+        CHECK(first[1]->getArtist() == weak.lock());
+
+        // uma nova consulta reaproveita as mesmas entidades
+        auto again = songs->findByUser(user);
+        CHECK(again[0]->getArtist() == weak.lock());
+        CHECK(again[0]->getAlbum() == first[0]->getAlbum());
+
+        // mesmo artista e álbum: ordena pelo número da faixa
+        auto &track_one = first[0]->getTrackNumber() == 1 ? first[0] : first[1];
+        auto &track_two = first[0]->getTrackNumber() == 1 ? first[1] : first[0];
+        CHECK(*track_one < *track_two);
+        CHECK_FALSE(*track_two < *track_one);
+
+        songs->clearRelationCache();
+        CHECK(weak.expired());
+
+        // o repositório pode acabar antes das músicas
+        songs.reset();
+        REQUIRE(first[0]->getArtist() != nullptr);
+        CHECK(first[0]->getArtist()->getName() == "Primeiro");
+    }
+}
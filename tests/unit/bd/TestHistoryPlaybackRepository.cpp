@@ -0,0 +1,214 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/bd/IdentityMap.hpp"
+#include "core/entities/User.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - core::HistoryPlaybackRepository") {
+    struct HistoryFixture {
+        std::unique_ptr<core::DatabaseManager> database;
+        std::shared_ptr<core::HistoryPlaybackRepository> repo;
+        core::User user;
+
+        HistoryFixture() : user("ouvinte") {
+            ConfigFixture config;
+            database.reset(new core::DatabaseManager(config.databasePath(),
+                                                     config.databaseSchemaPath()));
+            auto db = database->getDatabase();
+            db->exec("PRAGMA foreign_keys = OFF;");
+            db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                     " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+            db->exec("INSERT INTO artists (id, name, user_id) VALUES (1, 'Artista', 1);");
+            db->exec("INSERT INTO songs (id, title, duration, artist_id, user_id)"
+                     " VALUES (1, 'Primeira', 120, 1, 1), (2, 'Segunda', 90, NULL, 1);");
+            repo = std::make_shared<core::HistoryPlaybackRepository>(db);
+            user.setId(1);
+
+            // 10 reproduções alternando as músicas; as duas últimas no mesmo instante
+            std::vector<core::PlaybackEvent> events;
+            for (unsigned i = 0; i < 10; ++i) {
+                core::PlaybackEvent event;
+                event.user_id = 1;
+                event.song_id = 1 + i % 2;
+                event.played_at = 1000 + std::min(i, 8u) * 10;
+                events.push_back(event);
+            }
+            repo->insertPlaybackEvents(events);
+        }
+    };
+
+    TEST_CASE_FIXTURE(HistoryFixture, "HistoryPlaybackRepository: histórico recente paginado") {
+        auto first = repo->findRecentlyPlayed(user, 4);
+        REQUIRE(first.size() == 4);
+        CHECK(first[0].played_at == 1080);
+        CHECK(first[1].played_at == 1080);
+        CHECK(first[0].history_id > first[1].history_id);
+        CHECK(first[3].played_at == 1060);
+
+        std::vector<unsigned> seen;
+        std::vector<core::RecentPlay> page = first;
+        while (!page.empty()) {
+            for (const auto &entry : page)
+                seen.push_back(entry.history_id);
+            const auto &last = page.back();
+            page = repo->findRecentlyPlayed(user, 4, 0, last.played_at, last.history_id);
+        }
+        CHECK(seen.size() == 10);
+
+        SUBCASE("Projeção traz música e artista") {
+            auto withArtist = first[1].song_id == 1 ? first[1] : first[0];
+            auto withoutArtist = first[1].song_id == 2 ? first[1] : first[0];
+            CHECK(withArtist.title == "Primeira");
+            CHECK(withArtist.artist_id == 1);
+            CHECK(withArtist.artist == "Artista");
+            CHECK(withoutArtist.title == "Segunda");
+            CHECK(withoutArtist.artist_id == 0);
+            CHECK(withoutArtist.artist.empty());
+        }
+
+        SUBCASE("Intervalo de tempo") {
+            auto range = repo->findRecentlyPlayed(user, 100, 1020, 1050);
+            REQUIRE(range.size() == 3);
+            CHECK(range.front().played_at == 1040);
+            CHECK(range.back().played_at == 1020);
+        }
+    }
+
+    TEST_CASE_FIXTURE(HistoryFixture, "HistoryPlaybackRepository: entidades compartilham usuário e música") {
+        auto history = repo->findByUser(user);
+        REQUIRE(history.size() == 10);
+        CHECK(history[0]->getUser() == history[9]->getUser());
+
+        auto first = history[0]->getSong();
+        size_t same = 0;
+        for (const auto &entry : history)
+            same += entry->getSong() == first;
+        CHECK(same == 5);
+
+        CHECK(repo->findByUser(user, 3).size() == 3);
+    }
+
+    TEST_CASE_FIXTURE(HistoryFixture, "HistoryPlaybackRepository: agregados acompanham os lotes") {
+        auto db = database->getDatabase();
+        db->exec("INSERT OR IGNORE INTO artists (id, name, user_id) VALUES (901, 'Artista Agregado', 1);");
+        db->exec("INSERT OR IGNORE INTO songs (id, title, duration, artist_id, user_id)"
+                 " VALUES (901, 'Faixa Agregada', 180, 901, 1);");
+        core::Song aggregated(901, "Faixa Agregada", 1);
+
+        const std::time_t day = 86400;
+        const std::time_t base = 20000 * day;
+        unsigned before = repo->countPlaybacksBySongAndUser(aggregated, user);
+        auto daysBefore = repo->findDailyListening(user, base, base + day);
+
+        std::vector<core::PlaybackEvent> events;
+        for (unsigned i = 0; i < 3; ++i) {
+            core::PlaybackEvent event;
+            event.user_id = user.getId();
+            event.song_id = 901;
+            event.played_at = base + i * (day / 2);  // dois no primeiro dia, um no segundo
+            event.duration = 100;
+            events.push_back(event);
+        }
+        REQUIRE(repo->insertPlaybackEvents(events));
+
+        CHECK(repo->countPlaybacksBySongAndUser(aggregated, user) == before + 3);
+
+        auto days = repo->findDailyListening(user, base, base + day);
+        REQUIRE(days.size() == 2);
+        CHECK(days[0].day == base);
+        CHECK(days[0].plays == (daysBefore.empty() ? 0 : daysBefore[0].plays) + 2);
+        CHECK(days[1].listened_seconds >= 100);
+
+        auto songs = repo->findTopSongs(user, 100);
+        auto song = std::find_if(songs.begin(), songs.end(),
+                                 [](const core::PlayRanking &entry) { return entry.id == 901; });
+        REQUIRE(song != songs.end());
+        CHECK(song->name == "Faixa Agregada");
+        CHECK(song->plays == before + 3);
+
+        auto artists = repo->findTopArtists(user, 100);
+        CHECK(std::any_of(artists.begin(), artists.end(), [](const core::PlayRanking &entry) {
+            return entry.id == 901 && entry.name == "Artista Agregado";
+        }));
+
+        // a entidade devolve o tempo ouvido gravado no evento
+        auto history = repo->findByUser(user);
+        CHECK(std::all_of(history.begin(), history.end(), [](const auto &entry) {
+            return entry->getSong()->getId() != 901 || entry->getPlayDuration() == 100;
+        }));
+    }
+
+    TEST_CASE_FIXTURE(HistoryFixture, "HistoryPlaybackRepository: atualizar move os agregados") {
+        auto history = repo->findByUser(user);
+        auto moved = std::find_if(history.begin(), history.end(), [](const auto &entry) {
+            return entry->getSong()->getId() == 1 && entry->getPlayedAt() == 1080;
+        });
+        auto other = std::find_if(history.begin(), history.end(), [](const auto &entry) {
+            return entry->getSong()->getId() == 2;
+        });
+        REQUIRE(moved != history.end());
+        REQUIRE(other != history.end());
+
+        core::HistoryPlayback playback = **moved;
+        playback.setSong(*(*other)->getSong());
+        playback.setPlayDuration(50);
+        REQUIRE(repo->save(playback));
+
+        auto stats = repo->findPlayStatsByUser(user);
+        CHECK(stats[1].plays == 4);
+        CHECK(stats[1].last_played_at == 1060);
+        CHECK(stats[2].plays == 6);
+        CHECK(stats[2].last_played_at == 1080);
+
+        auto artists = repo->findTopArtists(user, 100);
+        auto artist = std::find_if(artists.begin(), artists.end(),
+                                   [](const core::PlayRanking &entry) { return entry.id == 1; });
+        REQUIRE(artist != artists.end());
+        CHECK(artist->plays == 4);
+
+        auto days = repo->findDailyListening(user, 0, 0);
+        REQUIRE(days.size() == 1);
+        CHECK(days[0].plays == 10);
+        CHECK(days[0].listened_seconds == 50);
+
+        core::HistoryPlayback missing = playback;
+        missing.setId(9999);
+        CHECK_FALSE(repo->save(missing));
+        CHECK(repo->findPlayStatsByUser(user)[2].plays == 6);
+    }
+
+    TEST_CASE("IdentityMap: reaproveita entidades vivas") {
+        core::IdentityMap<core::User> map;
+        unsigned loads = 0;
+        auto load = [&loads](unsigned id) {
+            ++loads;
+            auto user = std::make_shared<core::User>("u" + std::to_string(id));
+            user->setId(id);
+            return user;
+        };
+
+        auto a = map.get(1, load);
+        auto b = map.get(1, load);
+        CHECK(a == b);
+        CHECK(loads == 1);
+
+        a.reset();
+        b.reset();
+        CHECK(map.find(1) == nullptr);
+        map.get(1, load);
+        CHECK(loads == 2);
+
+        CHECK(map.get(2, [](unsigned) { return std::shared_ptr<core::User>(); }) == nullptr);
+        map.clear();
+        CHECK(map.size() == 0);
+    }
+}
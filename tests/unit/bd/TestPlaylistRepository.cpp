@@ -0,0 +1,219 @@
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/PlaylistRepository.hpp"
+#include "core/entities/Playlist.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/PlaylistRebalanceJob.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+namespace {
+    int64_t totalChanges(SQLite::Database &db) {
+        SQLite::Statement query(db, "SELECT total_changes();");
+        query.executeStep();
+        return query.getColumn(0).getInt64();
+    }
+
+    std::vector<unsigned> storedOrder(SQLite::Database &db, unsigned playlist_id) {
+        SQLite::Statement query(db, "SELECT song_id FROM playlist_songs"
+                                    " WHERE playlist_id = ? ORDER BY position;");
+        query.bind(1, playlist_id);
+        std::vector<unsigned> ids;
+        while (query.executeStep())
+            ids.push_back(query.getColumn(0).getUInt());
+        return ids;
+    }
+
+    std::vector<unsigned> memoryOrder(const core::Playlist &playlist) {
+        std::vector<unsigned> ids;
+        for (const auto &song : playlist.getSongs())
+            ids.push_back(song->getId());
+        return ids;
+    }
+}
+
+TEST_SUITE("Unit Tests - core::PlaylistRepository") {
+    TEST_CASE("PlaylistRepository: update grava só as músicas alteradas") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        for (int i = 1; i <= 60; ++i) {
+            db->exec("INSERT INTO songs (id, title, duration, artist_id, user_id) VALUES ("
+                     + std::to_string(i) + ", 'Faixa " + std::to_string(i) + "', 60, 1, 1);");
+        }
+
+        core::User user("ouvinte");
+        user.setId(1);
+
+        core::Playlist created(0, "Lista", user);
+        for (unsigned id = 1; id <= 50; ++id)
+            created.addSong(core::Song(id, "Faixa " + std::to_string(id), 1));
+
+        core::PlaylistRepository playlists(db);
+        REQUIRE(playlists.save(created));
+        CHECK_FALSE(created.hasChanges());
+        CHECK(storedOrder(*db, created.getId()) == memoryOrder(created));
+
+        auto playlist = playlists.findById(created.getId());
+        REQUIRE(playlist != nullptr);
+        REQUIRE(playlist->getSongsCount() == 50);
+
+        playlist->moveSong(40, 0);
+        playlist->removeSong(10);
+        playlist->insert(core::Song(55, "Faixa 55", 1), 5);
+        playlist->removeSong(55);  // nunca chegou ao banco: nada a gravar
+        playlist->pushFront(core::Song(56, "Faixa 56", 1));
+        CHECK(playlist->getChanges().inserted.size() == 1);
+
+        int64_t before = totalChanges(*db);
+        REQUIRE(playlists.save(*playlist));
+        // título + remoção + movida + inserida, mais os totais da playlist
+        // que os triggers ajustam na remoção e na inserção
+        CHECK(totalChanges(*db) - before == 6);
+        CHECK(storedOrder(*db, playlist->getId()) == memoryOrder(*playlist));
+
+        // sempre no mesmo ponto: as chaves crescem, mas só a linha movida é gravada
+        for (unsigned id = 57; id <= 60; ++id) {
+            for (int i = 0; i < 4; ++i)
+                playlist->moveSong(static_cast<unsigned>(playlist->getSongsCount() - 1), 1);
+            playlist->insert(core::Song(id, "Faixa " + std::to_string(id), 1), 1);
+            REQUIRE(playlists.save(*playlist));
+        }
+        for (int i = 0; i < 40; ++i) {
+            playlist->moveSong(static_cast<unsigned>(playlist->getSongsCount() - 1), 1);
+            before = totalChanges(*db);
+            REQUIRE(playlists.save(*playlist));
+            REQUIRE(totalChanges(*db) - before == 2);
+        }
+        CHECK(storedOrder(*db, playlist->getId()) == memoryOrder(*playlist));
+
+        // a redistribuição encurta as chaves e mantém a ordem
+        REQUIRE(playlists.findUnbalanced() == std::vector<unsigned>{playlist->getId()});
+        core::PlaylistRebalanceJob job(std::make_shared<core::PlaylistRepository>(db));
+        auto report = job.run();
+        CHECK(report.playlists == 1);
+        CHECK(report.rows == playlist->getSongsCount());
+        CHECK(playlists.findUnbalanced().empty());
+        CHECK(storedOrder(*db, playlist->getId()) == memoryOrder(*playlist));
+
+        auto reloaded = core::PlaylistRepository(db).findById(playlist->getId());
+        REQUIRE(reloaded != nullptr);
+        CHECK(memoryOrder(*reloaded) == memoryOrder(*playlist));
+    }
+
+    TEST_CASE("PlaylistRepository: posições inteiras antigas viram chaves") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        for (int i = 1; i <= 3; ++i) {
+            db->exec("INSERT INTO songs (id, title, duration, artist_id, user_id) VALUES ("
+                     + std::to_string(i) + ", 'Faixa " + std::to_string(i) + "', 60, 1, 1);");
+        }
+        db->exec("INSERT INTO playlists (id, title, user_id) VALUES (1, 'Lista', 1);");
+        db->exec("INSERT INTO playlist_songs (playlist_id, song_id, position)"
+                 " VALUES (1, 3, 0), (1, 1, 1), (1, 2, 2);");
+
+        core::PlaylistRepository playlists(db);
+        auto playlist = playlists.findById(1);
+        REQUIRE(playlist != nullptr);
+        playlist->moveSong(2, 0);
+        REQUIRE(playlists.save(*playlist));
+
+        // as linhas sem chave válida são regravadas junto com a movida
+        CHECK(storedOrder(*db, 1) == (std::vector<unsigned>{2, 3, 1}));
+        SQLite::Statement types(*db, "SELECT COUNT(1) FROM playlist_songs"
+                                     " WHERE typeof(position) <> 'text';");
+        REQUIRE(types.executeStep());
+        CHECK(types.getColumn(0).getInt() == 0);
+    }
+
+    TEST_CASE("PlaylistRepository: getSongs traz a playlist em ordem e com as relações") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        db->exec("INSERT INTO artists (id, name, user_id) VALUES (1, 'Primeiro', 1), (2, 'Segundo', 1);");
+        db->exec("INSERT INTO albums (id, title, user_id) VALUES (1, 'Disco', 1);");
+        db->exec("INSERT INTO songs (id, title, duration, artist_id, album_id, user_id) VALUES"
+                 " (1, 'Faixa 1', 60, 1, 1, 1), (2, 'Faixa 2', 60, 2, NULL, 1),"
+                 " (3, 'Faixa 3', 60, 1, 1, 1);");
+        db->exec("INSERT INTO playlists (id, title, user_id) VALUES (1, 'Lista', 1);");
+        db->exec("INSERT INTO playlist_songs (playlist_id, song_id, position)"
+                 " VALUES (1, 3, 'n'), (1, 1, 't'), (1, 2, 'g');");
+
+        core::User user("ouvinte");
+        user.setId(1);
+        core::Playlist playlist(1, "Lista", user);
+
+        auto songs = core::PlaylistRepository(db).getSongs(playlist);
+
+        // as relações já vieram no JOIN: nada mais é lido do banco
+        db->exec("DELETE FROM artists; DELETE FROM albums;");
+
+        REQUIRE(songs.size() == 3);
+        CHECK(songs[0]->getId() == 2);
+        CHECK(songs[1]->getId() == 3);
+        CHECK(songs[2]->getId() == 1);
+        CHECK(songs[0]->getArtist()->getName() == "Segundo");
+        CHECK(songs[0]->getAlbum() == nullptr);
+        CHECK(songs[1]->getAlbum()->getTitle() == "Disco");
+        CHECK(songs[1]->getAlbum()->getDataCriacao().isSet());
+        CHECK(songs[0]->getDataCriacao().isSet());
+        CHECK(songs[1]->getArtist() == songs[2]->getArtist());
+        CHECK(songs[2]->getUser()->getId() == 1);
+    }
+
+    TEST_CASE("PlaylistRepository: contagem e duração vêm das colunas mantidas por triggers") {
+        ConfigFixture config;
+        core::DatabaseManager database(config.databasePath(), config.databaseSchemaPath());
+        auto db = database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                 " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+        db->exec("INSERT INTO artists (id, name, user_id) VALUES (1, 'Primeiro', 1);");
+        db->exec("INSERT INTO albums (id, title, user_id) VALUES (1, 'Disco', 1);");
+        db->exec("INSERT INTO songs (id, title, duration, artist_id, album_id, user_id) VALUES"
+                 " (1, 'Faixa 1', 60, 1, 1, 1), (2, 'Faixa 2', 90, 1, 1, 1),"
+                 " (3, 'Faixa 3', 30, 1, NULL, 1);");
+        db->exec("INSERT INTO playlists (id, title, user_id) VALUES (1, 'Lista', 1);");
+        db->exec("INSERT INTO playlist_songs (playlist_id, song_id, position)"
+                 " VALUES (1, 1, 'g'), (1, 2, 'n'), (1, 3, 't');");
+        db->exec("UPDATE songs SET duration = 120 WHERE id = 3;");
+        db->exec("PRAGMA foreign_keys = ON;");
+        db->exec("DELETE FROM songs WHERE id = 1;");
+
+        SQLite::Statement album(*db, "SELECT song_count, total_duration FROM albums WHERE id = 1;");
+        REQUIRE(album.executeStep());
+        CHECK(album.getColumn(0).getInt() == 1);
+        CHECK(album.getColumn(1).getInt() == 90);
+        SQLite::Statement artist(*db, "SELECT song_count, total_duration FROM artists WHERE id = 1;");
+        REQUIRE(artist.executeStep());
+        CHECK(artist.getColumn(0).getInt() == 2);
+        CHECK(artist.getColumn(1).getInt() == 210);
+
+        core::PlaylistRepository playlists(db);
+        auto playlist = playlists.findById(1);
+        REQUIRE(playlist != nullptr);
+        CHECK(playlist->getDataCriacao().isSet());
+
+        // sem as linhas de playlist_songs, só as colunas respondem
+        db->exec("PRAGMA foreign_keys = OFF;");
+        db->exec("DELETE FROM playlist_songs;");
+        CHECK(playlist->getSongsCount() == 2);
+        CHECK(playlist->calculateTotalDuration() == 210);
+    }
+}
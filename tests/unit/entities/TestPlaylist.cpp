@@ -13,6 +13,7 @@
 #include "core/entities/User.hpp"
 
 #include <memory>
+#include <random>
 #include <string>
 
 TEST_SUITE("Unit Tests - Entity: Playlist") {
@@ -212,4 +213,65 @@ TEST_SUITE("Unit Tests - Entity: Playlist") {
             CHECK_EQ(p.calculateTotalDuration(), expectedDuration);
         }
     }
+
+    TEST_CASE("Playlist: busca por id acompanha inserções, remoções e movimentos") {
+        std::vector<std::shared_ptr<core::Song>> initial;
+        for (unsigned id = 1; id <= 20; ++id)
+            initial.push_back(std::make_shared<core::Song>(id, "Song " + std::to_string(id), 1));
+
+        core::Playlist p(1, "Lista");
+        p.setSongsLoader([initial]() { return initial; });
+        std::vector<unsigned> model;
+        for (unsigned id = 1; id <= 20; ++id)
+            model.push_back(id);
+
+        std::mt19937 rng(11);
+        unsigned next = 21;
+        for (int step = 0; step < 500; ++step) {
+            switch (rng() % 4) {
+            case 0: {
+                size_t pos = rng() % (model.size() + 1);
+                REQUIRE(p.insert(core::Song(next, "Song", 1), pos));
+                model.insert(model.begin() + static_cast<std::ptrdiff_t>(pos), next++);
+                break;
+            }
+            case 1:
+                if (!model.empty()) {
+                    size_t pos = rng() % model.size();
+                    REQUIRE(p.removeSong(model[pos]));
+                    model.erase(model.begin() + static_cast<std::ptrdiff_t>(pos));
+                }
+                break;
+            case 2:
+                if (!model.empty()) {
+                    unsigned from = static_cast<unsigned>(rng() % model.size());
+                    unsigned to = static_cast<unsigned>(rng() % model.size());
+                    unsigned id = model[from];
+                    p.switchSong(id, to);
+                    model.erase(model.begin() + from);
+                    model.insert(model.begin() + to, id);
+                }
+                break;
+            default:
+                p.pushBack(core::Song(next, "Song", 1));
+                model.push_back(next++);
+                break;
+            }
+
+            REQUIRE(p.getSongsCount() == model.size());
+            if (!model.empty()) {
+                unsigned id = model[rng() % model.size()];
+                REQUIRE(p.findSongById(id) != nullptr);
+                CHECK(p.findSongById(id)->getId() == id);
+            }
+        }
+
+        std::vector<unsigned> ids;
+        for (const auto &song : p.getSongs())
+            ids.push_back(song->getId());
+        CHECK(ids == model);
+        CHECK_FALSE(p.containsSong(next));
+        CHECK_FALSE(p.removeSong(next));
+        CHECK(p.findSongById(next) == nullptr);
+    }
 }
@@ -109,6 +109,24 @@ TEST_SUITE("Unit Tests - Entity: Song") {
         CHECK(s.getUser()->getUsername() == this->user.getUsername());
     }
 
+    TEST_CASE_FIXTURE(FixtureSong, "Song: ReplayGain") {
+        core::Song s;
+        CHECK_FALSE(s.hasReplayGain());
+        CHECK(s.getGainFactor() == doctest::Approx(1.0f));
+
+        SUBCASE("Ganho negativo vira fator linear") {
+            s.setReplayGain(-6.0f, 0.5f);
+            CHECK(s.hasReplayGain());
+            CHECK(s.getReplayGain() == doctest::Approx(-6.0f));
+            CHECK(s.getGainFactor() == doctest::Approx(0.501187f));
+        }
+
+        SUBCASE("Ganho positivo limitado pelo pico") {
+            s.setReplayGain(6.0f, 0.9f);
+            CHECK(s.getGainFactor() == doctest::Approx(1.0f / 0.9f));
+        }
+    }
+
     TEST_CASE_FIXTURE(FixtureSong, "Song: featuring artists básico") {
         core::Song s;
         s.setAlbumLoader([this]() { return this->getAlbum(); });
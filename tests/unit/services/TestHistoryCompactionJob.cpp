@@ -0,0 +1,122 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/HistoryCompactionJob.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - Services: HistoryCompactionJob") {
+    struct CompactionFixture {
+        std::unique_ptr<core::DatabaseManager> database;
+        std::shared_ptr<core::HistoryPlaybackRepository> repo;
+        core::User user;
+        const std::time_t day = 24 * 60 * 60;
+        const std::time_t now = 20000 * day;
+
+        CompactionFixture() : user("ouvinte") {
+            ConfigFixture config;
+            database.reset(new core::DatabaseManager(config.databasePath(),
+                                                     config.databaseSchemaPath()));
+            auto db = database->getDatabase();
+            db->exec("PRAGMA foreign_keys = OFF;");
+            db->exec("INSERT INTO users (id, username, uid, home_path, input_path)"
+                     " VALUES (1, 'ouvinte', '1000', '/tmp', '/tmp');");
+            repo = std::make_shared<core::HistoryPlaybackRepository>(db);
+            user.setId(1);
+
+            // uma reprodução por dia nos últimos 400 dias
+            std::vector<core::PlaybackEvent> events;
+            for (std::time_t i = 0; i < 400; ++i) {
+                core::PlaybackEvent event;
+                event.user_id = 1;
+                event.song_id = 7;
+                event.played_at = now - i * day - day / 2;
+                event.duration = 60;
+                events.push_back(event);
+            }
+            repo->insertPlaybackEvents(events);
+        }
+
+        size_t rawRows() const {
+            SQLite::Statement query(*database->getDatabase(),
+                                    "SELECT COUNT(1) FROM playback_history;");
+            query.executeStep();
+            return static_cast<size_t>(query.getColumn(0).getInt64());
+        }
+    };
+
+    TEST_CASE_FIXTURE(CompactionFixture, "HistoryCompactionJob: remove só o que sai da janela") {
+        core::HistoryCompactionJob job(database->getDatabase(), 100);
+
+        auto report = job.run(now);
+        CHECK(report.removed == 300);
+        CHECK(rawRows() == 100);
+
+        // os agregados continuam contando tudo
+        core::Song song(7, "Faixa", 1);
+        CHECK(repo->countPlaybacksBySongAndUser(song, user) == 400);
+        CHECK(repo->findDailyListening(user, now - 400 * day, now).size() == 400);
+
+        CHECK(job.run(now).removed == 0);
+    }
+
+    TEST_CASE_FIXTURE(CompactionFixture, "HistoryCompactionJob: limites da janela") {
+        SUBCASE("Zero mantém o histórico inteiro") {
+            core::HistoryCompactionJob job(database->getDatabase(), 0);
+            CHECK(job.run(now).removed == 0);
+            CHECK(rawRows() == 400);
+        }
+
+        SUBCASE("Janela mínima do embaralhamento inteligente") {
+            core::HistoryCompactionJob job(database->getDatabase(), 1);
+            CHECK(job.retentionDays() == HISTORY_RETENTION_MIN_DAYS);
+            job.run(now);
+            CHECK(rawRows() == HISTORY_RETENTION_MIN_DAYS);
+        }
+    }
+
+    TEST_CASE_FIXTURE(CompactionFixture, "HistoryCompactionJob: converte bancos sem auto_vacuum incremental") {
+        auto db = database->getDatabase();
+        db->exec("PRAGMA auto_vacuum = NONE;");
+        db->exec("VACUUM;");
+
+        // abrir o banco não converte mais; quem converte é a compactação
+        core::HistoryCompactionJob job(db, 100);
+        auto report = job.run(now);
+        CHECK(report.removed == 300);
+
+        SQLite::Statement mode(*db, "PRAGMA auto_vacuum;");
+        REQUIRE(mode.executeStep());
+        CHECK(mode.getColumn(0).getInt() == 2);
+    }
+
+    TEST_CASE_FIXTURE(CompactionFixture, "HistoryCompactionJob: execução em segundo plano") {
+        core::HistoryCompactionJob job(database->getDatabase(), 100);
+        job.start(now);
+        for (int i = 0; i < 500 && job.isRunning(); ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CHECK_FALSE(job.isRunning());
+        CHECK(rawRows() == 100);
+
+        job.stop();
+        CHECK_NOTHROW(job.start(now));
+        job.stop();
+        CHECK_FALSE(job.isRunning());
+    }
+
+    TEST_CASE_FIXTURE(CompactionFixture, "HistoryPlaybackRepository: remoção em lotes") {
+        CHECK(repo->deleteHistoryBefore(now - 100 * day, 7) == 300);
+        CHECK(rawRows() == 100);
+        CHECK_THROWS_AS(repo->deleteHistoryBefore(now, 0), std::invalid_argument);
+    }
+}
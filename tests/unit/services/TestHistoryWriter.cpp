@@ -0,0 +1,126 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "core/bd/DatabaseManager.hpp"
+#include "core/bd/HistoryPlaybackRepository.hpp"
+#include "core/entities/Song.hpp"
+#include "core/entities/User.hpp"
+#include "core/services/HistoryWriter.hpp"
+
+#include "fixtures/ConfigFixture.hpp"
+
+TEST_SUITE("Unit Tests - Services: HistoryWriter") {
+    struct HistoryWriterFixture {
+        std::unique_ptr<core::DatabaseManager> database;
+        std::shared_ptr<core::HistoryPlaybackRepository> repo;
+        core::User user;
+        core::Song song;
+
+        HistoryWriterFixture() : user("ouvinte"), song(7, "Faixa", 1) {
+            ConfigFixture config;
+            database.reset(new core::DatabaseManager(config.databasePath(),
+                                                     config.databaseSchemaPath()));
+            // os eventos só guardam IDs; não precisamos das linhas de usuário e música
+            database->getDatabase()->exec("PRAGMA foreign_keys = OFF;");
+            repo = std::make_shared<core::HistoryPlaybackRepository>(database->getDatabase());
+            user.setId(1);
+        }
+
+        unsigned plays() const {
+            auto stats = repo->findPlayStatsByUser(user);
+            auto it = stats.find(song.getId());
+            return it == stats.end() ? 0 : it->second.plays;
+        }
+    };
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture, "HistoryWriter: grava ao completar um lote") {
+        core::HistoryWriter writer(repo, 4, std::chrono::seconds(30));
+
+        for (int i = 0; i < 4; ++i)
+            CHECK(writer.record(user, song, 60));
+
+        for (int i = 0; i < 200 && writer.written() < 4; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        CHECK(writer.written() == 4);
+        CHECK(plays() == 4);
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture, "HistoryWriter: flush e encerramento gravam os pendentes") {
+        SUBCASE("flush") {
+            core::HistoryWriter writer(repo, 100, std::chrono::seconds(30));
+            writer.record(user, song, 60);
+            writer.record(user, song, 60);
+
+            writer.flush();
+            CHECK(writer.written() == 2);
+            CHECK(plays() == 2);
+        }
+
+        SUBCASE("Destrutor") {
+            {
+                core::HistoryWriter writer(repo, 100, std::chrono::seconds(30));
+                writer.record(user, song, 60);
+            }
+            CHECK(plays() == 1);
+        }
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture, "HistoryWriter: fila cheia descarta sem bloquear") {
+        core::HistoryWriter writer(repo, 100, std::chrono::seconds(30), 2);
+
+        CHECK(writer.record(user, song, 60));
+        CHECK(writer.record(user, song, 60));
+        CHECK_FALSE(writer.record(user, song, 60));
+        CHECK(writer.dropped() == 1);
+
+        core::Song unsaved;
+        CHECK_FALSE(writer.record(user, unsaved, 60));
+
+        writer.stop();
+        CHECK(plays() == 2);
+    }
+
+    TEST_CASE_FIXTURE(HistoryWriterFixture, "HistoryWriter: conexão própria convive com as transações da thread principal") {
+        // em memória não existe segunda conexão: o teste precisa de um arquivo
+        ConfigFixture config;
+        std::string path = (std::filesystem::temp_directory_path() / "history_writer_wal.db").string();
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + "-wal");
+        std::filesystem::remove(path + "-shm");
+        core::DatabaseManager file_database(path, config.databaseSchemaPath());
+
+        auto db = file_database.getDatabase();
+        db->exec("PRAGMA foreign_keys = OFF;");
+        auto connection = file_database.openConnection();
+        REQUIRE(connection != db);
+        connection->exec("PRAGMA foreign_keys = OFF;");
+        repo = std::make_shared<core::HistoryPlaybackRepository>(connection);
+        core::HistoryWriter writer(repo, 2, std::chrono::milliseconds(1));
+
+        db->exec("CREATE TABLE IF NOT EXISTS writer_contention (id INTEGER PRIMARY KEY, value INTEGER);");
+        const int rounds = 200;
+        for (int i = 0; i < rounds; ++i) {
+            // a thread do writer grava lotes enquanto esta transação está aberta
+            SQLite::Transaction transaction(*db);
+            CHECK(writer.record(user, song, 60));
+            db->exec("INSERT INTO writer_contention (value) VALUES (" + std::to_string(i) + ");");
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            transaction.commit();
+        }
+        writer.flush();
+
+        CHECK(writer.failed() == 0);
+        CHECK(writer.written() == rounds);
+        CHECK(plays() == rounds);
+
+        SQLite::Statement count(*db, "SELECT COUNT(1) FROM writer_contention;");
+        REQUIRE(count.executeStep());
+        CHECK(count.getColumn(0).getInt() == rounds);
+    }
+}
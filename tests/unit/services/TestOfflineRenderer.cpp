@@ -0,0 +1,54 @@
+/**
+ * @file TestOfflineRenderer.cpp
+ * @brief Testes unitários para a renderização offline
+ * @author Eloy Maciel
+ * @date 2025-11-23
+ */
+
+#include <doctest/doctest.h>
+
+#include "core/services/OfflineRenderer.hpp"
+#include "fixtures/MediaFixture.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+TEST_CASE_FIXTURE(MediaFixture, "OfflineRenderer - Renderiza arquivos sem dispositivo de áudio") {
+    std::vector<std::string> files = {
+        getSongTestMock("Short_Song_Test_The_Testers").path,
+        getSongTestMock("Short_Song_Examples_Example_Band").path
+    };
+    std::string output = (std::filesystem::temp_directory_path()
+                          / "frankenstein_offline_render.wav").string();
+
+    core::OfflineRenderer renderer(44100, 2);
+
+    SUBCASE("Faixas em sequência") {
+        auto report = renderer.renderFiles(files, output);
+
+        CHECK(report.tracks == 2);
+        CHECK(report.failed == 0);
+        CHECK(report.audio_seconds > 2.5);
+        CHECK(report.speedUp() > 1.0);
+        CHECK(std::filesystem::file_size(output) > 44100 * 2 * 4 * 2);
+    }
+
+    SUBCASE("Crossfade sobrepõe as faixas") {
+        auto gapless = renderer.renderFiles(files, output);
+
+        renderer.setCrossfade(400);
+        auto crossfaded = renderer.renderFiles(files, output);
+
+        CHECK(crossfaded.audio_seconds == doctest::Approx(gapless.audio_seconds - 0.4).epsilon(0.01));
+    }
+
+    SUBCASE("Arquivo inexistente conta como falha") {
+        auto report = renderer.renderFiles({"/nao/existe.mp3", files[0]}, output);
+
+        CHECK(report.tracks == 1);
+        CHECK(report.failed == 1);
+    }
+
+    std::filesystem::remove(output);
+}
@@ -13,6 +13,8 @@
 #include "mocks/MockPlayable.hpp"
 
 #include <memory>
+#include <set>
+#include <string>
 #include <vector>
 
 // CONSTRUTORES
@@ -237,3 +239,176 @@ TEST_CASE_FIXTURE(PlaybackQueueFixture, "PlaybackQueue - Limpar fila") {
         CHECK_FALSE(queue.empty());
     }
 }
+
+// TESTES DE REORDENAÇÃO
+TEST_CASE_FIXTURE(PlaybackQueueFixture, "PlaybackQueue - Mover músicas") {
+    std::vector<std::shared_ptr<core::Song>> songs;
+    for (int i = 1; i <= 5; i++) {
+        songs.push_back(createSong("Song " + std::to_string(i)));
+    }
+    MockPlayable playable(songs);
+    core::PlaybackQueue queue(user, playable, history_repo);
+    queue.next(); // Song 2
+
+    SUBCASE("Mover para depois da atual") {
+        CHECK(queue.move(0, 3));
+        CHECK(queue.at(3)->getTitle() == "Song 1");
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 2");
+        CHECK(queue.findCurrentIndex() == 0);
+    }
+
+    SUBCASE("Mover a música atual") {
+        CHECK(queue.move(1, 4));
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 2");
+        CHECK(queue.findCurrentIndex() == 4);
+    }
+
+    SUBCASE("Índice inválido") {
+        CHECK_FALSE(queue.move(0, 5));
+    }
+}
+
+TEST_CASE_FIXTURE(PlaybackQueueFixture,
+                  "PlaybackQueue - Modo aleatório mantém a fila consistente") {
+    std::vector<std::shared_ptr<core::Song>> songs;
+    for (int i = 1; i <= 50; i++) {
+        songs.push_back(createSong("Song " + std::to_string(i)));
+    }
+    MockPlayable playable(songs);
+    core::PlaybackQueue queue(user, playable, history_repo);
+    queue.next();
+    queue.next(); // Song 3
+
+    queue.setAleatory(true);
+
+    SUBCASE("Músicas tocadas mantêm a posição") {
+        CHECK(queue.at(0)->getTitle() == "Song 1");
+        CHECK(queue.at(1)->getTitle() == "Song 2");
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 3");
+    }
+
+    SUBCASE("Remover no modo aleatório") {
+        auto removed = queue.at(10);
+        CHECK(queue.remove(10));
+        CHECK(queue.size() == 49);
+        CHECK(queue.findNextIndex(*removed) == -1);
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 3");
+
+        queue.setAleatory(false);
+        CHECK(queue.size() == 49);
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 3");
+        CHECK(queue.findCurrentIndex() == 2);
+    }
+
+    SUBCASE("Adicionar no modo aleatório não altera as tocadas") {
+        auto extra = createSong("Extra");
+        MockPlayable more({extra});
+        queue.add(more);
+
+        CHECK(queue.size() == 51);
+        CHECK(queue.at(0)->getTitle() == "Song 1");
+        CHECK(queue.getCurrentSong()->getTitle() == "Song 3");
+        CHECK(queue.findNextIndex(*extra) > 2);
+    }
+
+    SUBCASE("Todas as músicas continuam presentes") {
+        std::set<std::string> titles;
+        for (size_t i = 0; i < queue.size(); ++i)
+            titles.insert(queue.at(i)->getTitle());
+        CHECK(titles.size() == 50);
+    }
+}
+
+TEST_CASE_FIXTURE(PlaybackQueueFixture,
+                  "PlaybackQueue - Embaralhamento incremental") {
+    std::vector<std::shared_ptr<core::Song>> songs;
+    for (int i = 1; i <= 30; i++) {
+        songs.push_back(createSong("Song " + std::to_string(i)));
+    }
+    MockPlayable playable(songs);
+
+    auto playOrder = [&](uint64_t seed) {
+        core::PlaybackQueue queue(user, playable, history_repo);
+        queue.setSeed(seed);
+        queue.next();
+        queue.setAleatory(true);
+
+        std::vector<std::string> titles = {queue.getCurrentSong()->getTitle()};
+        while (auto song = queue.next())
+            titles.push_back(song->getTitle());
+        return titles;
+    };
+
+    SUBCASE("Mesma semente, mesma ordem") {
+        CHECK(playOrder(42) == playOrder(42));
+    }
+
+    SUBCASE("Nenhuma música toca duas vezes") {
+        auto titles = playOrder(7);
+        std::set<std::string> unique(titles.begin(), titles.end());
+        CHECK(titles.size() == 29);
+        CHECK(unique.size() == 29);
+        CHECK(unique.count("Song 1") == 0);
+    }
+
+    SUBCASE("Reembaralhar não altera as já tocadas") {
+        core::PlaybackQueue queue(user, playable, history_repo);
+        queue.setAleatory(true);
+        queue.next();
+        queue.next();
+        auto played = queue.getQueueView(2, 0);
+
+        queue.shuffle();
+        CHECK(queue.getQueueView(2, 0) == played);
+
+        queue.previous();
+        queue.shuffle();
+        CHECK(queue.getCurrentSong() == played[1]);
+        CHECK(queue.at(0) == played[0]);
+        CHECK(queue.size() == 30);
+    }
+}
+
+TEST_CASE_FIXTURE(PlaybackQueueFixture,
+                  "PlaybackQueue - Embaralhamento inteligente") {
+    std::vector<std::shared_ptr<core::Song>> songs;
+    for (unsigned i = 1; i <= 20; i++) {
+        songs.push_back(std::make_shared<core::Song>(
+            i, "Song " + std::to_string(i), i <= 10 ? 1u : 2u));
+    }
+    MockPlayable playable(songs);
+    core::PlaybackQueue queue(user, playable, history_repo);
+    queue.setSeed(3);
+    queue.setShuffleMode(core::ShuffleMode::SMART);
+    queue.setAleatory(true);
+
+    std::vector<std::shared_ptr<const core::Song>> played = {queue.getCurrentSong()};
+    while (auto song = queue.next())
+        played.push_back(song);
+
+    SUBCASE("Todas as músicas tocam uma vez") {
+        std::set<std::string> titles;
+        for (const auto &song : played)
+            titles.insert(song->getTitle());
+        CHECK(played.size() == 20);
+        CHECK(titles.size() == 20);
+    }
+
+    SUBCASE("Evita o mesmo artista em sequência") {
+        int repeats = 0;
+        for (size_t i = 1; i < played.size(); ++i) {
+            if (played[i]->getArtistId() == played[i - 1]->getArtistId())
+                repeats++;
+        }
+        CHECK(repeats <= 4);
+    }
+
+    SUBCASE("Voltar ao sorteio uniforme mantém a atual") {
+        queue.previous();
+        auto current = queue.getCurrentSong();
+        queue.setShuffleMode(core::ShuffleMode::UNIFORM);
+        CHECK(queue.getShuffleMode() == core::ShuffleMode::UNIFORM);
+        CHECK(queue.getCurrentSong() == current);
+        CHECK(queue.size() == 20);
+    }
+}
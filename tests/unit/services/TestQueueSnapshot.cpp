@@ -0,0 +1,173 @@
+/**
+ * @file TestQueueSnapshot.cpp
+ * @brief Testes do snapshot da fila de reprodução
+ * @author Eloy Maciel
+ * @date 2025-11-28
+ */
+
+#include <doctest/doctest.h>
+
+#include "core/entities/Song.hpp"
+#include "core/services/PlaybackQueue.hpp"
+#include "core/services/QueueSnapshot.hpp"
+#include "core/services/QueueSnapshotStore.hpp"
+#include "mocks/MockPlayable.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::shared_ptr<core::Song> makeSong(unsigned id) {
+        auto song = std::make_shared<core::Song>();
+        song->setId(id);
+        song->setTitle("Song " + std::to_string(id));
+        return song;
+    }
+
+    std::vector<std::shared_ptr<core::Song>> makeSongs(unsigned count) {
+        std::vector<std::shared_ptr<core::Song>> songs;
+        for (unsigned id = 1; id <= count; ++id)
+            songs.push_back(makeSong(id));
+        return songs;
+    }
+}
+
+TEST_CASE("QueueSnapshot: codifica e decodifica sem perdas") {
+    core::QueueSnapshot snapshot;
+    snapshot.song_ids = {7, 300, 70000, 1};
+    snapshot.drawn = {2, 0};
+    snapshot.current = 1;
+    snapshot.history = 0;
+    snapshot.position = 93;
+    snapshot.aleatory = true;
+    snapshot.loop = true;
+    snapshot.shuffle_mode = core::ShuffleMode::SMART;
+
+    core::QueueSnapshot decoded = core::QueueSnapshot::decode(snapshot.encode());
+
+    CHECK(decoded.song_ids == snapshot.song_ids);
+    CHECK(decoded.drawn == snapshot.drawn);
+    CHECK(decoded.current == 1);
+    CHECK(decoded.position == 93);
+    CHECK(decoded.aleatory);
+    CHECK(decoded.loop);
+    CHECK(decoded.shuffle_mode == core::ShuffleMode::SMART);
+}
+
+TEST_CASE("QueueSnapshot: rejeita dados corrompidos ou truncados") {
+    core::QueueSnapshot snapshot;
+    snapshot.song_ids = {1, 2, 3};
+    std::string data = snapshot.encode();
+
+    std::string flipped = data;
+    flipped[flipped.size() / 2] ^= 0x40;
+    CHECK_THROWS_AS(core::QueueSnapshot::decode(flipped), std::runtime_error);
+    CHECK_THROWS_AS(core::QueueSnapshot::decode(data.substr(0, data.size() - 1)),
+                    std::runtime_error);
+    CHECK_THROWS_AS(core::QueueSnapshot::decode(""), std::runtime_error);
+}
+
+TEST_CASE("QueueSnapshot: retain remapeia a ordem sorteada e a posição atual") {
+    core::QueueSnapshot snapshot;
+    snapshot.song_ids = {10, 20, 30, 40};
+    snapshot.drawn = {3, 1, 2};
+    snapshot.current = 1;  // ordem ativa: 40, 20, 30, 10
+    snapshot.aleatory = true;
+
+    snapshot.retain([](unsigned id) { return id != 20; });
+
+    CHECK(snapshot.song_ids == (std::vector<unsigned>{10, 30, 40}));
+    CHECK(snapshot.drawn == (std::vector<uint32_t>{2, 1}));
+    // a música atual sumiu: a posição segue para a próxima que ficou (30)
+    CHECK(snapshot.current == 1);
+}
+
+TEST_CASE("PlaybackQueue: restore reproduz a ordem aleatória salva") {
+    auto songs = makeSongs(50);
+    core::PlaybackQueue original(nullptr, MockPlayable(songs), nullptr);
+    original.setAleatory(true);
+    for (int i = 0; i < 10; ++i)
+        original.next();
+
+    std::vector<unsigned> expected;
+    for (size_t i = 0; i < 15; ++i)
+        expected.push_back(original.at(i)->getId());
+    unsigned current_id = original.getCurrentSong()->getId();
+
+    core::QueueSnapshot snapshot =
+        core::QueueSnapshot::decode(original.snapshot().encode());
+
+    std::set<unsigned> loaded;
+    core::PlaybackQueue restored(nullptr, nullptr);
+    restored.restore(snapshot, [&](unsigned id) {
+        loaded.insert(id);
+        return makeSong(id);
+    });
+
+    CHECK(restored.size() == 50);
+    CHECK(restored.isAleatory());
+    REQUIRE(restored.getCurrentSong() != nullptr);
+    CHECK(restored.getCurrentSong()->getId() == current_id);
+
+    for (size_t i = 0; i < expected.size(); ++i)
+        CHECK(restored.at(i)->getId() == expected[i]);
+
+    // só as músicas acessadas foram carregadas
+    CHECK(loaded.size() <= expected.size());
+}
+
+TEST_CASE("PlaybackQueue: revision muda a cada alteração da fila") {
+    auto songs = makeSongs(3);
+    core::PlaybackQueue queue(nullptr, MockPlayable(songs), nullptr);
+
+    uint64_t before = queue.revision();
+    queue.getCurrentSong();
+    CHECK(queue.revision() == before);
+
+    queue.next();
+    CHECK(queue.revision() != before);
+
+    before = queue.revision();
+    queue.setLoop(true);
+    CHECK(queue.revision() != before);
+}
+
+TEST_CASE("PlaybackQueue: restore recusa snapshot inconsistente") {
+    core::QueueSnapshot snapshot;
+    snapshot.song_ids = {1, 2};
+    snapshot.current = 5;
+
+    core::PlaybackQueue queue(nullptr, nullptr);
+    CHECK_THROWS_AS(queue.restore(snapshot, makeSong), std::invalid_argument);
+}
+
+TEST_CASE("QueueSnapshotStore: mudança adiada pelo intervalo fica pendente") {
+    auto songs = makeSongs(3);
+    core::PlaybackQueue queue(nullptr, MockPlayable(songs), nullptr);
+    std::string path = (std::filesystem::temp_directory_path() / "queue_store_debounce.bin").string();
+    core::QueueSnapshotStore store(path, std::chrono::milliseconds(50));
+
+    CHECK(store.isDirty(queue));
+    CHECK(store.saveIfChanged(queue, 7));
+    CHECK_FALSE(store.isDirty(queue));
+
+    queue.next();
+    CHECK_FALSE(store.saveIfChanged(queue, 3));
+    CHECK(store.isDirty(queue));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    CHECK(store.saveIfChanged(queue, 3));
+    CHECK_FALSE(store.isDirty(queue));
+
+    core::QueueSnapshot saved;
+    REQUIRE(store.load(saved));
+    CHECK(saved.position == 3);
+    CHECK(saved.current == 1);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,33 @@
+#include <doctest/doctest.h>
+#include <string>
+
+#include "core/entities/Song.hpp"
+#include "core/util/Datetime.hpp"
+
+TEST_SUITE("Unit Tests - Util: Datetime") {
+    TEST_CASE("Datetime: lê os formatos do SQLite e DD-MM-YYYY") {
+        core::Datetime sqlite("2025-12-03 14:05:09");
+        CHECK(sqlite.getSeconds() == 1764770709);
+        CHECK(sqlite.toString() == "2025/12/03");
+
+        core::Datetime date("03-12-2025");
+        CHECK(date.getSeconds() == 1764720000);
+        CHECK(date == sqlite);
+        CHECK(date.isBefore(core::Datetime("2025-12-04")));
+        CHECK_FALSE(date.isBefore(sqlite));
+
+        CHECK(core::Datetime("1969-12-31 23:59:59").toString() == "1969/12/31");
+        CHECK(core::Datetime("2024-02-29").toString() == "2024/02/29");
+        CHECK_FALSE(core::Datetime("ontem").isSet());
+        CHECK_FALSE(core::Datetime("2025-13-01").isSet());
+    }
+
+    TEST_CASE("Datetime: entidades nascem sem data de criação") {
+        core::Song song(1, "Faixa", 1, 1);
+        CHECK_FALSE(song.getDataCriacao().isSet());
+        CHECK(sizeof(core::Datetime) == sizeof(std::int64_t));
+
+        song.setDataCriacao(core::Datetime::now());
+        CHECK(song.getDataCriacao().isSet());
+    }
+}
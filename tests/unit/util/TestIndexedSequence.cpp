@@ -0,0 +1,88 @@
+#include <doctest/doctest.h>
+#include <random>
+#include <vector>
+
+#include "core/util/IndexedSequence.hpp"
+
+TEST_SUITE("Unit Tests - Util: IndexedSequence") {
+    TEST_CASE("IndexedSequence: operações posicionais") {
+        core::IndexedSequence<int> sequence;
+        for (int i = 0; i < 5; ++i)
+            sequence.pushBack(i);
+
+        SUBCASE("Inserir e acessar") {
+            auto handle = sequence.insert(2, 42);
+            CHECK(sequence.size() == 6);
+            CHECK(sequence.at(2) == 42);
+            CHECK(sequence.at(3) == 2);
+            CHECK(sequence.indexOf(handle) == 2);
+        }
+
+        SUBCASE("Remover por índice e por handle") {
+            auto handle = sequence.handleAt(4);
+            CHECK(sequence.erase(size_t(0)) == 0);
+            CHECK(sequence.erase(handle) == 4);
+            CHECK(sequence.size() == 3);
+            CHECK(sequence.at(0) == 1);
+        }
+
+        SUBCASE("Mover preserva o handle") {
+            auto handle = sequence.handleAt(0);
+            sequence.move(0, 4);
+            CHECK(sequence.at(4) == 0);
+            CHECK(sequence.indexOf(handle) == 4);
+            CHECK_THROWS_AS(sequence.move(0, 5), std::out_of_range);
+        }
+
+        SUBCASE("Marcações") {
+            sequence.setMarked(sequence.handleAt(1), true);
+            sequence.setMarked(sequence.handleAt(3), true);
+            CHECK(sequence.markedCount() == 2);
+            CHECK(sequence.unmarkedAt(0)->value == 0);
+            CHECK(sequence.unmarkedAt(1)->value == 2);
+            CHECK(sequence.unmarkedAt(2)->value == 4);
+            CHECK(sequence.unmarkedAt(3) == nullptr);
+
+            sequence.move(1, 4);
+            sequence.erase(size_t(0));
+            CHECK(sequence.markedCount() == 2);
+            CHECK(sequence.unmarkedAt(1)->value == 4);
+        }
+
+        SUBCASE("Posição inválida") {
+            CHECK(sequence.handleAt(5) == nullptr);
+            CHECK_THROWS_AS(sequence.at(5), std::out_of_range);
+        }
+    }
+
+    TEST_CASE("IndexedSequence: mesmo resultado de um vector") {
+        core::IndexedSequence<int> sequence;
+        std::vector<int> expected;
+        std::mt19937 rng(7);
+
+        for (int step = 0; step < 20000; ++step) {
+            int operation = rng() % 4;
+            if (operation < 2 || expected.empty()) {
+                size_t index = rng() % (expected.size() + 1);
+                sequence.insert(index, step);
+                expected.insert(expected.begin() + index, step);
+            } else if (operation == 2) {
+                size_t index = rng() % expected.size();
+                sequence.erase(index);
+                expected.erase(expected.begin() + index);
+            } else {
+                size_t from = rng() % expected.size();
+                size_t to = rng() % expected.size();
+                sequence.move(from, to);
+                int value = expected[from];
+                expected.erase(expected.begin() + from);
+                expected.insert(expected.begin() + to, value);
+            }
+        }
+
+        REQUIRE(sequence.size() == expected.size());
+        std::vector<int> actual;
+        sequence.forEach([&](int value) { actual.push_back(value); });
+        CHECK(actual == expected);
+    }
+}
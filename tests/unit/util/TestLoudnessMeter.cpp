@@ -0,0 +1,69 @@
+#include <doctest/doctest.h>
+#include <cmath>
+#include <vector>
+
+#include "core/util/LoudnessMeter.hpp"
+#include "core/util/SimdKernels.hpp"
+
+TEST_SUITE("Unit Tests - Util: LoudnessMeter") {
+    std::vector<float> sine(unsigned rate, unsigned channels, float amplitude, unsigned seconds) {
+        std::vector<float> samples(static_cast<size_t>(rate) * channels * seconds);
+        for (size_t i = 0; i < samples.size() / channels; ++i) {
+            float v = amplitude * std::sin(2.0f * 3.14159265f * 1000.0f * i / rate);
+            for (unsigned c = 0; c < channels; ++c)
+                samples[i * channels + c] = v;
+        }
+        return samples;
+    }
+
+    TEST_CASE("LoudnessMeter: seno de 1 kHz") {
+        SUBCASE("Estéreo a -20 dBFS mede -20 LUFS") {
+            core::LoudnessMeter meter(48000, 2);
+            auto samples = sine(48000, 2, 0.1f, 5);
+            meter.addFrames(samples.data(), samples.size() / 2);
+
+            CHECK(meter.integratedLoudness() == doctest::Approx(-20.0).epsilon(0.01));
+            CHECK(meter.replayGain() == doctest::Approx(2.0).epsilon(0.05));
+            CHECK(meter.truePeak() == doctest::Approx(0.1).epsilon(0.01));
+        }
+
+        SUBCASE("Silêncio fica abaixo do gate absoluto") {
+            core::LoudnessMeter meter(44100, 2);
+            std::vector<float> silence(44100 * 2 * 2, 0.0f);
+            meter.addFrames(silence.data(), silence.size() / 2);
+
+            CHECK(meter.integratedLoudness() == doctest::Approx(-70.0));
+        }
+
+        SUBCASE("True peak encontra pico entre amostras") {
+            core::LoudnessMeter meter(48000, 1);
+            std::vector<float> samples(48000);
+            for (size_t i = 0; i < samples.size(); ++i)
+                samples[i] = std::sin(3.14159265f / 2.0f * i + 3.14159265f / 4.0f);
+            meter.addFrames(samples.data(), samples.size());
+
+            CHECK(meter.truePeak() > 0.95f);
+        }
+
+        SUBCASE("Formato inválido") {
+            CHECK_THROWS_AS(core::LoudnessMeter(0, 2), std::invalid_argument);
+        }
+    }
+
+    TEST_CASE("SimdKernels: mesmo resultado da versão escalar") {
+        std::vector<float> data(1027);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = std::sin(0.37f * i) * (i % 7 == 0 ? -1.5f : 1.0f);
+
+        CHECK(core::simd::sumOfSquares(data.data(), data.size())
+              == doctest::Approx(core::simd::scalar::sumOfSquares(data.data(), data.size())));
+        CHECK(core::simd::maxAbs(data.data(), data.size())
+              == doctest::Approx(core::simd::scalar::maxAbs(data.data(), data.size())));
+
+        std::vector<float> a(data.size(), 1.0f), b(data.size(), 1.0f);
+        core::simd::multiplyAdd(0.25f, data.data(), a.data(), data.size());
+        core::simd::scalar::multiplyAdd(0.25f, data.data(), b.data(), data.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            CHECK(a[i] == doctest::Approx(b[i]));
+    }
+}
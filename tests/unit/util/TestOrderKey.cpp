@@ -0,0 +1,57 @@
+#include <doctest/doctest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/util/OrderKey.hpp"
+
+TEST_SUITE("Unit Tests - Util: OrderKey") {
+    TEST_CASE("OrderKey: sempre existe uma chave entre duas outras") {
+        CHECK(core::orderKeyBetween("", "") == "n");
+        CHECK(core::orderKeyBetween("b", "c") == "bn");
+        CHECK(core::orderKeyBetween("", "b") == "an");
+
+        // inserir sempre no mesmo ponto só alonga as chaves
+        std::string low = "m", high = "n";
+        for (int i = 0; i < 200; ++i) {
+            std::string middle = core::orderKeyBetween(low, high);
+            REQUIRE(core::isOrderKey(middle));
+            REQUIRE(low < middle);
+            REQUIRE(middle < high);
+            (i % 2 ? low : high) = middle;
+        }
+
+        std::string first = "n";
+        for (int i = 0; i < 100; ++i) {
+            std::string before = core::orderKeyBetween("", first);
+            REQUIRE(core::isOrderKey(before));
+            REQUIRE(before < first);
+            first = before;
+        }
+    }
+
+    TEST_CASE("OrderKey: chaves em lote são crescentes e curtas") {
+        auto keys = core::orderKeysBetween("", "", 10000);
+        REQUIRE(keys.size() == 10000);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            REQUIRE(core::isOrderKey(keys[i]));
+            REQUIRE(keys[i].size() <= 5);
+            if (i > 0)
+                REQUIRE(keys[i - 1] < keys[i]);
+        }
+
+        auto between = core::orderKeysBetween("c", "d", 3);
+        REQUIRE(between.size() == 3);
+        CHECK("c" < between[0]);
+        CHECK(between[2] < "d");
+    }
+
+    TEST_CASE("OrderKey: limites inválidos") {
+        CHECK_FALSE(core::isOrderKey(""));
+        CHECK_FALSE(core::isOrderKey("ba"));
+        CHECK_FALSE(core::isOrderKey("12"));
+        CHECK_THROWS_AS(core::orderKeyBetween("c", "b"), std::invalid_argument);
+        CHECK_THROWS_AS(core::orderKeyBetween("b", "b"), std::invalid_argument);
+        CHECK_THROWS_AS(core::orderKeysBetween("", "1", 2), std::invalid_argument);
+    }
+}
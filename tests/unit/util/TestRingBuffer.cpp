@@ -0,0 +1,71 @@
+#include <doctest/doctest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/util/RingBuffer.hpp"
+
+TEST_SUITE("Unit Tests - Util: RingBuffer") {
+    TEST_CASE("RingBuffer: FIFO limitada") {
+        core::RingBuffer<int> buffer(3);
+        CHECK(buffer.capacity() == 4);
+
+        for (int i = 0; i < 4; ++i)
+            CHECK(buffer.tryPush(i));
+        CHECK_FALSE(buffer.tryPush(4));
+        CHECK(buffer.sizeApprox() == 4);
+
+        int value = -1;
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(buffer.tryPop(value));
+            CHECK(value == i);
+        }
+        CHECK_FALSE(buffer.tryPop(value));
+
+        SUBCASE("Reaproveita as células depois de dar a volta") {
+            for (int round = 0; round < 10; ++round) {
+                CHECK(buffer.tryPush(round));
+                REQUIRE(buffer.tryPop(value));
+                CHECK(value == round);
+            }
+        }
+    }
+
+    TEST_CASE("RingBuffer: vários produtores e um consumidor") {
+        core::RingBuffer<int> buffer(256);
+        const int producers = 4;
+        const int perProducer = 20000;
+
+        std::atomic<bool> done{false};
+        long long sum = 0;
+        int received = 0;
+
+        std::thread consumer([&]() {
+            int value;
+            while (!done.load() || buffer.sizeApprox() > 0) {
+                if (buffer.tryPop(value)) {
+                    sum += value;
+                    ++received;
+                }
+            }
+        });
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&]() {
+                for (int i = 1; i <= perProducer; ++i) {
+                    while (!buffer.tryPush(i))
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+            thread.join();
+        done.store(true);
+        consumer.join();
+
+        CHECK(received == producers * perProducer);
+        CHECK(sum == producers * (static_cast<long long>(perProducer) * (perProducer + 1) / 2));
+    }
+}
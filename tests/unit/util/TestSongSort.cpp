@@ -0,0 +1,101 @@
+#include <doctest/doctest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/entities/Song.hpp"
+#include "core/util/SongSort.hpp"
+
+namespace {
+    std::shared_ptr<core::Song> makeSong(unsigned id, const std::string &title, unsigned artist,
+                                         unsigned album, unsigned track, int year = 2000) {
+        auto song = std::make_shared<core::Song>(id, title, artist, album);
+        song->setTrackNumber(track);
+        song->setYear(year);
+        return song;
+    }
+
+    std::vector<unsigned> ids(const std::vector<std::shared_ptr<core::Song>> &songs) {
+        std::vector<unsigned> result;
+        for (const auto &song : songs)
+            result.push_back(song->getId());
+        return result;
+    }
+}
+
+TEST_SUITE("Unit Tests - Util: SongSort") {
+    TEST_CASE("SongSort: ordens por título, artista/álbum/faixa e ano") {
+        std::vector<std::shared_ptr<core::Song>> songs = {
+            makeSong(1, "zebra", 2, 1, 2, 1990),
+            makeSong(2, "Abelha", 2, 1, 1, 2010),
+            makeSong(3, "casa", 1, 3, 5, 1990),
+            makeSong(4, "Bola", 1, 3, 4, 2000),
+        };
+
+        auto sorted = songs;
+        core::sortSongs(sorted, core::SongOrder::TITLE);
+        CHECK(ids(sorted) == (std::vector<unsigned>{2, 4, 3, 1}));
+
+        core::sortSongs(sorted, core::SongOrder::ARTIST_ALBUM_TRACK);
+        CHECK(ids(sorted) == (std::vector<unsigned>{4, 3, 2, 1}));
+
+        core::sortSongs(sorted, core::SongOrder::YEAR);
+        CHECK(ids(sorted) == (std::vector<unsigned>{3, 1, 4, 2}));
+
+        // a versão tipada de operator< segue a mesma regra, sem relações
+        CHECK(*songs[3] < *songs[2]);
+        CHECK(*songs[1] < *songs[0]);
+        CHECK(*songs[0] > *songs[1]);
+    }
+
+    TEST_CASE("SongSort: operator< tipado é uma ordem estrita fraca") {
+        // faixa dentro do grupo e título entre grupos formavam um ciclo: b < a < c < b
+        auto a = makeSong(1, "A", 1, 1, 2);
+        auto b = makeSong(2, "C", 1, 1, 1);
+        auto c = makeSong(3, "B", 2, 2, 1);
+
+        CHECK(*b < *a);
+        CHECK(*a < *c);
+        CHECK(*b < *c);
+        CHECK_FALSE(*c < *b);
+        CHECK_FALSE(*a < *a);
+
+        std::vector<std::shared_ptr<core::Song>> songs = {c, a, b};
+        auto less = [](const std::shared_ptr<core::Song> &x, const std::shared_ptr<core::Song> &y) {
+            return *x < *y;
+        };
+        std::sort(songs.begin(), songs.end(), less);
+        CHECK(ids(songs) == (std::vector<unsigned>{2, 1, 3}));
+    }
+
+    TEST_CASE("SongSort: ordenação paralela igual à sequencial") {
+        std::mt19937 rng(7);
+        std::vector<std::shared_ptr<core::Song>> songs;
+        for (unsigned i = 0; i < SONG_SORT_PARALLEL_MIN_DEFAULT + 1234; ++i) {
+            songs.push_back(makeSong(i + 1, "Song " + std::to_string(rng() % 5000), 1 + rng() % 50,
+                                     rng() % 8, rng() % 12, 1980 + static_cast<int>(rng() % 40)));
+        }
+
+        for (auto order : {core::SongOrder::TITLE, core::SongOrder::YEAR}) {
+            auto sequential = songs;
+            auto parallel = songs;
+            core::sortSongs(sequential, order, 1);
+            core::sortSongs(parallel, order, 3);
+            CHECK(ids(parallel) == ids(sequential));
+        }
+    }
+
+    TEST_CASE("SongSort: títulos acentuados ordenam pela letra base") {
+        std::vector<std::shared_ptr<core::Song>> songs = {
+            makeSong(1, "Zeca", 1, 0, 0),
+            makeSong(2, "Água", 1, 0, 0),
+            makeSong(3, "abacate", 1, 0, 0),
+            makeSong(4, "Ébano", 1, 0, 0),
+        };
+
+        core::sortSongs(songs, core::SongOrder::TITLE);
+        CHECK(ids(songs) == (std::vector<unsigned>{3, 2, 4, 1}));
+    }
+}
@@ -0,0 +1,59 @@
+#include <doctest/doctest.h>
+#include <cmath>
+#include <vector>
+
+#include "core/util/Waveform.hpp"
+
+TEST_SUITE("Unit Tests - Util: Waveform") {
+    TEST_CASE("WaveformBuilder: resumo de picos e RMS") {
+        SUBCASE("Seno de amplitude constante") {
+            core::WaveformBuilder builder(44100, 2);
+            std::vector<float> samples(44100 * 2 * 12);
+            for (size_t i = 0; i < samples.size() / 2; ++i) {
+                float v = 0.5f * std::sin(2.0f * 3.14159265f * 440.0f * i / 44100);
+                samples[i * 2] = v;
+                samples[i * 2 + 1] = v;
+            }
+            builder.addFrames(samples.data(), samples.size() / 2);
+
+            auto summary = builder.build();
+            REQUIRE(summary.buckets() == core::WAVEFORM_BUCKETS);
+            CHECK(summary.rms.size() == summary.peaks.size());
+            CHECK(summary.peaks[500] / 255.0 == doctest::Approx(0.5).epsilon(0.02));
+            CHECK(summary.rms[500] / 255.0 == doctest::Approx(0.3536).epsilon(0.02));
+        }
+
+        SUBCASE("Silêncio seguido de sinal") {
+            core::WaveformBuilder builder(1000, 1);
+            std::vector<float> samples(2000, 0.0f);
+            for (size_t i = 1000; i < samples.size(); ++i)
+                samples[i] = (i % 2 == 0) ? 1.0f : -1.0f;
+            // em pedaços que não coincidem com as janelas de 10 ms
+            for (size_t i = 0; i < samples.size(); i += 7)
+                builder.addFrames(samples.data() + i, std::min<size_t>(7, samples.size() - i));
+
+            auto summary = builder.build(10);
+            REQUIRE(summary.buckets() == 10);
+            CHECK(summary.peaks.front() == 0);
+            CHECK(summary.peaks.back() == 255);
+            CHECK(summary.rms.back() == 255);
+
+            auto columns = summary.resample(5);
+            CHECK(columns[0] == doctest::Approx(0.0f));
+            CHECK(columns[4] == doctest::Approx(1.0f));
+        }
+
+        SUBCASE("Faixa curta limita o número de buckets") {
+            core::WaveformBuilder builder(1000, 1);
+            std::vector<float> samples(35, 0.25f);
+            builder.addFrames(samples.data(), samples.size());
+
+            CHECK(builder.build().buckets() == 4);
+            CHECK(core::WaveformBuilder(1000, 1).build().empty());
+        }
+
+        SUBCASE("Formato inválido") {
+            CHECK_THROWS_AS(core::WaveformBuilder(44100, 0), std::invalid_argument);
+        }
+    }
+}
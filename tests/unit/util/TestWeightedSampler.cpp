@@ -0,0 +1,62 @@
+#include <doctest/doctest.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/WeightedSampler.hpp"
+
+TEST_SUITE("Unit Tests - Util: WeightedSampler") {
+    TEST_CASE("WeightedSampler: pesos e somas") {
+        core::WeightedSampler sampler;
+        for (int i = 1; i <= 10; ++i)
+            sampler.add(i);
+
+        CHECK(sampler.size() == 10);
+        CHECK(sampler.total() == doctest::Approx(55.0));
+
+        SUBCASE("Alterar pesos") {
+            sampler.set(9, 0.0);
+            sampler.set(0, 5.0);
+            CHECK(sampler.weight(0) == doctest::Approx(5.0));
+            CHECK(sampler.total() == doctest::Approx(49.0));
+        }
+
+        SUBCASE("Sorteio segue as somas acumuladas") {
+            CHECK(sampler.sample(0.0) == 0);
+            CHECK(sampler.sample(1.5 / 55.0) == 1);
+            CHECK(sampler.sample(0.999) == 9);
+        }
+
+        SUBCASE("Posições de peso zero nunca saem") {
+            for (size_t slot = 0; slot < 10; slot += 2)
+                sampler.set(slot, 0.0);
+
+            for (int i = 0; i < 100; ++i)
+                CHECK(sampler.sample(i / 100.0) % 2 == 1);
+        }
+
+        SUBCASE("Sem pesos") {
+            for (size_t slot = 0; slot < 10; ++slot)
+                sampler.set(slot, 0.0);
+            CHECK_THROWS_AS(sampler.sample(0.5), std::logic_error);
+        }
+    }
+
+    TEST_CASE("WeightedSampler: frequências proporcionais aos pesos") {
+        core::WeightedSampler sampler;
+        std::vector<double> weights = {1.0, 2.0, 0.0, 4.0, 1.0};
+        for (double weight : weights)
+            sampler.add(weight);
+
+        std::mt19937_64 rng(11);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        std::vector<int> hits(weights.size(), 0);
+        const int draws = 80000;
+        for (int i = 0; i < draws; ++i)
+            hits[sampler.sample(unit(rng))]++;
+
+        CHECK(hits[2] == 0);
+        for (size_t slot = 0; slot < weights.size(); ++slot)
+            CHECK(hits[slot] / double(draws) == doctest::Approx(weights[slot] / 8.0).epsilon(0.05));
+    }
+}